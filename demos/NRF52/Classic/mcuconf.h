@@ -39,6 +39,7 @@
  * HAL driver system settings.
  */
 #define NRF5_SERIAL_USE_UART0             TRUE
+#define NRF5_SERIAL_USE_UARTE             FALSE
 #define NRF5_SERIAL_USE_HWFLOWCTRL	   TRUE
 #define NRF5_RNG_USE_RNG0 		   TRUE
 #define NRF5_GPT_USE_TIMER0 		   TRUE
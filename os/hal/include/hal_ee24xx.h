@@ -11,6 +11,10 @@
 
 #if defined(HAL_USE_EEPROM) && HAL_USE_EEPROM && EEPROM_USE_EE24XX
 
+#if EE24XX_USE_I2CQ
+#include "i2cq.h"
+#endif
+
 #define EEPROM_DEV_24XX 24
 
 /**
@@ -30,6 +34,13 @@ typedef struct {
    * Pointer to write buffer. The safest size is (pagesize + 2)
    */
   uint8_t       *write_buf;
+#if EE24XX_USE_I2CQ
+  /**
+   * Queue client of IC, NULL for direct bus access. Write cycle time is
+   * still waited by the caller, other clients use the bus meanwhile.
+   */
+  i2cq_client_t *client;
+#endif
 } I2CEepromFileConfig;
 
 /**
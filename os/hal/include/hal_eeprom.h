@@ -39,6 +39,10 @@
 #define EEPROM_USE_EE24XX FALSE
 #endif
 
+#ifndef EE24XX_USE_I2CQ
+#define EE24XX_USE_I2CQ FALSE
+#endif
+
 #if (HAL_USE_EEPROM == TRUE) || defined(__DOXYGEN__)
 
 #if EEPROM_USE_EE25XX && EEPROM_USE_EE24XX
@@ -41,6 +41,7 @@
  */
 #define ONEWIRE_CMD_READ_ROM              0x33
 #define ONEWIRE_CMD_SEARCH_ROM            0xF0
+#define ONEWIRE_CMD_ALARM_SEARCH          0xEC
 #define ONEWIRE_CMD_MATCH_ROM             0x55
 #define ONEWIRE_CMD_SKIP_ROM              0xCC
 #define ONEWIRE_CMD_CONVERT_TEMP          0x44
@@ -56,9 +57,56 @@
  */
 #define ONEWIRE_MAX_TRANSACTION_LEN       ((1U << ONEWIRE_REG_BYTES_WIDTH) - 1U)
 
+/**
+ * @brief   UART bit rates used by UART backend.
+ * @details Reset pulse is generated by single byte sent at low rate,
+ *          every time slot by single byte sent at high rate.
+ */
+#define ONEWIRE_UART_RESET_SPEED          9600U
+#define ONEWIRE_UART_SLOT_SPEED           115200U
+
 /*===========================================================================*/
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
+/**
+ * @brief   Use UART with DMA instead of PWM for time slot generation.
+ * @details TX and RX of the UART must be joined to the bus (half duplex
+ *          open drain mode or external buffer). Every bit on the bus costs
+ *          one UART byte so whole transaction is moved by DMA with single
+ *          interrupt at its end.
+ */
+#if !defined(ONEWIRE_USE_UART) || defined(__DOXYGEN__)
+#define ONEWIRE_USE_UART                  FALSE
+#endif
+
+/**
+ * @brief   Maximum number of simultaneously started 1-wire drivers.
+ * @details Every bus needs its own PWM (or UART) driver. Driver serving
+ *          the interrupt is looked up by its PWM (or UART) driver, so
+ *          keep this value as small as possible.
+ */
+#if !defined(ONEWIRE_MAX_BUSES) || defined(__DOXYGEN__)
+#define ONEWIRE_MAX_BUSES                 1
+#endif
+
+/**
+ * @brief   Data bytes moved by single DMA transfer in UART mode.
+ * @details Driver allocates 8 bytes of RAM per every data byte. Longer
+ *          transactions are split into several transfers.
+ */
+#if !defined(ONEWIRE_UART_CHUNK_BYTES) || defined(__DOXYGEN__)
+#define ONEWIRE_UART_CHUNK_BYTES          16U
+#endif
+
+/**
+ * @brief   Unknown bus branches remembered by single topology refresh.
+ * @details Every branch costs 9 bytes in @p onewireTopology. When more
+ *          new branches are met the refresh falls back to full search.
+ */
+#if !defined(ONEWIRE_TOPOLOGY_BRANCHES) || defined(__DOXYGEN__)
+#define ONEWIRE_TOPOLOGY_BRANCHES         8U
+#endif
+
 #if ONEWIRE_SYNTH_SEARCH_TEST && !ONEWIRE_USE_SEARCH_ROM
 #error "Synthetic search rom test needs ONEWIRE_USE_SEARCH_ROM"
 #endif
@@ -66,6 +114,29 @@
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
+#if ONEWIRE_MAX_BUSES < 1
+#error "ONEWIRE_MAX_BUSES must be at least 1"
+#endif
+
+#if ONEWIRE_USE_UART
+#if !HAL_USE_UART
+#error "1-wire Driver in UART mode requires HAL_USE_UART"
+#endif
+
+#if ONEWIRE_SYNTH_SEARCH_TEST
+#error "Synthetic search rom test is not supported in UART mode"
+#endif
+
+#if (ONEWIRE_UART_CHUNK_BYTES < 2) || (ONEWIRE_UART_CHUNK_BYTES > 255)
+#error "ONEWIRE_UART_CHUNK_BYTES must be in range 2..255"
+#endif
+
+/**
+ * @brief   Size of time slot buffer in bytes.
+ */
+#define ONEWIRE_UART_SLOTS                (ONEWIRE_UART_CHUNK_BYTES * 8U)
+
+#else /* !ONEWIRE_USE_UART */
 #if !HAL_USE_PWM
 #error "1-wire Driver requires HAL_USE_PWM"
 #endif
@@ -73,6 +144,7 @@
 #if !HAL_USE_PAL
 #error "1-wire Driver requires HAL_USE_PAL"
 #endif
+#endif /* ONEWIRE_USE_UART */
 
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
@@ -124,6 +196,20 @@ typedef enum {
  * @brief   Driver configuration structure.
  */
 typedef struct {
+#if ONEWIRE_USE_UART || defined(__DOXYGEN__)
+  /**
+   * @brief Pointer to @p UART driver used for communication.
+   */
+  UARTDriver                *uartd;
+  /**
+   * @brief Pointer to configuration structure for underlying UART driver.
+   * @note  It is NOT constant because 1-wire driver needs to change
+   *        bit rate and callbacks during normal functioning. Half duplex
+   *        or open drain settings must be prepared by user.
+   */
+  UARTConfig                *uartcfg;
+#endif
+#if !ONEWIRE_USE_UART || defined(__DOXYGEN__)
   /**
    * @brief Pointer to @p PWM driver used for communication.
    */
@@ -174,6 +260,7 @@ typedef struct {
    * @brief   Digital I/O mode for active bus.
    */
   iomode_t                  pad_mode_active;
+#endif /* !ONEWIRE_USE_UART */
 #if ONEWIRE_USE_STRONG_PULLUP
   /**
    * @brief Pointer to function asserting of strong pull up.
@@ -220,9 +307,9 @@ typedef struct {
   uint32_t      rombit: 7;
   /**
    * @brief Total device count discovered on bus.
-   * @note  Maximum 256.
+   * @note  Maximum 256, so must be big enough to store number 256.
    */
-  uint32_t      devices_found: 8;
+  uint32_t      devices_found: 9;
 } search_rom_reg_t;
 
 /**
@@ -241,6 +328,10 @@ typedef struct {
    * @brief   Previously discovered ROM.
    */
   uint8_t           prev_path[8];
+  /**
+   * @brief   ROM bits where collision happened during last iteration.
+   */
+  uint8_t           collisions[8];
   /**
    * @brief   Last zero turn branch.
    * @note    Negative values use to point out of device tree's root.
@@ -252,6 +343,45 @@ typedef struct {
    */
   int8_t            prev_zero_branch;
 } onewire_search_rom_t;
+
+/**
+ * @brief     Cache of ROMs known to be present on bus.
+ * @details   Kept by application between calls of
+ *            @p onewireTopologyRefresh().
+ */
+typedef struct {
+  /**
+   * @brief   Known ROMs, 8 bytes each.
+   */
+  uint8_t           *roms;
+  /**
+   * @brief   Buffer size in ROMs count.
+   */
+  size_t            max;
+  /**
+   * @brief   Number of known ROMs.
+   */
+  size_t            count;
+  /**
+   * @brief   ROMs appended to the end of the cache by last refresh.
+   */
+  size_t            added;
+  /**
+   * @brief   ROMs dropped from the cache by last refresh.
+   */
+  size_t            removed;
+  /**
+   * @brief   New devices did not fit in the cache during last refresh.
+   */
+  bool              overflow;
+  /**
+   * @brief   Unknown branches met during verification, ROM prefix and
+   *          its length in bits.
+   */
+  uint8_t           branch[ONEWIRE_TOPOLOGY_BRANCHES][8];
+  uint8_t           branch_bits[ONEWIRE_TOPOLOGY_BRANCHES];
+  size_t            branches;
+} onewireTopology;
 #endif /* ONEWIRE_USE_SEARCH_ROM */
 
 /**
@@ -315,6 +445,13 @@ typedef struct {
    * @brief   Thread waiting for I/O completion.
    */
   thread_reference_t  thread;
+#if ONEWIRE_USE_UART || defined(__DOXYGEN__)
+  /**
+   * @brief   Time slots buffer, one byte per bus bit. The same buffer
+   *          is used for transmission and reception.
+   */
+  uint8_t             slots[ONEWIRE_UART_SLOTS];
+#endif
 } onewireDriver;
 
 /*===========================================================================*/
@@ -341,6 +478,14 @@ extern "C" {
 #if ONEWIRE_USE_SEARCH_ROM
   size_t onewireSearchRom(onewireDriver *owp,
                           uint8_t *result, size_t max_rom_cnt);
+  size_t onewireSearchAlarm(onewireDriver *owp,
+                            uint8_t *result, size_t max_rom_cnt);
+  size_t onewireSearchFamily(onewireDriver *owp, uint8_t family,
+                             uint8_t *result, size_t max_rom_cnt);
+  bool onewireVerifyRom(onewireDriver *owp, const uint8_t *rom);
+  void onewireTopologyObjectInit(onewireTopology *tp,
+                                 uint8_t *roms, size_t max);
+  size_t onewireTopologyRefresh(onewireDriver *owp, onewireTopology *tp);
 #endif /* ONEWIRE_USE_SEARCH_ROM */
 #if ONEWIRE_SYNTH_SEARCH_TEST
   void _synth_ow_write_bit(onewireDriver *owp, ioline_t bit);
@@ -28,6 +28,11 @@
  * to allow the SDHC peripheral DMA access to any data buffers (read
  * or write).
  *
+ * Block transfers use the ADMA2 engine. Word aligned buffers are
+ * described directly in the descriptor table; the ADMA2 engine can't
+ * address unaligned memory, so those buffers are staged through a
+ * bounce buffer in the driver.
+ *
  * The SDHC signals must be routed to the desired pins, and pullups/pulldowns
  * configured.
  *
@@ -39,6 +44,8 @@
 
 #if (HAL_USE_SDC == TRUE) || defined(__DOXYGEN__)
 
+#include <string.h>
+
 #include "hal_mmcsd.h"
 
 /*===========================================================================*/
@@ -101,6 +108,16 @@
 #define MMC_ERR_CSD_OVERWRITE           (1U << 16)
 #define MMC_ERR_AKE_SEQ                 (1U << 3)
 
+/* ADMA2 descriptor attributes */
+#define ADMA2_ATTR_VALID                (1U << 0)
+#define ADMA2_ATTR_END                  (1U << 1)
+#define ADMA2_ATTR_INT                  (1U << 2)
+#define ADMA2_ATTR_ACT_TRAN             (2U << 4)
+#define ADMA2_ATTR_ACT_LINK             (3U << 4)
+
+/* SET_WR_BLK_ERASE_COUNT, not defined by the MMCSD layer */
+#define SD_ACMD_SET_WR_BLK_ERASE_COUNT  23U
+
 /*===========================================================================*/
 /* Driver exported variables.                                                */
 /*===========================================================================*/
@@ -124,7 +141,7 @@ SDCDriver SDCD1;
 
 static void recover_after_botched_transfer(SDCDriver *);
 static msg_t wait_interrupt(SDCDriver *, uint32_t);
-static bool sdc_lld_transfer(SDCDriver *, uint32_t, uintptr_t, uint32_t, uint32_t);
+static bool sdc_lld_transfer(SDCDriver *, uint32_t, uint32_t, uint32_t);
 
 /**
  * Compute the SDCLKFS and DVS values for a given SDCLK divisor.
@@ -394,6 +411,7 @@ static bool send_and_wait_transfer(SDCDriver *sdcp, uint32_t cmd) {
 
     /* Internal DMA error */
     if (datastat & SDHC_IRQSTAT_DMAE) {
+      TRACE(8, SDHC->ADMAES);
       sdcp->errors |= SDC_UNHANDLED_ERROR;
       if (!(datastat & SDHC_IRQSTAT_TC))
 	should_cancel = true;
@@ -491,11 +509,9 @@ static void recover_after_botched_transfer(SDCDriver *sdcp) {
  * (either a read or write) to complete.
  */
 static bool sdc_lld_transfer(SDCDriver *sdcp, uint32_t startblk,
-			     uintptr_t buf, uint32_t n,
-			     uint32_t cmdx) {
+			     uint32_t n, uint32_t cmdx) {
 
   osalDbgCheck(n > 0);
-  osalDbgCheck((buf & 0x03) == 0);  /* Must be 32-bit aligned */
 
   osalDbgAssert((SDHC->PRSSTAT & (SDHC_PRSSTAT_DLA|SDHC_PRSSTAT_CDIHB|SDHC_PRSSTAT_CIHB)) == 0,
 		"SDHC interface not ready");
@@ -511,8 +527,10 @@ static bool sdc_lld_transfer(SDCDriver *sdcp, uint32_t startblk,
     SDHC->CMDARG = startblk * MMCSD_BLOCK_SIZE;
   }
 
-  /* Store the DMA start address */
-  SDHC->DSADDR = buf;
+  /* The data goes wherever the descriptor table says */
+  SDHC->PROCTL = (SDHC->PROCTL & ~SDHC_PROCTL_DMAS_MASK) |
+    SDHC_PROCTL_DMAS_ADMA2;
+  SDHC->ADSADDR = (uint32_t)(uintptr_t)sdcp->adma2;
 
   uint32_t xfer;
   /* For data transfers, we need to set some extra bits in XFERTYP according to the
@@ -550,6 +568,166 @@ static bool sdc_lld_transfer(SDCDriver *sdcp, uint32_t startblk,
   return send_and_wait_transfer(sdcp, xfer);
 }
 
+#if (KINETIS_SDHC_USE_PREERASE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief Tell an SD card how many blocks the next write will cover
+ *
+ * The card may erase them ahead of the data (ACMD23), which makes
+ * multiple block writes noticeably faster on most cards. MMC cards
+ * don't have this command.
+ */
+static bool sdc_lld_preerase(SDCDriver *sdcp, uint32_t n) {
+  uint32_t resp;
+
+  if ((sdcp->cardmode & SDC_MODE_CARDTYPE_MASK) == SDC_MODE_CARDTYPE_MMC) {
+    return HAL_SUCCESS;
+  }
+
+  if (sdc_lld_send_cmd_short_crc(sdcp, MMCSD_CMD_APP_CMD,
+                                 sdcp->rca, &resp) ||
+      (resp & MMCSD_R1_ERROR_MASK)) {
+    return HAL_FAILED;
+  }
+  if (sdc_lld_send_cmd_short_crc(sdcp, SD_ACMD_SET_WR_BLK_ERASE_COUNT,
+                                 n, &resp) ||
+      (resp & MMCSD_R1_ERROR_MASK)) {
+    return HAL_FAILED;
+  }
+
+  return HAL_SUCCESS;
+}
+#endif
+
+/**
+ * @brief Transfer blocks to or from a scatter-gather list
+ *
+ * Each command takes as many segments as fit in the descriptor
+ * table. Word aligned segments are transferred in place; the others
+ * go through the bounce buffer, which also bounds how many unaligned
+ * blocks a single command can carry. Whatever doesn't fit is sent as
+ * a further command.
+ */
+static bool sdc_lld_transfer_sg(SDCDriver *sdcp, uint32_t startblk,
+                                const sdcsegment_t *sgl, size_t count,
+                                bool write) {
+  uint8_t *copyback[KINETIS_SDHC_ADMA2_DESCRIPTORS];
+  size_t seg = 0;
+  uint32_t segoff = 0;
+
+  while (seg < count) {
+    uint8_t *bounce = (uint8_t *)sdcp->bounce;
+    uint32_t bounced = 0;
+    uint32_t n = 0;
+    unsigned nd = 0;
+
+    /* Fill the descriptor table */
+    while ((seg < count) && (nd < KINETIS_SDHC_ADMA2_DESCRIPTORS)) {
+      uint8_t *p = sgl[seg].buf + segoff * MMCSD_BLOCK_SIZE;
+      uint32_t blocks = sgl[seg].blocks - segoff;
+      uint8_t *addr;
+
+      if (blocks > SDHC_ADMA2_MAX_BLOCKS) {
+        blocks = SDHC_ADMA2_MAX_BLOCKS;
+      }
+
+      if (((uintptr_t)p & 0x03) == 0) {
+        addr = p;
+        copyback[nd] = NULL;
+      } else {
+        if (blocks > KINETIS_SDHC_BOUNCE_BLOCKS - bounced) {
+          blocks = KINETIS_SDHC_BOUNCE_BLOCKS - bounced;
+        }
+        if (blocks == 0) {
+          break;
+        }
+        addr = bounce + bounced * MMCSD_BLOCK_SIZE;
+        if (write) {
+          memcpy(addr, p, blocks * MMCSD_BLOCK_SIZE);
+          copyback[nd] = NULL;
+        } else {
+          copyback[nd] = p;
+        }
+        bounced += blocks;
+      }
+
+      sdcp->adma2[nd].attr    = ADMA2_ATTR_VALID | ADMA2_ATTR_ACT_TRAN;
+      sdcp->adma2[nd].length  = (uint16_t)(blocks * MMCSD_BLOCK_SIZE);
+      sdcp->adma2[nd].address = (uint32_t)(uintptr_t)addr;
+      nd++;
+
+      n += blocks;
+      segoff += blocks;
+      if (segoff == sgl[seg].blocks) {
+        seg++;
+        segoff = 0;
+      }
+    }
+    sdcp->adma2[nd - 1].attr |= ADMA2_ATTR_END;
+
+    uint32_t cmdx;
+    if (write) {
+#if KINETIS_SDHC_USE_PREERASE == TRUE
+      if ((n > 1) && sdc_lld_preerase(sdcp, n)) {
+        return HAL_FAILED;
+      }
+#endif
+      cmdx = (n == 1)?
+        SDHC_XFERTYP_CMDINX(MMCSD_CMD_WRITE_BLOCK) :
+        SDHC_XFERTYP_CMDINX(MMCSD_CMD_WRITE_MULTIPLE_BLOCK);
+    } else {
+      cmdx = (n == 1)?
+        SDHC_XFERTYP_CMDINX(MMCSD_CMD_READ_SINGLE_BLOCK) :
+        SDHC_XFERTYP_CMDINX(MMCSD_CMD_READ_MULTIPLE_BLOCK);
+      cmdx |= SDHC_XFERTYP_DTDSEL;
+    }
+
+    if (sdc_lld_transfer(sdcp, startblk, n, cmdx)) {
+      return HAL_FAILED;
+    }
+
+    /* Hand the bounced blocks of a read to their owners */
+    for (unsigned i = 0; i < nd; i++) {
+      if (copyback[i] != NULL) {
+        memcpy(copyback[i], (const void *)(uintptr_t)sdcp->adma2[i].address,
+               sdcp->adma2[i].length);
+      }
+    }
+
+    startblk += n;
+  }
+
+  return HAL_SUCCESS;
+}
+
+/**
+ * @brief Check and run a scatter-gather transfer on behalf of the API
+ */
+static bool sdc_transfer_sg(SDCDriver *sdcp, uint32_t startblk,
+                            const sdcsegment_t *sgl, size_t count,
+                            bool write) {
+  uint32_t n = 0;
+  bool status;
+
+  osalDbgCheck((sdcp != NULL) && (sgl != NULL) && (count > 0U));
+  osalDbgAssert(sdcp->state == BLK_READY, "invalid state");
+
+  for (size_t i = 0; i < count; i++) {
+    osalDbgCheck((sgl[i].buf != NULL) && (sgl[i].blocks > 0U));
+    n += sgl[i].blocks;
+  }
+
+  if ((startblk + n - 1U) > sdcp->capacity) {
+    sdcp->errors |= SDC_OVERFLOW_ERROR;
+    return HAL_FAILED;
+  }
+
+  sdcp->state = write ? BLK_WRITING : BLK_READING;
+  status = sdc_lld_transfer_sg(sdcp, startblk, sgl, count, write);
+  sdcp->state = BLK_READY;
+
+  return status;
+}
+
 /*===========================================================================*/
 /* Driver interrupt handlers.                                                */
 /*===========================================================================*/
@@ -897,12 +1075,9 @@ bool sdc_lld_send_cmd_long_crc(SDCDriver *sdcp, uint8_t cmd, uint32_t arg,
 
 bool sdc_lld_read(SDCDriver *sdcp, uint32_t startblk,
 		  uint8_t *buf, uint32_t n) {
-  uint32_t cmdx = (n == 1)?
-    SDHC_XFERTYP_CMDINX(MMCSD_CMD_READ_SINGLE_BLOCK) :
-    SDHC_XFERTYP_CMDINX(MMCSD_CMD_READ_MULTIPLE_BLOCK);
-  cmdx |= SDHC_XFERTYP_DTDSEL;
+  const sdcsegment_t seg = {buf, n};
 
-  return sdc_lld_transfer(sdcp, startblk, (uintptr_t)buf, n, cmdx);
+  return sdc_lld_transfer_sg(sdcp, startblk, &seg, 1, false);
 }
 
 /**
@@ -921,11 +1096,9 @@ bool sdc_lld_read(SDCDriver *sdcp, uint32_t startblk,
  */
 bool sdc_lld_write(SDCDriver *sdcp, uint32_t startblk,
                    const uint8_t *buf, uint32_t n) {
-  uint32_t cmdx = (n == 1)?
-    SDHC_XFERTYP_CMDINX(MMCSD_CMD_WRITE_BLOCK) :
-    SDHC_XFERTYP_CMDINX(MMCSD_CMD_WRITE_MULTIPLE_BLOCK);
+  const sdcsegment_t seg = {(uint8_t *)buf, n};
 
-  return sdc_lld_transfer(sdcp, startblk, (uintptr_t)buf, n, cmdx);
+  return sdc_lld_transfer_sg(sdcp, startblk, &seg, 1, true);
 }
 
 /**
@@ -961,6 +1134,8 @@ bool sdc_lld_read_special(SDCDriver *sdcp, uint8_t *buf, size_t bytes,
 
   /* Store the cmd argument and DMA start address */
   SDHC->CMDARG = argument;
+  SDHC->PROCTL = (SDHC->PROCTL & ~SDHC_PROCTL_DMAS_MASK) |
+    SDHC_PROCTL_DMAS_SDMA;
   SDHC->DSADDR = bufaddr;
 
   /* We're reading one block, of a (possibly) nonstandard size */
@@ -988,6 +1163,50 @@ bool sdc_lld_is_write_protected(SDCDriver *sdcp) {
   return false;
 }
 
+/**
+ * @brief   Reads blocks into a scatter-gather list.
+ * @details The segments are filled in order from @p startblk on, in as
+ *          few commands as the descriptor table and bounce buffer allow.
+ *
+ * @param[in] sdcp      pointer to the @p SDCDriver object
+ * @param[in] startblk  first block to read
+ * @param[in] sgl       segments to fill, any alignment
+ * @param[in] count     number of segments
+ *
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  operation succeeded.
+ * @retval HAL_FAILED   operation failed.
+ *
+ * @api
+ */
+bool sdcKinetisReadSG(SDCDriver *sdcp, uint32_t startblk,
+                      const sdcsegment_t *sgl, size_t count) {
+
+  return sdc_transfer_sg(sdcp, startblk, sgl, count, false);
+}
+
+/**
+ * @brief   Writes blocks from a scatter-gather list.
+ * @details The segments are written in order from @p startblk on, in as
+ *          few commands as the descriptor table and bounce buffer allow.
+ *
+ * @param[in] sdcp      pointer to the @p SDCDriver object
+ * @param[in] startblk  first block to write
+ * @param[in] sgl       segments to write, any alignment
+ * @param[in] count     number of segments
+ *
+ * @return              The operation status.
+ * @retval HAL_SUCCESS  operation succeeded.
+ * @retval HAL_FAILED   operation failed.
+ *
+ * @api
+ */
+bool sdcKinetisWriteSG(SDCDriver *sdcp, uint32_t startblk,
+                       const sdcsegment_t *sgl, size_t count) {
+
+  return sdc_transfer_sg(sdcp, startblk, sgl, count, true);
+}
+
 #endif /* HAL_USE_SDC == TRUE */
 
 /** @} */
@@ -46,6 +46,14 @@
 #define SDHC_PROCTL_DTW_4BIT            SDHC_PROCTL_DTW(1)
 #define SDHC_PROCTL_DTW_8BIT            SDHC_PROCTL_DTW(2)
 
+#define SDHC_PROCTL_DMAS_SDMA           (0U << SDHC_PROCTL_DMAS_SHIFT)
+#define SDHC_PROCTL_DMAS_ADMA2          (2U << SDHC_PROCTL_DMAS_SHIFT)
+
+/**
+ * @brief   Largest ADMA2 descriptor length, in blocks.
+ */
+#define SDHC_ADMA2_MAX_BLOCKS           (0xFFFFU / MMCSD_BLOCK_SIZE)
+
 /*===========================================================================*/
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
@@ -62,12 +70,49 @@
 #if !defined(PLATFORM_SDC_USE_SDC1) || defined(__DOXYGEN__)
 #define PLATFORM_SDC_USE_SDC1                  TRUE
 #endif
+
+/**
+ * @brief   Number of ADMA2 descriptors.
+ * @details Each segment of a transfer takes one descriptor per
+ *          @p SDHC_ADMA2_MAX_BLOCKS, longer lists are split over several
+ *          commands.
+ */
+#if !defined(KINETIS_SDHC_ADMA2_DESCRIPTORS) || defined(__DOXYGEN__)
+#define KINETIS_SDHC_ADMA2_DESCRIPTORS         16
+#endif
+
+/**
+ * @brief   Bounce buffer size, in blocks.
+ * @details ADMA2 only reaches word aligned memory, unaligned segments are
+ *          staged here. It bounds the unaligned blocks of one command.
+ */
+#if !defined(KINETIS_SDHC_BOUNCE_BLOCKS) || defined(__DOXYGEN__)
+#define KINETIS_SDHC_BOUNCE_BLOCKS             4
+#endif
+
+/**
+ * @brief   Pre-erase before multiple block writes.
+ * @details Sends ACMD23 with the block count ahead of each multiple block
+ *          write to SD cards.
+ */
+#if !defined(KINETIS_SDHC_USE_PREERASE) || defined(__DOXYGEN__)
+#define KINETIS_SDHC_USE_PREERASE              TRUE
+#endif
 /** @} */
 
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
 
+#if (KINETIS_SDHC_ADMA2_DESCRIPTORS < 1) ||                                 \
+    (KINETIS_SDHC_ADMA2_DESCRIPTORS * SDHC_ADMA2_MAX_BLOCKS > 0xFFFF)
+#error "invalid KINETIS_SDHC_ADMA2_DESCRIPTORS value"
+#endif
+
+#if KINETIS_SDHC_BOUNCE_BLOCKS < 1
+#error "invalid KINETIS_SDHC_BOUNCE_BLOCKS value"
+#endif
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -87,6 +132,29 @@ typedef uint32_t sdcflags_t;
  */
 typedef struct SDCDriver SDCDriver;
 
+/**
+ * @brief   ADMA2 descriptor.
+ */
+typedef struct {
+  uint16_t      attr;
+  uint16_t      length;
+  uint32_t      address;
+} sdcadma2desc_t;
+
+/**
+ * @brief   Scatter-gather list segment.
+ */
+typedef struct {
+  /**
+   * @brief   Segment buffer, any alignment.
+   */
+  uint8_t       *buf;
+  /**
+   * @brief   Segment length, in blocks.
+   */
+  uint32_t      blocks;
+} sdcsegment_t;
+
 /**
  * @brief   Driver configuration structure.
  * @note    It could be empty on some architectures.
@@ -151,6 +219,15 @@ struct SDCDriver {
 
   /* Platform specific fields */
   thread_reference_t        thread;
+  /**
+   * @brief ADMA2 descriptor table.
+   */
+  sdcadma2desc_t            adma2[KINETIS_SDHC_ADMA2_DESCRIPTORS];
+  /**
+   * @brief Bounce buffer for unaligned segments.
+   */
+  uint32_t                  bounce[KINETIS_SDHC_BOUNCE_BLOCKS *
+                                   MMCSD_BLOCK_SIZE / 4U];
 };
 
 /*===========================================================================*/
@@ -191,6 +268,10 @@ extern "C" {
   bool sdc_lld_sync(SDCDriver *sdcp);
   bool sdc_lld_is_card_inserted(SDCDriver *sdcp);
   bool sdc_lld_is_write_protected(SDCDriver *sdcp);
+  bool sdcKinetisReadSG(SDCDriver *sdcp, uint32_t startblk,
+                        const sdcsegment_t *sgl, size_t count);
+  bool sdcKinetisWriteSG(SDCDriver *sdcp, uint32_t startblk,
+                         const sdcsegment_t *sgl, size_t count);
 #ifdef __cplusplus
 }
 #endif
@@ -52,6 +52,11 @@
       | (GPIO_PIN_CNF_INPUT_Connect  << GPIO_PIN_CNF_INPUT_Pos) \
       | (GPIO_PIN_CNF_DIR_Output     << GPIO_PIN_CNF_DIR_Pos))
 
+#if NRF_SERIES == 52
+#define SPI0_TWI0_IRQn  SPIM0_SPIS0_TWIM0_TWIS0_SPI0_TWI0_IRQn
+#define SPI1_TWI1_IRQn  SPIM1_SPIS1_TWIM1_TWIS1_SPI1_TWI1_IRQn
+#endif
+
 #if NRF5_I2C_USE_I2C0
 #define I2C_IRQ_NUM     SPI0_TWI0_IRQn
 #define I2C_IRQ_PRI     NRF5_I2C_I2C0_IRQ_PRIORITY
@@ -60,6 +65,13 @@
 #define I2C_IRQ_PRI     NRF5_I2C_I2C1_IRQ_PRIORITY
 #endif
 
+#if NRF5_I2C_USE_DMA
+#define I2C_FREQUENCY(f) (TWIM_FREQUENCY_FREQUENCY_##f << TWIM_FREQUENCY_FREQUENCY_Pos)
+#define I2C_IS_RAM(p)    (((uint32_t)(p) & 0xE0000000U) == 0x20000000U)
+#else
+#define I2C_FREQUENCY(f) (TWI_FREQUENCY_FREQUENCY_##f << TWI_FREQUENCY_FREQUENCY_Pos)
+#endif
+
 /*===========================================================================*/
 /* Driver exported variables.                                                */
 /*===========================================================================*/
@@ -132,6 +144,54 @@ static void i2c_clear_bus(I2CDriver *i2cp)
   I2C_HIGH(cfg->sda_pad);
 }
 
+#if NRF5_I2C_USE_DMA || defined(__DOXYGEN__)
+#if defined(__GNUC__)
+__attribute__((noinline))
+#endif
+/**
+ * @brief   Common IRQ handler.
+ * @note    The data moves by EasyDMA and the legs are chained by shortcuts,
+ *          a successful transaction only interrupts on STOPPED. After an
+ *          error the bus is released by an explicit STOP and the caller
+ *          is woken on STOPPED as well.
+ *
+ * @param[in] i2cp         pointer to an I2CDriver
+ */
+static void serve_interrupt(I2CDriver *i2cp) {
+
+  NRF_TWIM_Type *i2c = i2cp->i2c;
+
+  if(i2c->EVENTS_ERROR) {
+
+    uint32_t err = i2c->ERRORSRC;
+    i2c->EVENTS_ERROR = 0;
+#if CORTEX_MODEL >= 4
+    (void)i2c->EVENTS_ERROR;
+#endif
+    i2c->ERRORSRC = err;
+    if (err & (TWIM_ERRORSRC_ANACK_Msk | TWIM_ERRORSRC_DNACK_Msk))
+      i2cp->errors |= I2C_ACK_FAILURE;
+    else
+      i2cp->errors |= I2C_BUS_ERROR;
+
+    i2c->SHORTS = 0;
+    i2c->TASKS_STOP = 1;
+  }
+  if(i2c->EVENTS_STOPPED) {
+
+    i2c->EVENTS_STOPPED = 0;
+#if CORTEX_MODEL >= 4
+    (void)i2c->EVENTS_STOPPED;
+#endif
+    i2c->SHORTS = 0;
+    if (i2cp->errors != I2C_NO_ERROR)
+      _i2c_wakeup_error_isr(i2cp);
+    else
+      _i2c_wakeup_isr(i2cp);
+  }
+}
+
+#else /* !NRF5_I2C_USE_DMA */
 static inline void i2c_setup_shortcut(I2CDriver *i2cp)
 {
   uint32_t rxbytes = i2cp->rxbytes;
@@ -221,6 +281,7 @@ static void serve_interrupt(I2CDriver *i2cp) {
     _i2c_wakeup_isr(i2cp);
   }
 }
+#endif /* !NRF5_I2C_USE_DMA */
 
 /*===========================================================================*/
 /* Driver interrupt handlers.                                                */
@@ -262,14 +323,22 @@ void i2c_lld_init(void) {
 #if NRF5_I2C_USE_I2C0
   i2cObjectInit(&I2CD1);
   I2CD1.thread = NULL;
+#if NRF5_I2C_USE_DMA
+  I2CD1.i2c = NRF_TWIM0;
+#else
   I2CD1.i2c = NRF_TWI0;
 #endif
+#endif
 
 #if NRF5_I2C_USE_I2C1
   i2cObjectInit(&I2CD2);
   I2CD2.thread = NULL;
+#if NRF5_I2C_USE_DMA
+  I2CD2.i2c = NRF_TWIM1;
+#else
   I2CD2.i2c = NRF_TWI1;
 #endif
+#endif
 
 }
 
@@ -282,7 +351,11 @@ void i2c_lld_init(void) {
  */
 void i2c_lld_start(I2CDriver *i2cp) {
 
+#if NRF5_I2C_USE_DMA
+  NRF_TWIM_Type *i2c = i2cp->i2c;
+#else
   NRF_TWI_Type *i2c = i2cp->i2c;
+#endif
   const I2CConfig *cfg = i2cp->config;
 
   if (i2cp->state != I2C_STOP)
@@ -293,29 +366,38 @@ void i2c_lld_start(I2CDriver *i2cp) {
   IOPORT1->PIN_CNF[cfg->scl_pad] = I2C_PIN_CNF;
   IOPORT1->PIN_CNF[cfg->sda_pad] = I2C_PIN_CNF;
 
+#if NRF5_I2C_USE_DMA
+  i2c->EVENTS_STOPPED = 0;
+  i2c->EVENTS_ERROR = 0;
+#if CORTEX_MODEL >= 4
+  (void)i2c->EVENTS_STOPPED;
+  (void)i2c->EVENTS_ERROR;
+#endif
+#else
   i2c->EVENTS_RXDREADY = 0;
   i2c->EVENTS_TXDSENT = 0;
 #if CORTEX_MODEL >= 4
   (void)i2c->EVENTS_RXDREADY;
   (void)i2c->EVENTS_TXDSENT;
 #endif
-#if NRF_SERIES == 51
-  i2c->PSELSCL = cfg->scl_pad;
-  i2c->PSELSDA = cfg->sda_pad;
-#else
+#endif
+#if NRF5_I2C_USE_DMA
   i2c->PSEL.SCL = cfg->scl_pad;
   i2c->PSEL.SDA = cfg->sda_pad;
+#else
+  i2c->PSELSCL = cfg->scl_pad;
+  i2c->PSELSDA = cfg->sda_pad;
 #endif
   
   switch (cfg->clock) {
     case 100000:
-      i2c->FREQUENCY = TWI_FREQUENCY_FREQUENCY_K100 << TWI_FREQUENCY_FREQUENCY_Pos;
+      i2c->FREQUENCY = I2C_FREQUENCY(K100);
       break;
     case 250000:
-      i2c->FREQUENCY = TWI_FREQUENCY_FREQUENCY_K250 << TWI_FREQUENCY_FREQUENCY_Pos;
+      i2c->FREQUENCY = I2C_FREQUENCY(K250);
       break;
     case 400000:
-      i2c->FREQUENCY = TWI_FREQUENCY_FREQUENCY_K400 << TWI_FREQUENCY_FREQUENCY_Pos;
+      i2c->FREQUENCY = I2C_FREQUENCY(K400);
       break;
     default:
       osalDbgAssert(0, "invalid I2C frequency");
@@ -324,10 +406,17 @@ void i2c_lld_start(I2CDriver *i2cp) {
 
   nvicEnableVector(I2C_IRQ_NUM, I2C_IRQ_PRI);
 
+#if NRF5_I2C_USE_DMA
+  i2c->SHORTS = 0;
+  i2c->INTENSET = TWIM_INTENSET_STOPPED_Msk | TWIM_INTENSET_ERROR_Msk;
+
+  i2c->ENABLE = TWIM_ENABLE_ENABLE_Enabled << TWIM_ENABLE_ENABLE_Pos;
+#else
   i2c->INTENSET = TWI_INTENSET_TXDSENT_Msk | TWI_INTENSET_STOPPED_Msk |
     TWI_INTENSET_ERROR_Msk | TWI_INTENSET_RXDREADY_Msk;
 
   i2c->ENABLE = TWI_ENABLE_ENABLE_Enabled << TWI_ENABLE_ENABLE_Pos;
+#endif
 }
 
 /**
@@ -339,15 +428,23 @@ void i2c_lld_start(I2CDriver *i2cp) {
  */
 void i2c_lld_stop(I2CDriver *i2cp) {
 
+#if NRF5_I2C_USE_DMA
+  NRF_TWIM_Type *i2c = i2cp->i2c;
+#else
   NRF_TWI_Type *i2c = i2cp->i2c;
+#endif
   const I2CConfig *cfg = i2cp->config;
 
   if (i2cp->state != I2C_STOP) {
 
     i2c->ENABLE = TWI_ENABLE_ENABLE_Disabled << TWI_ENABLE_ENABLE_Pos;
 
+#if NRF5_I2C_USE_DMA
+    i2c->INTENCLR = TWIM_INTENCLR_STOPPED_Msk | TWIM_INTENCLR_ERROR_Msk;
+#else
     i2c->INTENCLR = TWI_INTENSET_TXDSENT_Msk | TWI_INTENSET_STOPPED_Msk |
       TWI_INTENSET_ERROR_Msk | TWI_INTENSET_RXDREADY_Msk;
+#endif
 
     nvicDisableVector(I2C_IRQ_NUM);
 
@@ -361,7 +458,11 @@ static inline msg_t _i2c_txrx_timeout(I2CDriver *i2cp, i2caddr_t addr,
                                       uint8_t *rxbuf, size_t rxbytes,
                                       systime_t timeout) {
 
+#if NRF5_I2C_USE_DMA
+  NRF_TWIM_Type *i2c = i2cp->i2c;
+#else
   NRF_TWI_Type *i2c = i2cp->i2c;
+#endif
 
   (void)timeout;
   msg_t msg;
@@ -377,6 +478,46 @@ static inline msg_t _i2c_txrx_timeout(I2CDriver *i2cp, i2caddr_t addr,
 
   i2c->ADDRESS = addr;
 
+#if NRF5_I2C_USE_DMA
+  osalDbgCheck((txbytes <= NRF5_I2C_DMA_MAXCNT) &&
+               (rxbytes <= NRF5_I2C_DMA_MAXCNT));
+  osalDbgAssert((txbytes == 0) || I2C_IS_RAM(txbuf),
+                "transmit buffer not in RAM");
+  osalDbgAssert((rxbytes == 0) || I2C_IS_RAM(rxbuf),
+                "receive buffer not in RAM");
+
+  i2c->TXD.PTR = (uint32_t)txbuf;
+  i2c->TXD.MAXCNT = txbytes;
+  i2c->RXD.PTR = (uint32_t)rxbuf;
+  i2c->RXD.MAXCNT = rxbytes;
+
+  /* A STOPPED left over by the STOP issued after a late error must not end
+     this transaction.*/
+  i2c->EVENTS_STOPPED = 0;
+  i2c->EVENTS_ERROR = 0;
+#if CORTEX_MODEL >= 4
+  (void)i2c->EVENTS_STOPPED;
+  (void)i2c->EVENTS_ERROR;
+#endif
+
+  if (txbytes && rxbytes) {
+
+    /* Write, repeated start, read and stop without the CPU.*/
+    i2c->SHORTS = TWIM_SHORTS_LASTTX_STARTRX_Msk | TWIM_SHORTS_LASTRX_STOP_Msk;
+    i2c->TASKS_STARTTX = 1;
+  } else if (txbytes) {
+
+    i2c->SHORTS = TWIM_SHORTS_LASTTX_STOP_Msk;
+    i2c->TASKS_STARTTX = 1;
+  } else if (rxbytes) {
+
+    i2c->SHORTS = TWIM_SHORTS_LASTRX_STOP_Msk;
+    i2c->TASKS_STARTRX = 1;
+  } else {
+
+    osalDbgAssert(0, "no bytes to transfer");
+  }
+#else
   tx_resume_count = 0;
   rx_resume_count = 0;
   stop_count = 0;
@@ -394,6 +535,7 @@ static inline msg_t _i2c_txrx_timeout(I2CDriver *i2cp, i2caddr_t addr,
 
     osalDbgAssert(0, "no bytes to transfer");
   }
+#endif
 
   msg = osalThreadSuspendTimeoutS(&i2cp->thread, timeout);
 
@@ -75,6 +75,19 @@
 #if !defined(NRF5_I2C_I2C1_IRQ_PRIORITY) || defined(__DOXYGEN__)
 #define NRF5_I2C_I2C1_IRQ_PRIORITY         3
 #endif
+
+/**
+ * @brief   Use the TWIM peripheral with EasyDMA.
+ * @details Both legs of a transaction are moved by EasyDMA and chained by
+ *          shortcuts, write then repeated start then read, the transaction
+ *          ends with a single interrupt. NRF52 only.
+ * @note    EasyDMA can only access RAM, transmit buffers in flash are not
+ *          allowed.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(NRF5_I2C_USE_DMA) || defined(__DOXYGEN__)
+#define NRF5_I2C_USE_DMA                   FALSE
+#endif
 /** @} */
 
 /*===========================================================================*/
@@ -91,6 +104,18 @@
 #error "Invalid IRQ priority assigned to I2C1"
 #endif
 
+#if NRF5_I2C_USE_DMA && (NRF_SERIES != 52)
+#error "TWIM EasyDMA requires NRF52"
+#endif
+
+#if NRF5_I2C_USE_DMA || defined(__DOXYGEN__)
+/**
+ * @brief   Largest EasyDMA leg of a transaction, bytes.
+ */
+#define NRF5_I2C_DMA_MAXCNT                                                 \
+  (TWIM_TXD_MAXCNT_MAXCNT_Msk >> TWIM_TXD_MAXCNT_MAXCNT_Pos)
+#endif
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -175,8 +200,13 @@ struct I2CDriver {
   size_t                    rxbytes;
   /* @brief Tracks current ISR state. */
   intstate_t                intstate;
+#if NRF5_I2C_USE_DMA || defined(__DOXYGEN__)
+  /* @brief Low-level register access. */
+  NRF_TWIM_Type             *i2c;
+#else
   /* @brief Low-level register access. */
   NRF_TWI_Type              *i2c;
+#endif
 };
 
 /*===========================================================================*/
@@ -22,6 +22,8 @@
  * @{
  */
 
+#include <string.h>
+
 #include "hal.h"
 
 #if (HAL_USE_RNG == TRUE) || defined(__DOXYGEN__)
@@ -37,6 +39,11 @@ static const RNGConfig default_config = {
   .digital_error_correction = 1,
 };
 
+/**
+ * @brief   Pool bytes taken by a DRBG reseed.
+ */
+#define DRBG_SEED_SIZE  32U
+
 /*===========================================================================*/
 /* Driver exported variables.                                                */
 /*===========================================================================*/
@@ -54,10 +61,285 @@ RNGDriver RNGD1;
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+/**
+ * @brief   Runs the health tests on a new sample.
+ * @details Repetition count and adaptive proportion tests as described by
+ *          NIST SP 800-90B, with the cutoffs given by the configuration.
+ *
+ * @param[in] rngp      pointer to the @p RNGDriver object
+ * @param[in] v         new sample
+ * @return              The sample can enter the pool.
+ */
+static bool health_test(RNGDriver *rngp, uint8_t v) {
+  bool pass = true;
+
+  if (v == rngp->rct_last) {
+    if (rngp->rct_count < NRF5_RNG_RCT_CUTOFF) {
+      if (++rngp->rct_count == NRF5_RNG_RCT_CUTOFF)
+        rngp->stats.rct_failures++;
+    }
+    if (rngp->rct_count >= NRF5_RNG_RCT_CUTOFF)
+      pass = false;
+  }
+  else {
+    rngp->rct_last  = v;
+    rngp->rct_count = 1;
+  }
+
+  if (rngp->apt_samples == 0) {
+    rngp->apt_first = v;
+    rngp->apt_count = 1;
+  }
+  else if (v == rngp->apt_first) {
+    if (++rngp->apt_count == NRF5_RNG_APT_CUTOFF)
+      rngp->stats.apt_failures++;
+    if (rngp->apt_count >= NRF5_RNG_APT_CUTOFF)
+      pass = false;
+  }
+  if (++rngp->apt_samples == NRF5_RNG_APT_WINDOW)
+    rngp->apt_samples = 0;
+
+  return pass;
+}
+
+/**
+ * @brief   Takes bytes from the pool.
+ * @details Taken bytes are wiped and the RNG is restarted if the pool was
+ *          full.
+ *
+ * @param[in] rngp      pointer to the @p RNGDriver object
+ * @param[out] buf      destination buffer
+ * @param[in] n         number of bytes wanted
+ * @return              The number of bytes taken.
+ *
+ * @sclass
+ */
+static size_t pool_take(RNGDriver *rngp, uint8_t *buf, size_t n) {
+  size_t i;
+
+  if (n > rngp->count)
+    n = rngp->count;
+  for (i = 0; i < n; i++) {
+    buf[i] = rngp->pool[rngp->rdidx];
+    rngp->pool[rngp->rdidx] = 0;
+    rngp->rdidx = (rngp->rdidx + 1U) & (NRF5_RNG_POOL_SIZE - 1U);
+  }
+  if (n > 0) {
+    rngp->count -= n;
+    rngp->rng->TASKS_START = 1;
+  }
+  return n;
+}
+
+/**
+ * @brief   Waits until the pool holds @p need bytes.
+ *
+ * @param[in] rngp      pointer to the @p RNGDriver object
+ * @param[in] need      pool level to wait for
+ * @param[in] timeout   the number of ticks before the operation timeouts
+ * @return              The wait result.
+ *
+ * @sclass
+ */
+static msg_t pool_wait(RNGDriver *rngp, size_t need, systime_t timeout) {
+  msg_t msg;
+
+  if (timeout == TIME_IMMEDIATE)
+    return MSG_TIMEOUT;
+  if (need > NRF5_RNG_POOL_SIZE)
+    need = NRF5_RNG_POOL_SIZE;
+  rngp->stats.waits++;
+  rngp->need = need;
+  msg = osalThreadSuspendTimeoutS(&rngp->thread, timeout);
+  rngp->need = 0;
+  return msg;
+}
+
+#if (NRF5_RNG_USE_DRBG == TRUE) || defined(__DOXYGEN__)
+#define ROTL32(v, n)    (((v) << (n)) | ((v) >> (32 - (n))))
+
+#define QUARTERROUND(a, b, c, d) {                                          \
+  a += b; d ^= a; d = ROTL32(d, 16);                                        \
+  c += d; b ^= c; b = ROTL32(b, 12);                                        \
+  a += b; d ^= a; d = ROTL32(d, 8);                                         \
+  c += d; b ^= c; b = ROTL32(b, 7);                                         \
+}
+
+/**
+ * @brief   Computes one ChaCha20 keystream block, nonce zero.
+ *
+ * @param[in] key       256 bits key
+ * @param[in] counter   block counter
+ * @param[out] out      keystream block
+ */
+static void chacha20_block(const uint32_t key[8], uint32_t counter,
+                           uint32_t out[16]) {
+  uint32_t x[16];
+  unsigned i;
+
+  x[0]  = 0x61707865U;
+  x[1]  = 0x3320646EU;
+  x[2]  = 0x79622D32U;
+  x[3]  = 0x6B206574U;
+  for (i = 0; i < 8U; i++)
+    x[4U + i] = key[i];
+  x[12] = counter;
+  x[13] = 0;
+  x[14] = 0;
+  x[15] = 0;
+  memcpy(out, x, sizeof (x));
+
+  for (i = 0; i < 10U; i++) {
+    QUARTERROUND(x[0], x[4], x[8],  x[12]);
+    QUARTERROUND(x[1], x[5], x[9],  x[13]);
+    QUARTERROUND(x[2], x[6], x[10], x[14]);
+    QUARTERROUND(x[3], x[7], x[11], x[15]);
+    QUARTERROUND(x[0], x[5], x[10], x[15]);
+    QUARTERROUND(x[1], x[6], x[11], x[12]);
+    QUARTERROUND(x[2], x[7], x[8],  x[13]);
+    QUARTERROUND(x[3], x[4], x[9],  x[14]);
+  }
+  for (i = 0; i < 16U; i++)
+    out[i] += x[i];
+}
+
+/**
+ * @brief   Mixes pool bytes into the DRBG key.
+ * @details Due reseeds are postponed while the pool holds less than a seed,
+ *          only the first seed is waited for.
+ *
+ * @param[in] rngp      pointer to the @p RNGDriver object
+ * @param[in] timeout   the number of ticks before the operation timeouts
+ * @return              The operation status.
+ *
+ * @sclass
+ */
+static msg_t drbg_reseed(RNGDriver *rngp, systime_t timeout) {
+  uint32_t seed[DRBG_SEED_SIZE / 4U];
+  unsigned i;
+
+  if (rngp->count < DRBG_SEED_SIZE) {
+    msg_t msg;
+
+    if (rngp->stats.reseeds > 0)
+      return MSG_OK;
+    msg = pool_wait(rngp, DRBG_SEED_SIZE, timeout);
+    if (msg != MSG_OK)
+      return msg;
+  }
+
+  (void)pool_take(rngp, (uint8_t *)seed, DRBG_SEED_SIZE);
+  for (i = 0; i < DRBG_SEED_SIZE / 4U; i++) {
+    rngp->drbg_key[i] ^= seed[i];
+    seed[i] = 0;
+  }
+  rngp->drbg_left = NRF5_RNG_DRBG_RESEED_BYTES;
+  rngp->stats.reseeds++;
+  return MSG_OK;
+}
+
+/**
+ * @brief   Generates DRBG output.
+ * @details The key is snapshotted and replaced by its first keystream
+ *          block under the lock, the output is the following blocks of
+ *          the snapshot. Earlier output cannot be recovered from a later
+ *          key and concurrent callers get different keys.
+ * @note    The keystream is computed outside of the system lock unless
+ *          @p timeout is @p TIME_IMMEDIATE, the caller may then be an ISR
+ *          and the whole output is computed under the lock.
+ *
+ * @param[in] rngp      pointer to the @p RNGDriver object
+ * @param[out] buf      destination buffer
+ * @param[in] n         number of bytes
+ * @param[in] timeout   the number of ticks before the operation timeouts
+ * @return              The operation status.
+ *
+ * @sclass
+ */
+static msg_t drbg_generate(RNGDriver *rngp, uint8_t *buf, size_t n,
+                           systime_t timeout) {
+  uint32_t key[8];
+  uint32_t block[16];
+  uint32_t counter = 1;
+
+  if (rngp->drbg_left == 0) {
+    msg_t msg = drbg_reseed(rngp, timeout);
+
+    if (msg != MSG_OK)
+      return msg;
+  }
+
+  memcpy(key, rngp->drbg_key, sizeof (key));
+  chacha20_block(key, 0, block);
+  memcpy(rngp->drbg_key, block, sizeof (rngp->drbg_key));
+  rngp->drbg_left = (n < rngp->drbg_left) ? rngp->drbg_left - n : 0;
+  rngp->stats.output_bytes += n;
+
+  if (timeout != TIME_IMMEDIATE)
+    osalSysUnlock();
+  while (n > 0) {
+    size_t chunk = (n < sizeof (block)) ? n : sizeof (block);
+
+    chacha20_block(key, counter++, block);
+    memcpy(buf, block, chunk);
+    buf += chunk;
+    n   -= chunk;
+  }
+  memset(block, 0, sizeof (block));
+  memset(key, 0, sizeof (key));
+  if (timeout != TIME_IMMEDIATE)
+    osalSysLock();
+
+  return MSG_OK;
+}
+#endif /* NRF5_RNG_USE_DRBG == TRUE */
+
+/**
+ * @brief   Common IRQ handler.
+ *
+ * @param[in] rngp      pointer to the @p RNGDriver object
+ */
+static void serve_interrupt(RNGDriver *rngp) {
+  NRF_RNG_Type *rng = rngp->rng;
+  uint8_t v;
+
+  v = (uint8_t)rng->VALUE;
+  rng->EVENTS_VALRDY = 0;
+#if CORTEX_MODEL >= 4
+  (void)rng->EVENTS_VALRDY;
+#endif
+
+  osalSysLockFromISR();
+  rngp->stats.entropy_bytes++;
+  if (health_test(rngp, v) && (rngp->count < NRF5_RNG_POOL_SIZE)) {
+    rngp->pool[(rngp->rdidx + rngp->count) & (NRF5_RNG_POOL_SIZE - 1U)] = v;
+    rngp->count++;
+  }
+  if (rngp->count == NRF5_RNG_POOL_SIZE)
+    rng->TASKS_STOP = 1;
+  if ((rngp->thread != NULL) && (rngp->count >= rngp->need))
+    osalThreadResumeI(&rngp->thread, MSG_OK);
+  osalSysUnlockFromISR();
+}
+
 /*===========================================================================*/
 /* Driver interrupt handlers.                                                */
 /*===========================================================================*/
 
+#if NRF5_RNG_USE_RNG0 || defined(__DOXYGEN__)
+/**
+ * @brief   RNG interrupt handler.
+ *
+ * @isr
+ */
+OSAL_IRQ_HANDLER(Vector74) {
+
+  OSAL_IRQ_PROLOGUE();
+  serve_interrupt(&RNGD1);
+  OSAL_IRQ_EPILOGUE();
+}
+#endif
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -71,10 +353,24 @@ void rng_lld_init(void) {
   rngObjectInit(&RNGD1);
   RNGD1.rng    = NRF_RNG;
   RNGD1.irq    = RNG_IRQn;
+  RNGD1.thread = NULL;
+  RNGD1.need   = 0;
+  RNGD1.rdidx  = 0;
+  RNGD1.count  = 0;
+  RNGD1.rct_last    = 0;
+  RNGD1.rct_count   = 0;
+  RNGD1.apt_samples = 0;
+#if NRF5_RNG_USE_DRBG
+  memset(RNGD1.drbg_key, 0, sizeof (RNGD1.drbg_key));
+  RNGD1.drbg_left = 0;
+#endif
+  memset(&RNGD1.stats, 0, sizeof (RNGD1.stats));
 }
 
 /**
  * @brief   Configures and activates the RNG peripheral.
+ * @details The pool keeps its content across stop and start, filling
+ *          resumes here.
  *
  * @param[in] rngp      pointer to the @p RNGDriver object
  *
@@ -101,9 +397,11 @@ void rng_lld_start(RNGDriver *rngp) {
     
   /* Set interrupt mask */
   rng->INTENSET      = RNG_INTENSET_VALRDY_Msk;
+  nvicEnableVector(rngp->irq, NRF5_RNG_RNG0_IRQ_PRIORITY);
 
   /* Start */
-  rng->TASKS_START   = 1;
+  if (rngp->count < NRF5_RNG_POOL_SIZE)
+    rng->TASKS_START = 1;
 }
 
 
@@ -119,49 +417,66 @@ void rng_lld_stop(RNGDriver *rngp) {
 
   /* Stop peripheric */
   rng->TASKS_STOP = 1;
+  rng->INTENCLR   = RNG_INTENCLR_VALRDY_Msk;
+  nvicDisableVector(rngp->irq);
 }
 
 
 /**
  * @brief   Write random bytes;
+ * @details Bytes come from the entropy pool, or from the DRBG when
+ *          enabled. The caller only waits when the pool has not enough
+ *          bytes, the timeout applies to each wait.
+ * @note    From ISR context use @p TIME_IMMEDIATE, a dry pool then
+ *          returns @p MSG_TIMEOUT.
  *
  * @param[in] rngp      pointer to the @p RNGDriver object
  * @param[in] n         size of buf in bytes
  * @param[in] buf       @p buffer location
+ * @param[in] timeout   the number of ticks before the operation timeouts
+ * @return              The operation status.
  *
  * @notapi
  */
 msg_t rng_lld_write(RNGDriver *rngp, uint8_t *buf, size_t n,
                     systime_t timeout) {
-  NRF_RNG_Type *rng = rngp->rng;
-  size_t i;
+#if NRF5_RNG_USE_DRBG
+  return drbg_generate(rngp, buf, n, timeout);
+#else
+  size_t left = n;
+  size_t got;
+  msg_t msg;
 
-  for (i = 0 ; i < n ; i++) {
-    /* Wait for byte ready
-     * It take about 677µs to generate a new byte, not sure if
-     * forcing a context switch will be a benefit
-     */
-    while (rng->EVENTS_VALRDY == 0) {
-      /* Sleep and wakeup on ARM event (interrupt) */
-      SCB->SCR |= SCB_SCR_SEVONPEND_Msk;
-      __SEV();
-      __WFE();
-      __WFE();
-    }
-
-    /* Read byte */
-    buf[i] = (char)rng->VALUE;
+  while (true) {
+    got = pool_take(rngp, buf, left);
+    buf  += got;
+    left -= got;
+    rngp->stats.output_bytes += got;
+    if (left == 0)
+      return MSG_OK;
 
-    /* Mark as read */
-    rng->EVENTS_VALRDY = 0;
-#if CORTEX_MODEL >= 4
-    (void)rng->EVENTS_VALRDY;
-#endif
-    
-    /* Clear interrupt so we can wake up again */
-    nvicClearPending(rngp->irq);
+    msg = pool_wait(rngp, left, timeout);
+    if (msg != MSG_OK)
+      return msg;
   }
-  return MSG_OK;
+#endif
+}
+
+/**
+ * @brief   Returns a snapshot of the driver statistics.
+ *
+ * @param[in] rngp      pointer to the @p RNGDriver object
+ * @param[out] statsp   pointer to the statistics structure
+ *
+ * @api
+ */
+void rngNRF5GetStats(RNGDriver *rngp, nrf5_rng_stats_t *statsp) {
+
+  osalDbgCheck((rngp != NULL) && (statsp != NULL));
+
+  osalSysLock();
+  *statsp = rngp->stats;
+  osalSysUnlock();
 }
 
 #endif /* HAL_USE_RNG */
@@ -55,6 +55,65 @@
 #define NRF5_RNG_RNG0_IRQ_PRIORITY         3
 #endif
 
+/**
+ * @brief   Entropy pool size in bytes.
+ * @details While the driver is active the RNG fills the pool from its
+ *          interrupt, requests are served from the pool and only wait
+ *          when it runs dry.
+ * @note    Must be a power of two.
+ */
+#if !defined(NRF5_RNG_POOL_SIZE) || defined(__DOXYGEN__)
+#define NRF5_RNG_POOL_SIZE                 64
+#endif
+
+/**
+ * @brief   Enables the ChaCha20 DRBG stage.
+ * @details Output is the keystream of a ChaCha20 key seeded from the pool,
+ *          requests of any size return without waiting once the first
+ *          seed is collected. The key is replaced after each request.
+ * @note    Only the key update runs under the system lock, the keystream,
+ *          about 20 cycles per byte, is generated with the lock released.
+ *          Requests with @p TIME_IMMEDIATE, possibly from an ISR, keep the
+ *          lock for the whole keystream and should stay short.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(NRF5_RNG_USE_DRBG) || defined(__DOXYGEN__)
+#define NRF5_RNG_USE_DRBG                  FALSE
+#endif
+
+/**
+ * @brief   DRBG output between reseeds from the pool, in bytes.
+ */
+#if !defined(NRF5_RNG_DRBG_RESEED_BYTES) || defined(__DOXYGEN__)
+#define NRF5_RNG_DRBG_RESEED_BYTES         4096
+#endif
+
+/**
+ * @brief   Repetition count test cutoff.
+ * @details Samples repeating the same value this many times in a row are
+ *          dropped.
+ */
+#if !defined(NRF5_RNG_RCT_CUTOFF) || defined(__DOXYGEN__)
+#define NRF5_RNG_RCT_CUTOFF                8
+#endif
+
+/**
+ * @brief   Adaptive proportion test window, in samples.
+ */
+#if !defined(NRF5_RNG_APT_WINDOW) || defined(__DOXYGEN__)
+#define NRF5_RNG_APT_WINDOW                512
+#endif
+
+/**
+ * @brief   Adaptive proportion test cutoff.
+ * @details Occurrences of the first sample of the window beyond this count
+ *          are dropped.
+ */
+#if !defined(NRF5_RNG_APT_CUTOFF) || defined(__DOXYGEN__)
+#define NRF5_RNG_APT_CUTOFF                20
+#endif
+/** @} */
+
 
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
@@ -69,6 +128,16 @@
 #error "Invalid IRQ priority assigned to RNG0"
 #endif
 
+#if (NRF5_RNG_POOL_SIZE < 32) ||                                    \
+    ((NRF5_RNG_POOL_SIZE & (NRF5_RNG_POOL_SIZE - 1)) != 0)
+#error "NRF5_RNG_POOL_SIZE must be a power of two not less than 32"
+#endif
+
+#if (NRF5_RNG_APT_CUTOFF < 2) ||                                    \
+    (NRF5_RNG_APT_CUTOFF > NRF5_RNG_APT_WINDOW)
+#error "invalid NRF5_RNG_APT_CUTOFF value"
+#endif
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -94,10 +163,41 @@ typedef struct {
    * @note    For nRF51, on average, it take 167µs to get a byte without
    *          digitial error correction and 677µs with, but no garantee 
    *          is made on the necessary time to generate one byte.
+   * @note    The default configuration enables it.
    */
   uint8_t digital_error_correction:1;
 } RNGConfig;
 
+/**
+ * @brief   RNG statistics.
+ */
+typedef struct {
+  /**
+   * @brief Bytes read from the RNG peripheral.
+   */
+  uint32_t                  entropy_bytes;
+  /**
+   * @brief Bytes returned to the callers.
+   */
+  uint32_t                  output_bytes;
+  /**
+   * @brief Requests that waited for the pool to fill.
+   */
+  uint32_t                  waits;
+  /**
+   * @brief DRBG reseeds, the initial seed included.
+   */
+  uint32_t                  reseeds;
+  /**
+   * @brief Repetition count test failures, one per run.
+   */
+  uint32_t                  rct_failures;
+  /**
+   * @brief Adaptive proportion test failures, one per window.
+   */
+  uint32_t                  apt_failures;
+} nrf5_rng_stats_t;
+
 
 /**
  * @brief   Structure representing an RNG driver.
@@ -126,6 +226,42 @@ struct RNGDriver {
    * @brief IRQ number
    */
   uint32_t                  irq;
+  /**
+   * @brief Thread waiting for the pool to fill.
+   */
+  thread_reference_t        thread;
+  /**
+   * @brief Pool level the waiting thread needs.
+   */
+  size_t                    need;
+  /**
+   * @brief Entropy pool, @p count bytes from @p rdidx.
+   */
+  uint8_t                   pool[NRF5_RNG_POOL_SIZE];
+  size_t                    rdidx;
+  size_t                    count;
+  /**
+   * @brief Health tests state.
+   */
+  uint8_t                   rct_last;
+  uint16_t                  rct_count;
+  uint8_t                   apt_first;
+  uint16_t                  apt_count;
+  uint16_t                  apt_samples;
+#if NRF5_RNG_USE_DRBG || defined(__DOXYGEN__)
+  /**
+   * @brief DRBG key.
+   */
+  uint32_t                  drbg_key[8];
+  /**
+   * @brief DRBG output left before the next reseed, zero when due.
+   */
+  size_t                    drbg_left;
+#endif
+  /**
+   * @brief Statistics.
+   */
+  nrf5_rng_stats_t          stats;
 };
 
 /*===========================================================================*/
@@ -148,6 +284,7 @@ extern "C" {
   void rng_lld_stop(RNGDriver *rngp);
   msg_t rng_lld_write(RNGDriver *rngp, uint8_t *buf, size_t n,
                       systime_t timeout);
+  void rngNRF5GetStats(RNGDriver *rngp, nrf5_rng_stats_t *statsp);
 #ifdef __cplusplus
 }
 #endif
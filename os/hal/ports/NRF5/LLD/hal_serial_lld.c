@@ -37,6 +37,17 @@
 /* Driver local definitions.                                                 */
 /*===========================================================================*/
 
+#if (NRF5_SERIAL_USE_UARTE == TRUE) || defined(__DOXYGEN__)
+/* RXDRDY is missing from the device header, offset and interrupt bit are
+   from the nRF52832 product specification.*/
+#define UARTE_EVENTS_RXDRDY     (((volatile uint32_t *)NRF_UARTE0)[0x108U / 4U])
+#define UARTE_INTEN_RXDRDY_Msk  (1UL << 2)
+
+/* RX DMA buffer holding a position of the received stream, the buffers
+   are chained by the ENDRX_STARTRX shortcut.*/
+#define UARTE_RXBUF(pos)        (((pos) / NRF5_SERIAL_UARTE_RX_BUFSIZE) & 1U)
+#define UARTE_RXOFF(pos)        ((pos) % NRF5_SERIAL_UARTE_RX_BUFSIZE)
+#endif
 
 /*===========================================================================*/
 /* Driver exported variables.                                                */
@@ -72,6 +83,7 @@ static const SerialConfig default_config = {
  * @brief Maps a baudrate speed to a BAUDRATE register value.
  */
 
+#if NRF5_SERIAL_USE_UARTE == FALSE
 /**
  * @brief   Common UART configuration.
  *
@@ -190,12 +202,235 @@ static void notify1(io_queue_t *qp)
 }
 #endif
 
+#elif NRF5_SERIAL_USE_UART0 == TRUE /* NRF5_SERIAL_USE_UARTE == TRUE */
+/**
+ * @brief   Clears an event register.
+ */
+static inline void uarte_clear(volatile uint32_t *event) {
+
+  *event = 0;
+#if CORTEX_MODEL >= 4
+  (void)*event;
+#endif
+}
+
+/**
+ * @brief   Common UARTE configuration.
+ *
+ */
+static void configure_uarte(const SerialConfig *config)
+{
+  uint32_t speed = UARTE_BAUDRATE_BAUDRATE_Baud250000;
+
+  switch (config->speed) {
+    case 1200: speed = UARTE_BAUDRATE_BAUDRATE_Baud1200; break;
+    case 2400: speed = UARTE_BAUDRATE_BAUDRATE_Baud2400; break;
+    case 4800: speed = UARTE_BAUDRATE_BAUDRATE_Baud4800; break;
+    case 9600: speed = UARTE_BAUDRATE_BAUDRATE_Baud9600; break;
+    case 14400: speed = UARTE_BAUDRATE_BAUDRATE_Baud14400; break;
+    case 19200: speed = UARTE_BAUDRATE_BAUDRATE_Baud19200; break;
+    case 28800: speed = UARTE_BAUDRATE_BAUDRATE_Baud28800; break;
+    case 38400: speed = UARTE_BAUDRATE_BAUDRATE_Baud38400; break;
+    case 57600: speed = UARTE_BAUDRATE_BAUDRATE_Baud57600; break;
+    case 76800: speed = UARTE_BAUDRATE_BAUDRATE_Baud76800; break;
+    case 115200: speed = UARTE_BAUDRATE_BAUDRATE_Baud115200; break;
+    case 230400: speed = UARTE_BAUDRATE_BAUDRATE_Baud230400; break;
+    case 250000: speed = UARTE_BAUDRATE_BAUDRATE_Baud250000; break;
+    case 460800: speed = UARTE_BAUDRATE_BAUDRATE_Baud460800; break;
+    case 921600: speed = UARTE_BAUDRATE_BAUDRATE_Baud921600; break;
+    case 1000000: speed = UARTE_BAUDRATE_BAUDRATE_Baud1M; break;
+    default: osalDbgAssert(0, "invalid baudrate"); break;
+  };
+
+  /* Configure PINs mode */
+  if (config->tx_pad != NRF5_SERIAL_PAD_DISCONNECTED) {
+    palSetPadMode(IOPORT1, config->tx_pad, PAL_MODE_OUTPUT_PUSHPULL);
+  }
+  if (config->rx_pad != NRF5_SERIAL_PAD_DISCONNECTED) {
+    palSetPadMode(IOPORT1, config->rx_pad, PAL_MODE_INPUT);
+  }
+#if (NRF5_SERIAL_USE_HWFLOWCTRL == TRUE)
+  if (config->rts_pad != NRF5_SERIAL_PAD_DISCONNECTED) {
+    palSetPadMode(IOPORT1, config->rts_pad, PAL_MODE_OUTPUT_PUSHPULL);
+  }
+  if (config->cts_pad != NRF5_SERIAL_PAD_DISCONNECTED) {
+    palSetPadMode(IOPORT1, config->cts_pad, PAL_MODE_INPUT);
+  }
+#endif
+
+  /* Select PINs used by UARTE */
+  NRF_UARTE0->PSEL.TXD = config->tx_pad;
+  NRF_UARTE0->PSEL.RXD = config->rx_pad;
+#if (NRF5_SERIAL_USE_HWFLOWCTRL == TRUE)
+  NRF_UARTE0->PSEL.RTS = config->rts_pad;
+  NRF_UARTE0->PSEL.CTS = config->cts_pad;
+#else
+  NRF_UARTE0->PSEL.RTS = NRF5_SERIAL_PAD_DISCONNECTED;
+  NRF_UARTE0->PSEL.CTS = NRF5_SERIAL_PAD_DISCONNECTED;
+#endif
+
+  /* Set baud rate */
+  NRF_UARTE0->BAUDRATE = speed;
+
+  /* Set config */
+  NRF_UARTE0->CONFIG = (UARTE_CONFIG_PARITY_Excluded << UARTE_CONFIG_PARITY_Pos);
+
+  /* Adjust flow control */
+#if (NRF5_SERIAL_USE_HWFLOWCTRL == TRUE)
+  if ((config->rts_pad < TOTAL_GPIO_PADS) ||
+      (config->cts_pad < TOTAL_GPIO_PADS)) {
+    NRF_UARTE0->CONFIG |= UARTE_CONFIG_HWFC_Enabled << UARTE_CONFIG_HWFC_Pos;
+  }
+#endif
+
+  /* Enable UARTE and clear events */
+  NRF_UARTE0->ENABLE = UARTE_ENABLE_ENABLE_Enabled;
+  uarte_clear(&NRF_UARTE0->EVENTS_ENDRX);
+  uarte_clear(&NRF_UARTE0->EVENTS_ENDTX);
+  uarte_clear(&NRF_UARTE0->EVENTS_ERROR);
+  uarte_clear(&NRF_UARTE0->EVENTS_RXSTARTED);
+  uarte_clear(&NRF_UARTE0->EVENTS_RXTO);
+  uarte_clear(&UARTE_EVENTS_RXDRDY);
+}
+
+/**
+ * @brief   Starts counting received bytes.
+ * @details RXDRDY is routed by PPI to a TIMER in counter mode, the count
+ *          tells how far EasyDMA went into the current buffer without
+ *          stopping the reception.
+ */
+static void uarte_counter_start(void)
+{
+  NRF_TIMER_Type *tim = NRF5_SERIAL_UARTE_TIMER;
+
+  tim->TASKS_STOP = 1;
+  tim->MODE = TIMER_MODE_MODE_LowPowerCounter;
+  tim->BITMODE = TIMER_BITMODE_BITMODE_32Bit;
+  tim->TASKS_CLEAR = 1;
+  tim->TASKS_START = 1;
+
+  NRF_PPI->CH[NRF5_SERIAL_UARTE_PPI_CHANNEL].EEP = (uint32_t)&UARTE_EVENTS_RXDRDY;
+  NRF_PPI->CH[NRF5_SERIAL_UARTE_PPI_CHANNEL].TEP = (uint32_t)&tim->TASKS_COUNT;
+  NRF_PPI->CHENSET = 1UL << NRF5_SERIAL_UARTE_PPI_CHANNEL;
+}
+
+static void uarte_counter_stop(void)
+{
+  NRF_PPI->CHENCLR = 1UL << NRF5_SERIAL_UARTE_PPI_CHANNEL;
+  NRF5_SERIAL_UARTE_TIMER->TASKS_STOP = 1;
+}
+
+/**
+ * @brief   Number of bytes received since start, wraps at 2^32.
+ */
+static uint32_t uarte_received(void)
+{
+  NRF5_SERIAL_UARTE_TIMER->TASKS_CAPTURE[0] = 1;
+  return NRF5_SERIAL_UARTE_TIMER->CC[0];
+}
+
+/**
+ * @brief   Moves received bytes up to @p limit to the input queue.
+ * @note    RXDRDY may come before the byte reaches memory, @p limit must
+ *          only cover bytes of a completed buffer or bytes counted before
+ *          an idle period.
+ */
+static void uarte_rx_flush(SerialDriver *sdp, uint32_t limit)
+{
+  bool overrun = false;
+
+  if ((int32_t)(limit - sdp->rxpos) <= 0)
+    return;
+
+  if (iqIsEmptyI(&sdp->iqueue))
+    chnAddFlagsI(sdp, CHN_INPUT_AVAILABLE);
+  while (sdp->rxpos != limit) {
+    uint8_t b = sdp->rxdma[UARTE_RXBUF(sdp->rxpos)][UARTE_RXOFF(sdp->rxpos)];
+
+    if (iqPutI(&sdp->iqueue, b) < Q_OK)
+      overrun = true;
+    sdp->rxpos++;
+  }
+  if (overrun)
+    chnAddFlagsI(sdp, SD_OVERRUN_ERROR);
+}
+
+/**
+ * @brief   Idle line timer callback.
+ * @details While bytes keep coming the ones counted at the previous check
+ *          are flushed, once the line is idle for a whole period all of
+ *          them are and the timer is re-armed by the next RXDRDY.
+ */
+static void uarte_rx_idle(void *p)
+{
+  SerialDriver *sdp = (SerialDriver *)p;
+  uint32_t count;
+
+  osalSysLockFromISR();
+  count = uarte_received();
+  if (count != sdp->rxlast) {
+    uarte_rx_flush(sdp, sdp->rxlast);
+    sdp->rxlast = count;
+    chVTSetI(&sdp->rxvt, NRF5_SERIAL_UARTE_RX_IDLE, uarte_rx_idle, sdp);
+  }
+  else {
+    uarte_rx_flush(sdp, count);
+    /* A byte coming after the clear raises the event again.*/
+    uarte_clear(&UARTE_EVENTS_RXDRDY);
+    if (uarte_received() == count)
+      NRF_UARTE0->INTENSET = UARTE_INTEN_RXDRDY_Msk;
+    else
+      chVTSetI(&sdp->rxvt, NRF5_SERIAL_UARTE_RX_IDLE, uarte_rx_idle, sdp);
+  }
+  osalSysUnlockFromISR();
+}
+
+/**
+ * @brief   Starts a TX burst with as much of the output queue as fits.
+ *
+ * @return              @p false if the output queue is empty.
+ */
+static bool uarte_tx_start(SerialDriver *sdp)
+{
+  size_t n = 0;
+  msg_t b;
+
+  while ((n < NRF5_SERIAL_UARTE_TX_BUFSIZE) &&
+         ((b = oqGetI(&sdp->oqueue)) >= Q_OK)) {
+    sdp->txdma[n++] = (uint8_t)b;
+  }
+  if (n == 0)
+    return false;
+
+  NRF_UARTE0->TXD.PTR = (uint32_t)sdp->txdma;
+  NRF_UARTE0->TXD.MAXCNT = n;
+  NRF_UARTE0->TASKS_STARTTX = 1;
+  return true;
+}
+
+/**
+ * @brief   Driver output notification.
+ */
+static void notify1(io_queue_t *qp)
+{
+  SerialDriver *sdp = &SD1;
+
+  (void)qp;
+
+  if (NRF_UARTE0->PSEL.TXD == NRF5_SERIAL_PAD_DISCONNECTED)
+    return;
+
+  if (!sdp->tx_busy && uarte_tx_start(sdp))
+    sdp->tx_busy = 1;
+}
+#endif /* NRF5_SERIAL_USE_UARTE */
+
 
 /*===========================================================================*/
 /* Driver interrupt handlers.                                                */
 /*===========================================================================*/
 
-#if NRF5_SERIAL_USE_UART0 || defined(__DOXYGEN__)
+#if (NRF5_SERIAL_USE_UART0 && !NRF5_SERIAL_USE_UARTE) || defined(__DOXYGEN__)
 OSAL_IRQ_HANDLER(Vector48) {
 
   OSAL_IRQ_PROLOGUE();
@@ -257,6 +492,79 @@ OSAL_IRQ_HANDLER(Vector48) {
 }
 #endif
 
+#if NRF5_SERIAL_USE_UART0 && NRF5_SERIAL_USE_UARTE
+OSAL_IRQ_HANDLER(Vector48) {
+
+  OSAL_IRQ_PROLOGUE();
+
+  SerialDriver *sdp = &SD1;
+  uint32_t inten = NRF_UARTE0->INTEN;
+
+  /* ENDRX first, RXSTARTED of the next buffer relies on rxend.*/
+  if (NRF_UARTE0->EVENTS_ENDRX != 0) {
+    uarte_clear(&NRF_UARTE0->EVENTS_ENDRX);
+
+    osalSysLockFromISR();
+    sdp->rxend += NRF5_SERIAL_UARTE_RX_BUFSIZE;
+    uarte_rx_flush(sdp, sdp->rxend);
+    osalSysUnlockFromISR();
+  }
+
+  if (NRF_UARTE0->EVENTS_RXSTARTED != 0) {
+    uarte_clear(&NRF_UARTE0->EVENTS_RXSTARTED);
+
+    /* The shortcut starts the next buffer from the pointer latched now,
+       the one just completed has been flushed.*/
+    NRF_UARTE0->RXD.PTR = (uint32_t)sdp->rxdma[UARTE_RXBUF(sdp->rxend) ^ 1U];
+  }
+
+  if ((inten & UARTE_INTEN_RXDRDY_Msk) && (UARTE_EVENTS_RXDRDY != 0)) {
+    /* First byte after an idle period, the timer takes over.*/
+    NRF_UARTE0->INTENCLR = UARTE_INTEN_RXDRDY_Msk;
+    uarte_clear(&UARTE_EVENTS_RXDRDY);
+
+    osalSysLockFromISR();
+    sdp->rxlast = uarte_received();
+    chVTSetI(&sdp->rxvt, NRF5_SERIAL_UARTE_RX_IDLE, uarte_rx_idle, sdp);
+    osalSysUnlockFromISR();
+  }
+
+  if ((inten & UARTE_INTEN_ENDTX_Msk) && (NRF_UARTE0->EVENTS_ENDTX != 0)) {
+    uarte_clear(&NRF_UARTE0->EVENTS_ENDTX);
+
+    osalSysLockFromISR();
+    if (!uarte_tx_start(sdp)) {
+      chnAddFlagsI(sdp, CHN_OUTPUT_EMPTY | CHN_TRANSMISSION_END);
+      NRF_UARTE0->TASKS_STOPTX = 1;
+      sdp->tx_busy = 0;
+    }
+    osalSysUnlockFromISR();
+  }
+
+  if (NRF_UARTE0->EVENTS_ERROR != 0) {
+    uint32_t src = NRF_UARTE0->ERRORSRC;
+    eventflags_t sts = 0;
+
+    uarte_clear(&NRF_UARTE0->EVENTS_ERROR);
+    NRF_UARTE0->ERRORSRC = src;
+    if (src & UARTE_ERRORSRC_OVERRUN_Msk)
+      sts |= SD_OVERRUN_ERROR;
+    if (src & UARTE_ERRORSRC_PARITY_Msk)
+      sts |= SD_PARITY_ERROR;
+    if (src & UARTE_ERRORSRC_FRAMING_Msk)
+      sts |= SD_FRAMING_ERROR;
+    if (src & UARTE_ERRORSRC_BREAK_Msk)
+      sts |= SD_BREAK_DETECTED;
+
+    osalSysLockFromISR();
+    chnAddFlagsI(sdp, sts);
+    osalSysUnlockFromISR();
+  }
+
+  OSAL_IRQ_EPILOGUE();
+}
+#endif
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -270,6 +578,9 @@ void sd_lld_init(void) {
 
 #if NRF5_SERIAL_USE_UART0 == TRUE
   sdObjectInit(&SD1, NULL, notify1);
+#if NRF5_SERIAL_USE_UARTE == TRUE
+  chVTObjectInit(&SD1.rxvt);
+#endif
 #endif
 }
 
@@ -296,6 +607,33 @@ void sd_lld_start(SerialDriver *sdp, const SerialConfig *config) {
 
 #if NRF5_SERIAL_USE_UART0 == TRUE
     if (sdp == &SD1) {
+#if NRF5_SERIAL_USE_UARTE == TRUE
+      configure_uarte(config);
+
+      sdp->rxpos  = 0;
+      sdp->rxend  = 0;
+      sdp->rxlast = 0;
+      sdp->tx_busy = 0;
+
+      NRF_UARTE0->INTENCLR = (uint32_t)-1;
+      NRF_UARTE0->INTENSET = UARTE_INTENSET_ERROR_Msk;
+      if (config->rx_pad != NRF5_SERIAL_PAD_DISCONNECTED) {
+        uarte_counter_start();
+        NRF_UARTE0->SHORTS = UARTE_SHORTS_ENDRX_STARTRX_Msk;
+        NRF_UARTE0->RXD.PTR = (uint32_t)sdp->rxdma[0];
+        NRF_UARTE0->RXD.MAXCNT = NRF5_SERIAL_UARTE_RX_BUFSIZE;
+        NRF_UARTE0->INTENSET = UARTE_INTENSET_ENDRX_Msk |
+                               UARTE_INTENSET_RXSTARTED_Msk |
+                               UARTE_INTEN_RXDRDY_Msk;
+      }
+      if (config->tx_pad != NRF5_SERIAL_PAD_DISCONNECTED)
+        NRF_UARTE0->INTENSET = UARTE_INTENSET_ENDTX_Msk;
+
+      nvicEnableVector(UART0_IRQn, NRF5_SERIAL_UART0_PRIORITY);
+
+      if (config->rx_pad != NRF5_SERIAL_PAD_DISCONNECTED)
+        NRF_UARTE0->TASKS_STARTRX = 1;
+#else
       configure_uart(config);
 
       // Enable UART interrupt
@@ -310,6 +648,7 @@ void sd_lld_start(SerialDriver *sdp, const SerialConfig *config) {
 
       if (config->rx_pad != NRF5_SERIAL_PAD_DISCONNECTED)
         NRF_UART0->TASKS_STARTRX = 1;
+#endif
     }
 #endif
 
@@ -332,7 +671,26 @@ void sd_lld_stop(SerialDriver *sdp) {
 #if NRF5_SERIAL_USE_UART0 == TRUE
     if (&SD1 == sdp) {
       nvicDisableVector(UART0_IRQn);
+#if NRF5_SERIAL_USE_UARTE == TRUE
+      osalSysLock();
+      chVTResetI(&sdp->rxvt);
+      osalSysUnlock();
+
+      NRF_UARTE0->INTENCLR = (uint32_t)-1;
+      NRF_UARTE0->SHORTS = 0;
+      if (NRF_UARTE0->PSEL.RXD != NRF5_SERIAL_PAD_DISCONNECTED) {
+        /* The receiver must be stopped before disabling.*/
+        uarte_clear(&NRF_UARTE0->EVENTS_RXTO);
+        NRF_UARTE0->TASKS_STOPRX = 1;
+        while (NRF_UARTE0->EVENTS_RXTO == 0)
+          ;
+        uarte_counter_stop();
+      }
+      NRF_UARTE0->TASKS_STOPTX = 1;
+      NRF_UARTE0->ENABLE = UARTE_ENABLE_ENABLE_Disabled;
+#else
       NRF_UART0->ENABLE = UART_ENABLE_ENABLE_Disabled;
+#endif
     }
 #endif
   }
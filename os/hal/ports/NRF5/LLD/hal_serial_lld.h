@@ -65,6 +65,47 @@
 #define NRF5_SERIAL_UART0_PRIORITY        3
 #endif
 
+/**
+ * @brief   UARTE EasyDMA backend enable switch.
+ * @details If set to @p TRUE SD1 uses UARTE0 with double-buffered EasyDMA
+ *          reception and burst transmission, interrupts are raised per
+ *          buffer instead of per byte. NRF52 only.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(NRF5_SERIAL_USE_UARTE) || defined(__DOXYGEN__)
+#define NRF5_SERIAL_USE_UARTE             FALSE
+#endif
+
+/**
+ * @brief   Size of each of the two UARTE RX DMA buffers.
+ * @note    Must be a power of two, RXD.MAXCNT is 8 bits wide.
+ */
+#if !defined(NRF5_SERIAL_UARTE_RX_BUFSIZE) || defined(__DOXYGEN__)
+#define NRF5_SERIAL_UARTE_RX_BUFSIZE      64
+#endif
+
+/**
+ * @brief   Time without received bytes after which they are moved to the
+ *          input queue before the DMA buffer is full.
+ */
+#if !defined(NRF5_SERIAL_UARTE_RX_IDLE) || defined(__DOXYGEN__)
+#define NRF5_SERIAL_UARTE_RX_IDLE         OSAL_MS2I(1)
+#endif
+
+/**
+ * @brief   TIMER counting UARTE received bytes.
+ */
+#if !defined(NRF5_SERIAL_UARTE_TIMER) || defined(__DOXYGEN__)
+#define NRF5_SERIAL_UARTE_TIMER           NRF_TIMER3
+#endif
+
+/**
+ * @brief   PPI channel connecting UARTE RXDRDY to the counting TIMER.
+ */
+#if !defined(NRF5_SERIAL_UARTE_PPI_CHANNEL) || defined(__DOXYGEN__)
+#define NRF5_SERIAL_UARTE_PPI_CHANNEL     19
+#endif
+
 /* Value indicating that no pad is connected to this UART register. */
 #define  NRF5_SERIAL_PAD_DISCONNECTED 0xFFFFFFFFU
 #define  NRF5_SERIAL_INVALID_BAUDRATE 0xFFFFFFFFU
@@ -80,6 +121,27 @@
 #error "Invalid IRQ priority assigned to UART0"
 #endif
 
+#if NRF5_SERIAL_USE_UARTE && (NRF_SERIES != 52)
+#error "UARTE backend requires NRF52"
+#endif
+
+#if NRF5_SERIAL_USE_UARTE &&                                     \
+    ((NRF5_SERIAL_UARTE_RX_BUFSIZE > 128) ||                     \
+     ((NRF5_SERIAL_UARTE_RX_BUFSIZE &                            \
+       (NRF5_SERIAL_UARTE_RX_BUFSIZE - 1)) != 0))
+#error "NRF5_SERIAL_UARTE_RX_BUFSIZE must be a power of two up to 128"
+#endif
+
+/**
+ * @brief   UARTE TX DMA buffer size, the whole output queue up to the
+ *          TXD.MAXCNT limit.
+ */
+#if (SERIAL_BUFFERS_SIZE < 255) || defined(__DOXYGEN__)
+#define NRF5_SERIAL_UARTE_TX_BUFSIZE      SERIAL_BUFFERS_SIZE
+#else
+#define NRF5_SERIAL_UARTE_TX_BUFSIZE      255
+#endif
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -106,6 +168,27 @@ typedef struct {
 #endif
 } SerialConfig;
 
+#if (NRF5_SERIAL_USE_UARTE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   UARTE backend specific data.
+ */
+#define _serial_uarte_data                                                  \
+  /* RX DMA buffers, filled alternately.*/                                  \
+  uint8_t                   rxdma[2][NRF5_SERIAL_UARTE_RX_BUFSIZE];         \
+  /* TX DMA buffer.*/                                                       \
+  uint8_t                   txdma[NRF5_SERIAL_UARTE_TX_BUFSIZE];            \
+  /* Received bytes moved to the input queue.*/                             \
+  uint32_t                  rxpos;                                          \
+  /* End of the last filled RX DMA buffer, in received bytes.*/            \
+  uint32_t                  rxend;                                          \
+  /* Received bytes count at the last idle check.*/                         \
+  uint32_t                  rxlast;                                         \
+  /* Idle line timer.*/                                                     \
+  virtual_timer_t           rxvt;
+#else
+#define _serial_uarte_data
+#endif
+
 /**
  * @brief   @p SerialDriver specific data.
  */
@@ -124,7 +207,8 @@ typedef struct {
   /* 1 if port is busy transmitting, 0 otherwise. */                        \
   uint8_t                   tx_busy;                                        \
   /* End of the mandatory fields.*/                                         \
-  thread_t                  *thread;
+  thread_t                  *thread;                                        \
+  _serial_uarte_data
 
 /*===========================================================================*/
 /* Driver macros.                                                            */
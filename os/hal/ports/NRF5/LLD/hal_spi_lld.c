@@ -26,6 +26,11 @@
 
 #if HAL_USE_SPI || defined(__DOXYGEN__)
 
+#if NRF_SERIES == 52
+#define SPI0_TWI0_IRQn SPIM0_SPIS0_TWIM0_TWIS0_SPI0_TWI0_IRQn
+#define SPI1_TWI1_IRQn SPIM1_SPIS1_TWIM1_TWIS1_SPI1_TWI1_IRQn
+#endif
+
 /*===========================================================================*/
 /* Driver exported variables.                                                */
 /*===========================================================================*/
@@ -44,10 +49,197 @@ SPIDriver SPID2;
 /* Driver local variables and types.                                         */
 /*===========================================================================*/
 
+#if NRF5_SPI_USE_DMA || defined(__DOXYGEN__)
+/**
+ * @brief   Sink for the bytes received by @p spi_lld_ignore().
+ * @note    Shared by all the drivers, its content is never read.
+ */
+static uint8_t dma_dummy[NRF5_SPI_DMA_MAXCNT];
+
+/**
+ * @brief   Buffer reachable by EasyDMA, which only sees the data RAM.
+ */
+#define DMA_BUFFER_IS_RAM(p)                                                \
+  (((uint32_t)(p) & 0xE0000000U) == 0x20000000U)
+
+/**
+ * @brief   Legacy SPI view of the SPIM instance, both share the registers.
+ */
+#define LEGACY_PORT(spip)           ((NRF_SPI_Type *)(spip)->port)
+#endif
+
 /*===========================================================================*/
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+#if NRF5_SPI_USE_DMA || defined(__DOXYGEN__)
+/**
+ * @brief   Switches the instance between SPIM and legacy SPI.
+ * @details Single byte SPIM transactions clock out an extra byte on
+ *          NRF52832 (anomaly 58), such transfers go through the legacy
+ *          SPI peripheral sharing the instance.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[in] legacy    @p true selects the legacy SPI
+ */
+static void legacy_switch(SPIDriver *spip, bool legacy) {
+
+  spip->port->ENABLE = (SPIM_ENABLE_ENABLE_Disabled << SPIM_ENABLE_ENABLE_Pos);
+  spip->port->ENABLE = legacy ?
+    (SPI_ENABLE_ENABLE_Enabled << SPI_ENABLE_ENABLE_Pos) :
+    (SPIM_ENABLE_ENABLE_Enabled << SPIM_ENABLE_ENABLE_Pos);
+}
+
+/**
+ * @brief   Starts a single byte transfer in legacy SPI mode.
+ * @details The interrupt handler switches back to SPIM on @p READY.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[in] txbuf     the pointer to the transmit buffer or @p NULL
+ * @param[out] rxbuf    the pointer to the receive buffer or @p NULL
+ */
+static void legacy_start(SPIDriver *spip, const void *txbuf, void *rxbuf) {
+  NRF_SPI_Type *port = LEGACY_PORT(spip);
+
+  spip->txptr = txbuf;
+  spip->rxptr = rxbuf;
+  spip->txcnt = 0;
+  spip->rxcnt = 1;
+  legacy_switch(spip, true);
+  port->EVENTS_READY = 0;
+#if CORTEX_MODEL >= 4
+  (void)port->EVENTS_READY;
+#endif
+  port->INTENSET = (SPI_INTENSET_READY_Enabled << SPI_INTENSET_READY_Pos);
+  port->TXD = (txbuf != NULL) ? *(const uint8_t *)txbuf : 0xFF;
+}
+
+/**
+ * @brief   Ends the single byte transfer started by @p legacy_start().
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ */
+static void legacy_end(SPIDriver *spip) {
+  NRF_SPI_Type *port = LEGACY_PORT(spip);
+  uint8_t rx;
+
+  port->EVENTS_READY = 0;
+#if CORTEX_MODEL >= 4
+  (void)port->EVENTS_READY;
+#endif
+  rx = (uint8_t)port->RXD;
+  if (spip->rxptr != NULL)
+    *(uint8_t *)spip->rxptr = rx;
+  port->INTENCLR = (SPI_INTENCLR_READY_Clear << SPI_INTENCLR_READY_Pos);
+  legacy_switch(spip, false);
+  spip->rxcnt = 0;
+}
+
+/**
+ * @brief   Hands the next chunk of the transfer to EasyDMA.
+ * @details Buffers are in array list mode, EasyDMA advances the pointers by
+ *          MAXCNT after each transaction and only the counts are set here.
+ *          A chunk leaving a single byte behind is shortened by one, so no
+ *          chunk is ever a single byte (anomaly 58).
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ */
+static void dma_next(SPIDriver *spip) {
+  NRF_SPIM_Type *port = spip->port;
+  size_t n = spip->txcnt;
+
+  if (n > NRF5_SPI_DMA_MAXCNT) {
+    n = NRF5_SPI_DMA_MAXCNT;
+    if (spip->txcnt - n == 1U)
+      n--;
+  }
+  osalDbgAssert(n > 1U, "single byte EasyDMA transaction");
+  port->TXD.MAXCNT = (spip->txptr != NULL) ? n : 0;
+  port->RXD.MAXCNT = (spip->rxptr != NULL) ? n : 0;
+  spip->txcnt -= n;
+  port->TASKS_START = 1;
+}
+
+/**
+ * @brief   Starts an EasyDMA transfer.
+ * @details A @p NULL transmit buffer clocks out the ORC character, a
+ *          @p NULL receive buffer drops the received bytes. The ignore sink
+ *          is not in list mode so every chunk lands on it again. Single
+ *          bytes go through the legacy SPI, see @p legacy_switch().
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ * @param[in] n         number of bytes to be exchanged
+ * @param[in] txbuf     the pointer to the transmit buffer or @p NULL
+ * @param[out] rxbuf    the pointer to the receive buffer or @p NULL
+ */
+static void dma_start(SPIDriver *spip, size_t n,
+                      const void *txbuf, void *rxbuf) {
+  NRF_SPIM_Type *port = spip->port;
+
+  if (n == 1U) {
+    legacy_start(spip, txbuf, rxbuf);
+    return;
+  }
+
+  osalDbgAssert((txbuf == NULL) || DMA_BUFFER_IS_RAM(txbuf),
+                "transmit buffer not in RAM");
+  osalDbgAssert((rxbuf == NULL) || DMA_BUFFER_IS_RAM(rxbuf),
+                "receive buffer not in RAM");
+
+  spip->txptr = txbuf;
+  spip->rxptr = rxbuf;
+  spip->rxcnt = spip->txcnt = n;
+  port->TXD.PTR = (uint32_t)txbuf;
+  port->TXD.LIST = (txbuf != NULL) ?
+    (SPIM_TXD_LIST_LIST_ArrayList << SPIM_TXD_LIST_LIST_Pos) :
+    (SPIM_TXD_LIST_LIST_Disabled << SPIM_TXD_LIST_LIST_Pos);
+  port->RXD.PTR = (uint32_t)rxbuf;
+  port->RXD.LIST = ((rxbuf != NULL) && (rxbuf != dma_dummy)) ?
+    (SPIM_RXD_LIST_LIST_ArrayList << SPIM_RXD_LIST_LIST_Pos) :
+    (SPIM_RXD_LIST_LIST_Disabled << SPIM_RXD_LIST_LIST_Pos);
+  port->EVENTS_END = 0;
+#if CORTEX_MODEL >= 4
+  (void)port->EVENTS_END;
+#endif
+  port->INTENSET = (SPIM_INTENSET_END_Enabled << SPIM_INTENSET_END_Pos);
+  dma_next(spip);
+}
+
+#if defined(__GNUC__)
+__attribute__((noinline))
+#endif
+/**
+ * @brief   Common IRQ handler.
+ *
+ * @param[in] spip      pointer to the @p SPIDriver object
+ */
+static void serve_interrupt(SPIDriver *spip) {
+  NRF_SPIM_Type *port = spip->port;
+
+  if (port->ENABLE == (SPI_ENABLE_ENABLE_Enabled << SPI_ENABLE_ENABLE_Pos)) {
+    legacy_end(spip);
+    _spi_isr_code(spip);
+    return;
+  }
+
+  // Clear SPIM END event flag
+  port->EVENTS_END = 0;
+#if CORTEX_MODEL >= 4
+  (void)port->EVENTS_END;
+#endif
+
+  if (spip->txcnt > 0) {
+    dma_next(spip);
+    return;
+  }
+  port->INTENCLR = (SPIM_INTENCLR_END_Clear << SPIM_INTENCLR_END_Pos);
+  spip->rxcnt = 0;
+  /* Portable SPI ISR code defined in the high level driver, note, it is
+     a macro.*/
+  _spi_isr_code(spip);
+}
+
+#else /* !NRF5_SPI_USE_DMA */
 /**
  * @brief   Preloads the transmit FIFO.
  *
@@ -105,6 +297,7 @@ static void serve_interrupt(SPIDriver *spip) {
     _spi_isr_code(spip);
   }
 }
+#endif /* !NRF5_SPI_USE_DMA */
 
 /*===========================================================================*/
 /* Driver interrupt handlers.                                                */
@@ -150,12 +343,20 @@ void spi_lld_init(void) {
 
 #if NRF5_SPI_USE_SPI0
   spiObjectInit(&SPID1);
+#if NRF5_SPI_USE_DMA
+  SPID1.port = NRF_SPIM0;
+#else
   SPID1.port = NRF_SPI0;
 #endif
+#endif
 #if NRF5_SPI_USE_SPI1
   spiObjectInit(&SPID2);
+#if NRF5_SPI_USE_DMA
+  SPID2.port = NRF_SPIM1;
+#else
   SPID2.port = NRF_SPI1;
 #endif
+#endif
 }
 
 /**
@@ -214,6 +415,16 @@ void spi_lld_start(SPIDriver *spip) {
   spip->port->PSEL.MISO = spip->config->misopad;
 #endif
   spip->port->FREQUENCY = spip->config->freq;
+#if NRF5_SPI_USE_DMA
+  spip->port->ORC = 0xFF;
+  spip->port->ENABLE = (SPIM_ENABLE_ENABLE_Enabled << SPIM_ENABLE_ENABLE_Pos);
+
+  /* clear events flag */
+  spip->port->EVENTS_END = 0;
+#if CORTEX_MODEL >= 4
+  (void)spip->port->EVENTS_END;
+#endif
+#else
   spip->port->ENABLE = (SPI_ENABLE_ENABLE_Enabled << SPI_ENABLE_ENABLE_Pos);
 
   /* clear events flag */
@@ -221,6 +432,7 @@ void spi_lld_start(SPIDriver *spip) {
 #if CORTEX_MODEL >= 4
   (void)spip->port->EVENTS_READY;
 #endif
+#endif
 }
 
 /**
@@ -234,7 +446,11 @@ void spi_lld_stop(SPIDriver *spip) {
 
   if (spip->state != SPI_STOP) {
     spip->port->ENABLE  = (SPI_ENABLE_ENABLE_Disabled << SPI_ENABLE_ENABLE_Pos);
+#if NRF5_SPI_USE_DMA
+    spip->port->INTENCLR = (SPIM_INTENCLR_END_Clear << SPIM_INTENCLR_END_Pos);
+#else
     spip->port->INTENCLR = (SPI_INTENCLR_READY_Clear << SPI_INTENCLR_READY_Pos);
+#endif
 #if NRF5_SPI_USE_SPI0
     if (&SPID1 == spip)
       nvicDisableVector(SPI0_TWI0_IRQn);
@@ -284,11 +500,15 @@ void spi_lld_unselect(SPIDriver *spip) {
  */
 void spi_lld_ignore(SPIDriver *spip, size_t n) {
 
+#if NRF5_SPI_USE_DMA
+  dma_start(spip, n, NULL, dma_dummy);
+#else
   spip->rxptr = NULL;
   spip->txptr = NULL;
   spip->rxcnt = spip->txcnt = n;
   port_fifo_preload(spip);
   spip->port->INTENSET = (SPI_INTENCLR_READY_Enabled << SPI_INTENCLR_READY_Pos);
+#endif
 }
 
 /**
@@ -309,11 +529,15 @@ void spi_lld_ignore(SPIDriver *spip, size_t n) {
 void spi_lld_exchange(SPIDriver *spip, size_t n,
                       const void *txbuf, void *rxbuf) {
 
+#if NRF5_SPI_USE_DMA
+  dma_start(spip, n, txbuf, rxbuf);
+#else
   spip->rxptr = rxbuf;
   spip->txptr = txbuf;
   spip->rxcnt = spip->txcnt = n;
   port_fifo_preload(spip);
   spip->port->INTENSET = (SPI_INTENCLR_READY_Enabled << SPI_INTENCLR_READY_Pos);
+#endif
 }
 
 /**
@@ -331,11 +555,15 @@ void spi_lld_exchange(SPIDriver *spip, size_t n,
  */
 void spi_lld_send(SPIDriver *spip, size_t n, const void *txbuf) {
 
+#if NRF5_SPI_USE_DMA
+  dma_start(spip, n, txbuf, NULL);
+#else
   spip->rxptr = NULL;
   spip->txptr = txbuf;
   spip->rxcnt = spip->txcnt = n;
   port_fifo_preload(spip);
   spip->port->INTENSET = (SPI_INTENCLR_READY_Enabled << SPI_INTENCLR_READY_Pos);
+#endif
 }
 
 /**
@@ -353,11 +581,15 @@ void spi_lld_send(SPIDriver *spip, size_t n, const void *txbuf) {
  */
 void spi_lld_receive(SPIDriver *spip, size_t n, void *rxbuf) {
 
+#if NRF5_SPI_USE_DMA
+  dma_start(spip, n, NULL, rxbuf);
+#else
   spip->rxptr = rxbuf;
   spip->txptr = NULL;
   spip->rxcnt = spip->txcnt = n;
   port_fifo_preload(spip);
   spip->port->INTENSET = (SPI_INTENCLR_READY_Enabled << SPI_INTENCLR_READY_Pos);
+#endif
 }
 
 /**
@@ -373,6 +605,24 @@ void spi_lld_receive(SPIDriver *spip, size_t n, void *rxbuf) {
  * @return              The received data frame from the SPI bus.
  */
 uint16_t spi_lld_polled_exchange(SPIDriver *spip, uint16_t frame) {
+#if NRF5_SPI_USE_DMA
+  NRF_SPI_Type *port = LEGACY_PORT(spip);
+  uint8_t rxfrm;
+
+  /* Single byte, done by the legacy SPI because of anomaly 58.*/
+  legacy_switch(spip, true);
+  port->EVENTS_READY = 0;
+  port->TXD = (uint8_t)frame;
+  while (port->EVENTS_READY == 0)
+    ;
+  port->EVENTS_READY = 0;
+#if CORTEX_MODEL >= 4
+  (void)port->EVENTS_READY;
+#endif
+  rxfrm = (uint8_t)port->RXD;
+  legacy_switch(spip, false);
+  return rxfrm;
+#else
 
   spip->port->TXD = (uint8_t)frame;
   while (spip->port->EVENTS_READY == 0)
@@ -382,6 +632,7 @@ uint16_t spi_lld_polled_exchange(SPIDriver *spip, uint16_t frame) {
   (void)spip->port->EVENTS_READY;
 #endif
   return spip->port->RXD;
+#endif
 }
 
 #endif /* HAL_USE_SPI */
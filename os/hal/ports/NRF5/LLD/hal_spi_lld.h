@@ -57,6 +57,22 @@
 #define NRF5_SPI_SPI_ERROR_HOOK()    chSysHalt()
 #endif
 
+/**
+ * @brief   Use the SPIM peripheral with EasyDMA.
+ * @details Transfers are moved by EasyDMA in chunks of up to
+ *          @p NRF5_SPI_DMA_MAXCNT bytes, one interrupt per chunk instead
+ *          of one per byte. NRF52 only.
+ * @note    EasyDMA can only access RAM, transmit buffers in flash are not
+ *          allowed.
+ * @note    NRF52832 clocks out an extra byte on single byte SPIM
+ *          transactions (anomaly 58), one byte transfers and the polled
+ *          exchange switch the instance to the legacy SPI peripheral.
+ * @note    The default is @p FALSE.
+ */
+#if !defined(NRF5_SPI_USE_DMA) || defined(__DOXYGEN__)
+#define NRF5_SPI_USE_DMA             FALSE
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -75,6 +91,18 @@
 #error "Invalid IRQ priority assigned to SPI1"
 #endif
 
+#if NRF5_SPI_USE_DMA && (NRF_SERIES != 52)
+#error "SPIM EasyDMA requires NRF52"
+#endif
+
+#if NRF5_SPI_USE_DMA || defined(__DOXYGEN__)
+/**
+ * @brief   Largest EasyDMA transaction, bytes.
+ */
+#define NRF5_SPI_DMA_MAXCNT                                                 \
+  (SPIM_TXD_MAXCNT_MAXCNT_Msk >> SPIM_TXD_MAXCNT_MAXCNT_Pos)
+#endif
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -176,10 +204,17 @@ struct SPIDriver {
   SPI_DRIVER_EXT_FIELDS
 #endif
   /* End of the mandatory fields.*/
+#if NRF5_SPI_USE_DMA || defined(__DOXYGEN__)
+  /**
+   * @brief Pointer to the SPIM port.
+   */
+  NRF_SPIM_Type         *port;
+#else
   /**
    * @brief Pointer to the SPI port.
    */
   NRF_SPI_Type          *port;
+#endif
   /**
    * @brief Number of bytes yet to be received.
    */
@@ -190,6 +225,8 @@ struct SPIDriver {
   void                  *rxptr;
   /**
    * @brief Number of bytes yet to be transmitted.
+   * @note  With EasyDMA, bytes of the transfer not yet handed to a
+   *        transaction.
    */
   uint32_t              txcnt;
   /**
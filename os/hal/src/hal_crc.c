@@ -37,6 +37,58 @@
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+/**
+ * @brief   Reverses bit order of the value.
+ *
+ * @param[in] data      value to be reflected
+ * @param[in] bits      number of bits
+ */
+static uint32_t combine_reflect(uint32_t data, uint32_t bits) {
+  uint32_t reflection = 0;
+  uint32_t bit;
+
+  for (bit = 0; bit < bits; bit++) {
+    reflection = (reflection << 1) | (data & 1U);
+    data >>= 1;
+  }
+
+  return reflection;
+}
+
+/**
+ * @brief   Multiplies GF(2) matrix by vector.
+ *
+ * @param[in] mat       matrix columns
+ * @param[in] vec       vector
+ */
+static uint32_t gf2_matrix_times(const uint32_t *mat, uint32_t vec) {
+  uint32_t sum = 0;
+
+  while (vec != 0U) {
+    if ((vec & 1U) != 0U)
+      sum ^= *mat;
+    vec >>= 1;
+    mat++;
+  }
+
+  return sum;
+}
+
+/**
+ * @brief   Squares GF(2) matrix.
+ *
+ * @param[out] square   result matrix columns
+ * @param[in] mat       matrix columns
+ * @param[in] size      matrix dimension
+ */
+static void gf2_matrix_square(uint32_t *square, const uint32_t *mat,
+                              uint32_t size) {
+  uint32_t n;
+
+  for (n = 0; n < size; n++)
+    square[n] = gf2_matrix_times(mat, mat[n]);
+}
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -227,6 +279,91 @@ void crcStartCalcI(CRCDriver *crcp, size_t n, const void *buf) {
 }
 #endif
 
+/**
+ * @brief   Combines CRCs of two consecutive blocks.
+ * @details Given the CRC of block A and the CRC of block B, both computed
+ *          from reset with the current configuration, returns the CRC of
+ *          A followed by B. Only the length of B is needed, so pieces can
+ *          be processed independently and in any order, then merged.
+ *          The cost is O(log(len2)) GF(2) matrix squarings.
+ * @pre     Configuration must have @p reflect_data equal to
+ *          @p reflect_remainder.
+ *
+ * @param[in] crcp      pointer to the @p CRCDriver object
+ * @param[in] crc1      CRC of the first block
+ * @param[in] crc2      CRC of the second block
+ * @param[in] len2      length of the second block in bytes
+ *
+ * @return              CRC of the concatenated blocks.
+ *
+ * @api
+ */
+uint32_t crcCombine(CRCDriver *crcp, uint32_t crc1, uint32_t crc2,
+                    size_t len2) {
+  const CRCConfig *config;
+  uint32_t even[32];    /* Even power of two zeros operator.*/
+  uint32_t odd[32];     /* Odd power of two zeros operator.*/
+  uint32_t size;
+  uint32_t mask;
+  uint32_t init;
+  uint32_t n;
+
+  osalDbgCheck(crcp != NULL);
+  config = crcp->config;
+  osalDbgCheck(config != NULL);
+  osalDbgAssert(config->reflect_data == config->reflect_remainder,
+                "unsupported configuration");
+
+  if (len2 == 0U)
+    return crc1;
+
+  size = config->poly_size;
+  mask = 1U << (size - 1U);
+  mask |= (mask - 1U);
+
+  /* Initial value as seen in the output bit order.*/
+  init = config->initial_val;
+  if (config->reflect_data)
+    init = combine_reflect(init, size);
+
+  /* Removing final XOR and initial value contributions from the first
+     CRC leaves the part that must be advanced over len2 zero bytes.*/
+  crc1 = (crc1 ^ config->final_val ^ init) & mask;
+
+  /* Operator for one zero bit.*/
+  if (config->reflect_data) {
+    odd[0] = combine_reflect(config->poly, size);
+    for (n = 1; n < size; n++)
+      odd[n] = 1U << (n - 1U);
+  }
+  else {
+    for (n = 0; n < size - 1U; n++)
+      odd[n] = 1U << (n + 1U);
+    odd[size - 1U] = config->poly & mask;
+  }
+
+  gf2_matrix_square(even, odd, size);   /* Two zero bits.*/
+  gf2_matrix_square(odd, even, size);   /* Four zero bits.*/
+
+  /* Applying len2 zero bytes to crc1, first square puts operator for one
+     zero byte in even.*/
+  do {
+    gf2_matrix_square(even, odd, size);
+    if ((len2 & 1U) != 0U)
+      crc1 = gf2_matrix_times(even, crc1);
+    len2 >>= 1;
+    if (len2 == 0U)
+      break;
+
+    gf2_matrix_square(odd, even, size);
+    if ((len2 & 1U) != 0U)
+      crc1 = gf2_matrix_times(odd, crc1);
+    len2 >>= 1;
+  } while (len2 != 0U);
+
+  return (crc1 ^ crc2) & mask;
+}
+
 #if (CRC_USE_MUTUAL_EXCLUSION == TRUE) || defined(__DOXYGEN__)
 /**
  * @brief   Gains exclusive access to the CRC unit.
@@ -108,6 +108,36 @@ static systime_t calc_timeout(I2CDriver *i2cp, size_t txbytes, size_t rxbytes) {
   return TIME_MS2I(tmo);
 }
 
+/**
+ * @brief   Performs one bus transaction with IC.
+ * @details Transaction is queued when IC has a queue client, otherwise
+ *          the bus is locked for it.
+ */
+static msg_t eeprom_transmit(const I2CEepromFileConfig *eepcfg,
+                             const uint8_t *txbuf, size_t txbytes,
+                             uint8_t *rxbuf, size_t rxbytes, systime_t tmo) {
+  msg_t status;
+
+#if EE24XX_USE_I2CQ
+  if (NULL != eepcfg->client)
+    return i2cqMasterTransmitTimeout(eepcfg->client, eepcfg->addr,
+                                     txbuf, txbytes, rxbuf, rxbytes, tmo);
+#endif
+
+#if I2C_USE_MUTUAL_EXCLUSION
+  i2cAcquireBus(eepcfg->i2cp);
+#endif
+
+  status = i2cMasterTransmitTimeout(eepcfg->i2cp, eepcfg->addr,
+                                    txbuf, txbytes, rxbuf, rxbytes, tmo);
+
+#if I2C_USE_MUTUAL_EXCLUSION
+  i2cReleaseBus(eepcfg->i2cp);
+#endif
+
+  return status;
+}
+
 /**
  * @brief   EEPROM read routine.
  *
@@ -127,16 +157,7 @@ static msg_t eeprom_read(const I2CEepromFileConfig *eepcfg,
 
   eeprom_split_addr(eepcfg->write_buf, (offset + eepcfg->barrier_low));
 
-#if I2C_USE_MUTUAL_EXCLUSION
-  i2cAcquireBus(eepcfg->i2cp);
-#endif
-
-  status = i2cMasterTransmitTimeout(eepcfg->i2cp, eepcfg->addr,
-                                    eepcfg->write_buf, 2, data, len, tmo);
-
-#if I2C_USE_MUTUAL_EXCLUSION
-  i2cReleaseBus(eepcfg->i2cp);
-#endif
+  status = eeprom_transmit(eepcfg, eepcfg->write_buf, 2, data, len, tmo);
 
   return status;
 }
@@ -167,16 +188,7 @@ static msg_t eeprom_write(const I2CEepromFileConfig *eepcfg, uint32_t offset,
   /* write data bytes */
   memcpy(&(eepcfg->write_buf[2]), data, len);
 
-#if I2C_USE_MUTUAL_EXCLUSION
-  i2cAcquireBus(eepcfg->i2cp);
-#endif
-
-  status = i2cMasterTransmitTimeout(eepcfg->i2cp, eepcfg->addr,
-                                    eepcfg->write_buf, (len + 2), NULL, 0, tmo);
-
-#if I2C_USE_MUTUAL_EXCLUSION
-  i2cReleaseBus(eepcfg->i2cp);
-#endif
+  status = eeprom_transmit(eepcfg, eepcfg->write_buf, (len + 2), NULL, 0, tmo);
 
   /* wait until EEPROM process data */
   chThdSleep(eepcfg->write_time);
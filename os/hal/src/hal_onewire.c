@@ -34,6 +34,24 @@
 
 For data write it is only master channel needed. Data bit width updates
 on every timer overflow event.
+
+UART mode (ONEWIRE_USE_UART):
+
+Every bus bit is represented by single UART byte, TX and RX joined to bus.
+At 115200 start bit is 8.7 uS long so 0xFF generates 'write 1' or 'read'
+slot, 0x00 keeps bus low for 78 uS and generates 'write 0' slot. Slave
+answering 0 in read slot stretches low level, so anything except 0xFF
+received back means 0. Reset pulse is 0xF0 sent at 9600, presence pulse
+corrupts upper bits of the echo.
+
+      start  b0  ..  b7  stop
+-      ----------------------- 0xFF
+ |    |
+  ----   <-------------------- slave (not)pulls down bus here
+
+Whole transaction is moved by DMA and only the receive end interrupt is
+used. Search ROM needs the decision about direction bit between slots,
+so it costs one interrupt per ROM bit (instead of three).
 */
 
 /*===========================================================================*/
@@ -63,6 +81,15 @@ on every timer overflow event.
 /*===========================================================================*/
 /* Driver local definitions.                                                 */
 /*===========================================================================*/
+/**
+ * @brief     Low level driver generating time slots for given 1-wire driver.
+ */
+#if ONEWIRE_USE_UART
+#define ow_lld_driver(owp)            ((const void *)(owp)->config->uartd)
+#else
+#define ow_lld_driver(owp)            ((const void *)(owp)->config->pwmd)
+#endif
+
 /**
  * @brief     1MHz clock for PWM driver.
  */
@@ -84,6 +111,9 @@ on every timer overflow event.
 /**
  * @brief     Local function declarations.
  */
+#if ONEWIRE_USE_UART
+static void uart_rxend_cb(UARTDriver *uartp);
+#else
 static void ow_reset_cb(PWMDriver *pwmp, onewireDriver *owp);
 static void pwm_reset_cb(PWMDriver *pwmp);
 static void ow_read_bit_cb(PWMDriver *pwmp, onewireDriver *owp);
@@ -94,18 +124,28 @@ static void pwm_write_bit_cb(PWMDriver *pwmp);
 static void ow_search_rom_cb(PWMDriver *pwmp, onewireDriver *owp);
 static void pwm_search_rom_cb(PWMDriver *pwmp);
 #endif
+#endif /* ONEWIRE_USE_UART */
 
 /*===========================================================================*/
 /* Driver exported variables.                                                */
 /*===========================================================================*/
 /**
  * @brief 1-wire driver identifier.
+ * @note  It is just preallocated object for single bus applications,
+ *        any number of @p onewireDriver objects up to
+ *        @p ONEWIRE_MAX_BUSES may be started simultaneously.
  */
 onewireDriver OWD1;
 
 /*===========================================================================*/
 /* Driver local variables and types.                                         */
 /*===========================================================================*/
+/**
+ * @brief     Started drivers. Used by ISR callbacks to find 1-wire driver
+ *            owning PWM (or UART) driver.
+ */
+static onewireDriver *ow_drivers[ONEWIRE_MAX_BUSES];
+
 /**
  * @brief     Look up table for fast 1-wire CRC calculation
  */
@@ -147,6 +187,27 @@ static const uint8_t onewire_crc_table[256] = {
 /*===========================================================================*/
 /* Driver local functions.                                                   */
 /*===========================================================================*/
+/**
+ * @brief     Find started 1-wire driver by its low level driver.
+ * @note      It must be callable from any context.
+ *
+ * @param[in] lld       pointer to the @p PWMDriver or @p UARTDriver object
+ *
+ * @return              Pointer to the @p onewireDriver object.
+ */
+static onewireDriver *ow_lookup(const void *lld) {
+  size_t i;
+
+  for (i = 0; i < ONEWIRE_MAX_BUSES; i++) {
+    if ((NULL != ow_drivers[i]) && (lld == ow_lld_driver(ow_drivers[i])))
+      return ow_drivers[i];
+  }
+
+  osalSysHalt("Unregistered driver");
+  return NULL; /* warning supressor */
+}
+
+#if !ONEWIRE_USE_UART
 /**
  * @brief     Put bus in idle mode.
  */
@@ -186,21 +247,21 @@ static ioline_t ow_read_bit(onewireDriver *owp) {
  * @brief     PWM adapter
  */
 static void pwm_reset_cb(PWMDriver *pwmp) {
-  ow_reset_cb(pwmp, &OWD1);
+  ow_reset_cb(pwmp, ow_lookup(pwmp));
 }
 
 /**
  * @brief     PWM adapter
  */
 static void pwm_read_bit_cb(PWMDriver *pwmp) {
-  ow_read_bit_cb(pwmp, &OWD1);
+  ow_read_bit_cb(pwmp, ow_lookup(pwmp));
 }
 
 /**
  * @brief     PWM adapter
  */
 static void pwm_write_bit_cb(PWMDriver *pwmp) {
-  ow_write_bit_cb(pwmp, &OWD1);
+  ow_write_bit_cb(pwmp, ow_lookup(pwmp));
 }
 
 #if ONEWIRE_USE_SEARCH_ROM
@@ -208,7 +269,7 @@ static void pwm_write_bit_cb(PWMDriver *pwmp) {
  * @brief     PWM adapter
  */
 static void pwm_search_rom_cb(PWMDriver *pwmp) {
-  ow_search_rom_cb(pwmp, &OWD1);
+  ow_search_rom_cb(pwmp, ow_lookup(pwmp));
 }
 #endif /* ONEWIRE_USE_SEARCH_ROM */
 
@@ -340,6 +401,7 @@ static void ow_write_bit_cb(PWMDriver *pwmp, onewireDriver *owp) {
   ow_write_bit_I(owp, (*owp->buf >> owp->reg.bit) & 1);
   owp->reg.bit++;
 }
+#endif /* !ONEWIRE_USE_UART */
 
 #if ONEWIRE_USE_SEARCH_ROM
 /**
@@ -379,6 +441,9 @@ static uint8_t extract_path_bit(const uint8_t *path, size_t bit) {
 static uint8_t collision_handler(onewire_search_rom_t *sr) {
 
   uint8_t bit;
+  size_t rb = sr->reg.rombit;
+
+  sr->collisions[rb / CHAR_BIT] |= 1U << (rb % CHAR_BIT);
 
   switch(sr->reg.search_iter) {
   case ONEWIRE_SEARCH_ROM_NEXT:
@@ -422,6 +487,7 @@ static uint8_t collision_handler(onewire_search_rom_t *sr) {
   }
 }
 
+#if !ONEWIRE_USE_UART
 /**
  * @brief     1-wire search ROM callback.
  * @note      Must be called from PWM's ISR.
@@ -495,6 +561,7 @@ THE_END:
   osalSysUnlockFromISR();
 #endif
 }
+#endif /* !ONEWIRE_USE_UART */
 
 /**
  * @brief       Helper function. Initialize structures required by 'search ROM'.
@@ -529,6 +596,429 @@ static void search_clean_iteration(onewire_search_rom_t *sr) {
   sr->reg.bit_step = 0;
   sr->reg.bit_buf = 0;
   sr->reg.result = ONEWIRE_SEARCH_ROM_LAST;
+  memset(sr->collisions, 0, 8);
+}
+
+/**
+ * @brief       Helper function. Initialize structures required by targeted
+ *              'search ROM'.
+ * @details     First iteration follows @p path on every collision and
+ *              discovers the lowest ROM not less than @p path. Following
+ *              iterations continue as usual search does.
+ *
+ * @param[in] sr        pointer to the @p onewire_search_rom_t helper structure
+ * @param[in] path      ROM to start from
+ */
+static void search_target_start(onewire_search_rom_t *sr,
+                                const uint8_t *path) {
+
+  search_clean_start(sr);
+  sr->reg.search_iter = ONEWIRE_SEARCH_ROM_NEXT;
+  memcpy(sr->prev_path, path, 8);
+  /* Branch behind the last ROM bit, it is replaced by the deepest
+     zero turn after the first iteration.*/
+  sr->last_zero_branch = 64;
+}
+
+/**
+ * @brief       Compare leading bits of two ROMs.
+ *
+ * @param[in] a         pointer to the first ROM
+ * @param[in] b         pointer to the second ROM
+ * @param[in] bits      number of bits to compare
+ */
+static bool prefix_match(const uint8_t *a, const uint8_t *b, size_t bits) {
+  size_t i;
+
+  for (i = 0; i < bits; i++) {
+    if (extract_path_bit(a, i) != extract_path_bit(b, i))
+      return false;
+  }
+  return true;
+}
+#endif /* ONEWIRE_USE_SEARCH_ROM */
+
+#if ONEWIRE_USE_UART
+/**
+ * @brief     UART receive end callback.
+ * @note      Must be called from UART's ISR.
+ *
+ * @param[in] uartp     pointer to the @p UARTDriver object
+ *
+ * @notapi
+ */
+static void uart_rxend_cb(UARTDriver *uartp) {
+  onewireDriver *owp = ow_lookup(uartp);
+
+#if ONEWIRE_USE_STRONG_PULLUP
+  /* the bus is released right now, assert pull up as early as possible */
+  if ((true == owp->reg.final_timeslot) && owp->reg.need_pullup) {
+    owp->reg.state = ONEWIRE_PULL_UP;
+    owp->config->pullup_assert();
+    owp->reg.need_pullup = false;
+  }
+#endif
+
+  osalSysLockFromISR();
+  osalThreadResumeI(&owp->thread, MSG_OK);
+  osalSysUnlockFromISR();
+}
+
+/**
+ * @brief     Switch UART bit rate if needed.
+ *
+ * @param[in] owp       pointer to the @p onewireDriver object
+ * @param[in] speed     new bit rate
+ */
+static void uart_set_speed(onewireDriver *owp, uint32_t speed) {
+  UARTConfig *uartcfg = owp->config->uartcfg;
+
+  if (uartcfg->speed != speed) {
+    uartStop(owp->config->uartd);
+    uartcfg->speed = speed;
+    uartStart(owp->config->uartd, uartcfg);
+  }
+}
+
+/**
+ * @brief     Moves time slots from slots buffer through the bus.
+ * @details   Bus echo overwrites transmitted data in place. It is safe
+ *            because byte is received only after it has been shifted out
+ *            completely, so transmitter DMA has already fetched it.
+ *
+ * @param[in] owp       pointer to the @p onewireDriver object
+ * @param[in] n         number of time slots
+ */
+static void uart_exchange(onewireDriver *owp, size_t n) {
+  UARTDriver *uartd = owp->config->uartd;
+
+  osalSysLock();
+  uartStartReceiveI(uartd, n, owp->slots);
+  uartStartSendI(uartd, n, owp->slots);
+  osalThreadSuspendS(&owp->thread);
+  osalSysUnlock();
+}
+
+/**
+ * @brief     Generate reset pulse using low bit rate.
+ *
+ * @param[in] owp       pointer to the @p onewireDriver object
+ *
+ * @return              Bool flag denoting device presence.
+ */
+static bool uart_reset(onewireDriver *owp) {
+  uint8_t echo;
+
+  uart_set_speed(owp, ONEWIRE_UART_RESET_SPEED);
+  owp->slots[0] = 0xF0;
+  uart_exchange(owp, 1);
+  echo = owp->slots[0];
+  uart_set_speed(owp, ONEWIRE_UART_SLOT_SPEED);
+
+  /* 0 means short circuit, unchanged echo means no presence pulse */
+  owp->reg.slave_present = (0xF0 != echo) && (0 != echo);
+  return owp->reg.slave_present;
+}
+
+/**
+ * @brief     Transmit or receive data splitting it in DMA sized chunks.
+ *
+ * @param[in] owp       pointer to the @p onewireDriver object
+ * @param[in,out] buf   pointer to the data buffer
+ * @param[in] bytes     amount of data
+ * @param[in] read      @p true for reception, @p false for transmission
+ */
+static void uart_transfer(onewireDriver *owp, uint8_t *buf,
+                          size_t bytes, bool read) {
+  size_t i, n;
+
+  while (bytes > 0) {
+    n = bytes > ONEWIRE_UART_CHUNK_BYTES ? ONEWIRE_UART_CHUNK_BYTES : bytes;
+
+    if (read) {
+      memset(owp->slots, 0xFF, n * 8);
+    }
+    else {
+      for (i = 0; i < n * 8; i++)
+        owp->slots[i] = ((buf[i / 8] >> (i % 8)) & 1) ? 0xFF : 0x00;
+    }
+
+    owp->reg.final_timeslot = (n == bytes);
+    uart_exchange(owp, n * 8);
+
+    if (read) {
+      for (i = 0; i < n * 8; i++)
+        buf[i / 8] |= (0xFF == owp->slots[i]) << (i % 8);
+    }
+
+    buf += n;
+    bytes -= n;
+  }
+}
+
+#if ONEWIRE_USE_SEARCH_ROM
+/**
+ * @brief     Discover single ROM.
+ * @details   Direction bit of every ROM bit is transmitted in the same
+ *            transfer with both read slots of the next one.
+ *
+ * @param[in] owp       pointer to the @p onewireDriver object
+ */
+static void uart_search_rom(onewireDriver *owp) {
+  onewire_search_rom_t *sr = &owp->search_rom;
+  size_t n = 2;
+  uint8_t bit;
+
+  owp->slots[0] = 0xFF;
+  owp->slots[1] = 0xFF;
+
+  while (true) {
+    uart_exchange(owp, n);
+    sr->reg.bit_buf = (0xFF == owp->slots[n - 2]) |
+                      ((0xFF == owp->slots[n - 1]) << 1);
+
+    switch(sr->reg.bit_buf){
+    case 0b11:
+      /* no one device on bus or any other fail happened */
+      sr->reg.result = ONEWIRE_SEARCH_ROM_ERROR;
+      return;
+    case 0b01:
+      /* all slaves have 1 in this position */
+      store_bit(sr, 1);
+      bit = 1;
+      break;
+    case 0b10:
+      /* all slaves have 0 in this position */
+      store_bit(sr, 0);
+      bit = 0;
+      break;
+    default:
+      /* collision */
+      sr->reg.single_device = false;
+      bit = collision_handler(sr);
+      break;
+    }
+
+    owp->slots[0] = (1 == bit) ? 0xFF : 0x00;
+    if (64 == sr->reg.rombit) {
+      uart_exchange(owp, 1);
+      sr->reg.devices_found++;
+      sr->reg.search_iter = ONEWIRE_SEARCH_ROM_NEXT;
+      if (true == sr->reg.single_device)
+        sr->reg.result = ONEWIRE_SEARCH_ROM_LAST;
+      return;
+    }
+    owp->slots[1] = 0xFF;
+    owp->slots[2] = 0xFF;
+    n = 3;
+  }
+}
+#endif /* ONEWIRE_USE_SEARCH_ROM */
+#endif /* ONEWIRE_USE_UART */
+
+#if ONEWIRE_USE_SEARCH_ROM
+/**
+ * @brief     Single 'search ROM' iteration.
+ *
+ * @param[in] owp       pointer to the @p onewireDriver object
+ * @param[in] cmd       search command
+ * @param[out] rom      pointer to buffer for discovered ROM
+ *
+ * @return              Bool flag denoting successfully discovered ROM.
+ */
+static bool search_pass(onewireDriver *owp, uint8_t cmd, uint8_t *rom) {
+  onewire_search_rom_t *sr = &owp->search_rom;
+#if !ONEWIRE_USE_UART
+  PWMDriver *pwmd = owp->config->pwmd;
+  PWMConfig *pwmcfg = owp->config->pwmcfg;
+  size_t mch = owp->config->master_channel;
+  size_t sch = owp->config->sample_channel;
+#endif
+
+  /* every search must be started from reset pulse */
+  if (false == onewireReset(owp))
+    return false;
+
+  /* initialize buffer to store result */
+  sr->retbuf = rom;
+  memset(sr->retbuf, 0, 8);
+
+  /* clean iteration state */
+  search_clean_iteration(sr);
+
+  /**/
+  onewireWrite(owp, &cmd, 1, 0);
+
+#if ONEWIRE_USE_UART
+  uart_search_rom(owp);
+#else
+  /* Reconfiguration always needed because of previous call onewireWrite.*/
+  pwmcfg->period = ONEWIRE_ZERO_WIDTH + ONEWIRE_RECOVERY_WIDTH;
+  pwmcfg->callback = NULL;
+  pwmcfg->channels[mch].callback = NULL;
+  pwmcfg->channels[mch].mode = owp->config->pwmmode;
+  pwmcfg->channels[sch].callback = pwm_search_rom_cb;
+  pwmcfg->channels[sch].mode = PWM_OUTPUT_DISABLED;
+
+  ow_bus_active(owp);
+  osalSysLock();
+  pwmEnableChannelI(pwmd, mch, ONEWIRE_ONE_WIDTH);
+  pwmEnableChannelI(pwmd, sch, ONEWIRE_SAMPLE_WIDTH);
+  pwmEnableChannelNotificationI(pwmd, sch);
+  osalThreadSuspendS(&owp->thread);
+  osalSysUnlock();
+
+  ow_bus_idle(owp);
+#endif /* ONEWIRE_USE_UART */
+
+  if (ONEWIRE_SEARCH_ROM_ERROR == sr->reg.result)
+    return false;
+
+  /* check CRC and return false if mismatch */
+  if (sr->retbuf[7] != onewireCRC(sr->retbuf, 7))
+    return false;
+
+  /* store cached result for usage in next iteration */
+  memcpy(sr->prev_path, sr->retbuf, 8);
+  if (64 == sr->last_zero_branch)
+    sr->last_zero_branch = sr->prev_zero_branch;
+  return true;
+}
+
+/**
+ * @brief     Performs search iterations until the last ROM of branch.
+ * @details   Search state must be prepared by caller.
+ *
+ * @param[in] owp         pointer to the @p onewireDriver object
+ * @param[in] cmd         search command
+ * @param[in] prefix      pointer to the ROM prefix of branch, may be
+ *                        @p NULL when @p bits is 0
+ * @param[in] bits        prefix length in bits, 0 means whole bus
+ * @param[out] result     pointer to buffer for discovered ROMs
+ * @param[in] max_rom_cnt buffer size in ROMs count, may be 0
+ *
+ * @return              Count of discovered ROMs. May be more than max_rom_cnt.
+ * @retval 0            no ROMs found or communication error occurred.
+ */
+static size_t search_run(onewireDriver *owp, uint8_t cmd,
+                         const uint8_t *prefix, size_t bits,
+                         uint8_t *result, size_t max_rom_cnt) {
+  onewire_search_rom_t *sr = &owp->search_rom;
+  uint8_t spare[8];
+  uint8_t *rom;
+
+  do {
+    /* ROMs not fitting in buffer are discovered in spare one */
+    if (sr->reg.devices_found < max_rom_cnt)
+      rom = result + 8 * sr->reg.devices_found;
+    else
+      rom = spare;
+
+    if (!search_pass(owp, cmd, rom))
+      return 0;
+
+    /* the first iteration of targeted search may end outside branch */
+    if (!prefix_match(rom, prefix, bits)) {
+      sr->reg.devices_found--;
+      break;
+    }
+
+    /* next turn is above the branch root */
+    if (sr->last_zero_branch < (int)bits)
+      break;
+  }
+  while (ONEWIRE_SEARCH_ROM_SUCCESS == sr->reg.result);
+
+  return sr->reg.devices_found;
+}
+
+/**
+ * @brief     Checks if some known ROM lies in the branch.
+ *
+ * @param[in] tp        pointer to the @p onewireTopology object
+ * @param[in] prefix    pointer to the ROM prefix of branch
+ * @param[in] bits      prefix length in bits
+ * @param[in] from      first cache index to be checked
+ * @param[in] to        cache index after the last one to be checked
+ */
+static bool topology_contains(const onewireTopology *tp,
+                              const uint8_t *prefix, size_t bits,
+                              size_t from, size_t to) {
+  size_t i;
+
+  for (i = from; i < to; i++) {
+    if (prefix_match(&tp->roms[8 * i], prefix, bits))
+      return true;
+  }
+  return false;
+}
+
+/**
+ * @brief     Remembers branch to be searched.
+ * @details   Branches lying in already remembered ones are skipped.
+ *            Overflow is handled by replacing all of them by whole bus.
+ *
+ * @param[in,out] tp    pointer to the @p onewireTopology object
+ * @param[in] prefix    pointer to the ROM prefix of branch
+ * @param[in] bits      prefix length in bits
+ */
+static void topology_add_branch(onewireTopology *tp,
+                                const uint8_t *prefix, size_t bits) {
+  size_t b;
+
+  for (b = 0; b < tp->branches; b++) {
+    if ((tp->branch_bits[b] <= bits) &&
+        prefix_match(tp->branch[b], prefix, tp->branch_bits[b]))
+      return;
+  }
+
+  if (ONEWIRE_TOPOLOGY_BRANCHES == tp->branches) {
+    memset(tp->branch[0], 0, 8);
+    tp->branch_bits[0] = 0;
+    tp->branches = 1;
+    return;
+  }
+
+  /* bits behind the prefix are zeroed so search starts from its lowest ROM */
+  memset(tp->branch[tp->branches], 0, 8);
+  for (b = 0; b < bits; b++) {
+    tp->branch[tp->branches][b / CHAR_BIT] |=
+        extract_path_bit(prefix, b) << (b % CHAR_BIT);
+  }
+  tp->branch_bits[tp->branches] = (uint8_t)bits;
+  tp->branches++;
+}
+
+/**
+ * @brief     Remembers branches met by verification iteration which
+ *            contain no known ROMs.
+ * @details   Collision at bit N means both subtrees exist on bus, the one
+ *            not taken starts with first N bits of the found ROM followed
+ *            by inverted bit N.
+ *
+ * @param[in,out] tp      pointer to the @p onewireTopology object
+ * @param[in] rom         pointer to the ROM found by iteration
+ * @param[in] collisions  collision bits of iteration
+ * @param[in] kept        number of verified ROMs at cache beginning
+ * @param[in] current     cache index of ROM being verified, it and all
+ *                        the following ones are not verified yet
+ */
+static void topology_collect_branches(onewireTopology *tp, const uint8_t *rom,
+                                      const uint8_t *collisions,
+                                      size_t kept, size_t current) {
+  uint8_t other[8];
+  size_t bit;
+
+  for (bit = 0; bit < 64; bit++) {
+    if (0 == extract_path_bit(collisions, bit))
+      continue;
+
+    memcpy(other, rom, 8);
+    other[bit / CHAR_BIT] ^= 1U << (bit % CHAR_BIT);
+    if (!topology_contains(tp, other, bit + 1, 0, kept) &&
+        !topology_contains(tp, other, bit + 1, current, tp->count))
+      topology_add_branch(tp, other, bit + 1);
+  }
 }
 #endif /* ONEWIRE_USE_SEARCH_ROM */
 
@@ -589,10 +1079,16 @@ void onewireObjectInit(onewireDriver *owp) {
  * @api
  */
 void onewireStart(onewireDriver *owp, const onewireConfig *config) {
+  size_t i;
 
   osalDbgCheck((NULL != owp) && (NULL != config));
+#if ONEWIRE_USE_UART
+  osalDbgAssert(UART_STOP == config->uartd->state,
+      "UART will be started by onewire driver internally");
+#else
   osalDbgAssert(PWM_STOP == config->pwmd->state,
       "PWM will be started by onewire driver internally");
+#endif
   osalDbgAssert(ONEWIRE_STOP == owp->reg.state, "Invalid state");
 #if ONEWIRE_USE_STRONG_PULLUP
   osalDbgCheck((NULL != config->pullup_assert) &&
@@ -600,6 +1096,31 @@ void onewireStart(onewireDriver *owp, const onewireConfig *config) {
 #endif
 
   owp->config = config;
+
+  osalSysLock();
+  for (i = 0; i < ONEWIRE_MAX_BUSES; i++) {
+    osalDbgAssert((NULL == ow_drivers[i]) ||
+                  (ow_lld_driver(ow_drivers[i]) != ow_lld_driver(owp)),
+                  "Low level driver already used by other bus");
+  }
+  for (i = 0; i < ONEWIRE_MAX_BUSES; i++) {
+    if (NULL == ow_drivers[i]) {
+      ow_drivers[i] = owp;
+      break;
+    }
+  }
+  osalSysUnlock();
+  osalDbgAssert(i < ONEWIRE_MAX_BUSES, "ONEWIRE_MAX_BUSES too small");
+
+#if ONEWIRE_USE_UART
+  owp->config->uartcfg->txend1_cb = NULL;
+  owp->config->uartcfg->txend2_cb = NULL;
+  owp->config->uartcfg->rxend_cb = uart_rxend_cb;
+  owp->config->uartcfg->rxchar_cb = NULL;
+  owp->config->uartcfg->rxerr_cb = NULL;
+  owp->config->uartcfg->speed = ONEWIRE_UART_SLOT_SPEED;
+  uartStart(owp->config->uartd, owp->config->uartcfg);
+#else
   owp->config->pwmcfg->frequency = ONEWIRE_PWM_FREQUENCY;
   owp->config->pwmcfg->period = ONEWIRE_RESET_TOTAL_WIDTH;
 
@@ -608,6 +1129,7 @@ void onewireStart(onewireDriver *owp, const onewireConfig *config) {
       owp->config->pad_mode_active);
 #endif
   ow_bus_idle(owp);
+#endif /* ONEWIRE_USE_UART */
   owp->reg.state = ONEWIRE_READY;
 }
 
@@ -619,12 +1141,26 @@ void onewireStart(onewireDriver *owp, const onewireConfig *config) {
  * @api
  */
 void onewireStop(onewireDriver *owp) {
+  size_t i;
+
   osalDbgCheck(NULL != owp);
 #if ONEWIRE_USE_STRONG_PULLUP
   owp->config->pullup_release();
 #endif
+#if ONEWIRE_USE_UART
+  uartStop(owp->config->uartd);
+#else
   ow_bus_idle(owp);
   pwmStop(owp->config->pwmd);
+#endif
+
+  osalSysLock();
+  for (i = 0; i < ONEWIRE_MAX_BUSES; i++) {
+    if (owp == ow_drivers[i])
+      ow_drivers[i] = NULL;
+  }
+  osalSysUnlock();
+
   owp->config = NULL;
   owp->reg.state = ONEWIRE_STOP;
 }
@@ -638,6 +1174,12 @@ void onewireStop(onewireDriver *owp) {
  * @retval true         There is at least one device on bus.
  */
 bool onewireReset(onewireDriver *owp) {
+#if ONEWIRE_USE_UART
+  osalDbgCheck(NULL != owp);
+  osalDbgAssert(owp->reg.state == ONEWIRE_READY, "Invalid state");
+
+  return uart_reset(owp);
+#else
   PWMDriver *pwmd;
   PWMConfig *pwmcfg;
   size_t mch, sch;
@@ -676,6 +1218,7 @@ bool onewireReset(onewireDriver *owp) {
   /* wait until slave release bus to discriminate short circuit condition */
   osalThreadSleepMicroseconds(500);
   return (PAL_HIGH == ow_read_bit(owp)) && (true == owp->reg.slave_present);
+#endif /* ONEWIRE_USE_UART */
 }
 
 /**
@@ -686,9 +1229,11 @@ bool onewireReset(onewireDriver *owp) {
  * @param[in] rxbytes   amount of data to be received
  */
 void onewireRead(onewireDriver *owp, uint8_t *rxbuf, size_t rxbytes) {
+#if !ONEWIRE_USE_UART
   PWMDriver *pwmd;
   PWMConfig *pwmcfg;
   size_t mch, sch;
+#endif
 
   osalDbgCheck((NULL != owp) && (NULL != rxbuf));
   osalDbgCheck((rxbytes > 0) && (rxbytes <= ONEWIRE_MAX_TRANSACTION_LEN));
@@ -698,6 +1243,9 @@ void onewireRead(onewireDriver *owp, uint8_t *rxbuf, size_t rxbytes) {
      bits using |= operation.*/
   memset(rxbuf, 0, rxbytes);
 
+#if ONEWIRE_USE_UART
+  uart_transfer(owp, rxbuf, rxbytes, true);
+#else
   pwmd = owp->config->pwmd;
   pwmcfg = owp->config->pwmcfg;
   mch = owp->config->master_channel;
@@ -724,6 +1272,7 @@ void onewireRead(onewireDriver *owp, uint8_t *rxbuf, size_t rxbytes) {
   osalSysUnlock();
 
   ow_bus_idle(owp);
+#endif /* ONEWIRE_USE_UART */
 }
 
 /**
@@ -737,9 +1286,11 @@ void onewireRead(onewireDriver *owp, uint8_t *rxbuf, size_t rxbytes) {
  */
 void onewireWrite(onewireDriver *owp, uint8_t *txbuf,
                   size_t txbytes, systime_t pullup_time) {
+#if !ONEWIRE_USE_UART
   PWMDriver *pwmd;
   PWMConfig *pwmcfg;
   size_t mch, sch;
+#endif
 
   osalDbgCheck((NULL != owp) && (NULL != txbuf));
   osalDbgCheck((txbytes > 0) && (txbytes <= ONEWIRE_MAX_TRANSACTION_LEN));
@@ -749,6 +1300,16 @@ void onewireWrite(onewireDriver *owp, uint8_t *txbuf,
       "Non zero time is valid only when strong pull enabled");
 #endif
 
+#if ONEWIRE_USE_STRONG_PULLUP
+  if (pullup_time > 0) {
+    owp->reg.state = ONEWIRE_PULL_UP;
+    owp->reg.need_pullup = true;
+  }
+#endif
+
+#if ONEWIRE_USE_UART
+  uart_transfer(owp, txbuf, txbytes, false);
+#else
   pwmd = owp->config->pwmd;
   pwmcfg = owp->config->pwmcfg;
   mch = owp->config->master_channel;
@@ -766,13 +1327,6 @@ void onewireWrite(onewireDriver *owp, uint8_t *txbuf,
   pwmcfg->channels[sch].callback = NULL;
   pwmcfg->channels[sch].mode = PWM_OUTPUT_DISABLED;
 
-#if ONEWIRE_USE_STRONG_PULLUP
-  if (pullup_time > 0) {
-    owp->reg.state = ONEWIRE_PULL_UP;
-    owp->reg.need_pullup = true;
-  }
-#endif
-
   ow_bus_active(owp);
   osalSysLock();
   pwmEnablePeriodicNotificationI(pwmd);
@@ -781,6 +1335,7 @@ void onewireWrite(onewireDriver *owp, uint8_t *txbuf,
 
   pwmDisablePeriodicNotification(pwmd);
   ow_bus_idle(owp);
+#endif /* ONEWIRE_USE_UART */
 
 #if ONEWIRE_USE_STRONG_PULLUP
   if (pullup_time > 0) {
@@ -806,74 +1361,190 @@ void onewireWrite(onewireDriver *owp, uint8_t *txbuf,
  */
 size_t onewireSearchRom(onewireDriver *owp, uint8_t *result,
                         size_t max_rom_cnt) {
-  PWMDriver *pwmd;
-  PWMConfig *pwmcfg;
-  uint8_t cmd;
-  size_t mch, sch;
 
-  osalDbgCheck(NULL != owp);
+  osalDbgCheck((NULL != owp) && (NULL != result));
   osalDbgAssert(ONEWIRE_READY == owp->reg.state, "Invalid state");
   osalDbgCheck((max_rom_cnt <= 256) && (max_rom_cnt > 0));
 
-  pwmd = owp->config->pwmd;
-  pwmcfg = owp->config->pwmcfg;
-  cmd = ONEWIRE_CMD_SEARCH_ROM;
-  mch = owp->config->master_channel;
-  sch = owp->config->sample_channel;
+  search_clean_start(&owp->search_rom);
+  return search_run(owp, ONEWIRE_CMD_SEARCH_ROM, NULL, 0,
+                    result, max_rom_cnt);
+}
+
+/**
+ * @brief   Performs tree search among devices in alarm state.
+ * @details Only devices having alarm flag set answer 'alarm search'
+ *          command, so the cost scales with number of them rather
+ *          than with bus size.
+ *
+ * @param[in] owp         pointer to a @p OWDriver object
+ * @param[out] result     pointer to buffer for discovered ROMs
+ * @param[in] max_rom_cnt buffer size in ROMs count for overflow prevention
+ *
+ * @return              Count of discovered ROMs. May be more than max_rom_cnt.
+ * @retval 0            no alarmed devices or communication error occurred.
+ */
+size_t onewireSearchAlarm(onewireDriver *owp, uint8_t *result,
+                          size_t max_rom_cnt) {
+
+  osalDbgCheck((NULL != owp) && (NULL != result));
+  osalDbgAssert(ONEWIRE_READY == owp->reg.state, "Invalid state");
+  osalDbgCheck((max_rom_cnt <= 256) && (max_rom_cnt > 0));
 
   search_clean_start(&owp->search_rom);
+  return search_run(owp, ONEWIRE_CMD_ALARM_SEARCH, NULL, 0,
+                    result, max_rom_cnt);
+}
 
-  do {
-    /* every search must be started from reset pulse */
-    if (false == onewireReset(owp))
-      return 0;
+/**
+ * @brief   Performs tree search in branch of single family code.
+ * @details Search starts directly from the first ROM of the family and
+ *          stops at the last one, devices of other families cost
+ *          nothing but single iteration when family is absent.
+ *
+ * @param[in] owp         pointer to a @p OWDriver object
+ * @param[in] family      family code (first byte of ROM)
+ * @param[out] result     pointer to buffer for discovered ROMs
+ * @param[in] max_rom_cnt buffer size in ROMs count for overflow prevention
+ *
+ * @return              Count of discovered ROMs. May be more than max_rom_cnt.
+ * @retval 0            no such devices or communication error occurred.
+ */
+size_t onewireSearchFamily(onewireDriver *owp, uint8_t family,
+                           uint8_t *result, size_t max_rom_cnt) {
+  uint8_t path[8] = {0};
 
-    /* initialize buffer to store result */
-    if (owp->search_rom.reg.devices_found >= max_rom_cnt)
-      owp->search_rom.retbuf = result + 8*(max_rom_cnt-1);
-    else
-      owp->search_rom.retbuf = result + 8*owp->search_rom.reg.devices_found;
-    memset(owp->search_rom.retbuf, 0, 8);
-
-    /* clean iteration state */
-    search_clean_iteration(&owp->search_rom);
-
-    /**/
-    onewireWrite(&OWD1, &cmd, 1, 0);
-
-    /* Reconfiguration always needed because of previous call onewireWrite.*/
-    pwmcfg->period = ONEWIRE_ZERO_WIDTH + ONEWIRE_RECOVERY_WIDTH;
-    pwmcfg->callback = NULL;
-    pwmcfg->channels[mch].callback = NULL;
-    pwmcfg->channels[mch].mode = owp->config->pwmmode;
-    pwmcfg->channels[sch].callback = pwm_search_rom_cb;
-    pwmcfg->channels[sch].mode = PWM_OUTPUT_DISABLED;
-
-    ow_bus_active(owp);
-    osalSysLock();
-    pwmEnableChannelI(pwmd, mch, ONEWIRE_ONE_WIDTH);
-    pwmEnableChannelI(pwmd, sch, ONEWIRE_SAMPLE_WIDTH);
-    pwmEnableChannelNotificationI(pwmd, sch);
-    osalThreadSuspendS(&owp->thread);
-    osalSysUnlock();
-
-    ow_bus_idle(owp);
-
-    if (ONEWIRE_SEARCH_ROM_ERROR != owp->search_rom.reg.result) {
-      /* check CRC and return 0 (0 == error) if mismatch */
-      if (owp->search_rom.retbuf[7] != onewireCRC(owp->search_rom.retbuf, 7))
-        return 0;
-      /* store cached result for usage in next iteration */
-      memcpy(owp->search_rom.prev_path, owp->search_rom.retbuf, 8);
+  osalDbgCheck((NULL != owp) && (NULL != result));
+  osalDbgAssert(ONEWIRE_READY == owp->reg.state, "Invalid state");
+  osalDbgCheck((max_rom_cnt <= 256) && (max_rom_cnt > 0));
+
+  path[0] = family;
+  search_target_start(&owp->search_rom, path);
+  return search_run(owp, ONEWIRE_CMD_SEARCH_ROM, path, CHAR_BIT,
+                    result, max_rom_cnt);
+}
+
+/**
+ * @brief   Checks presence of device with known ROM.
+ * @details Single search iteration steered along @p rom. It costs as
+ *          much as one device discovery regardless of bus size.
+ *
+ * @param[in] owp       pointer to a @p OWDriver object
+ * @param[in] rom       pointer to the ROM of device
+ *
+ * @return              Bool flag denoting device presence.
+ */
+bool onewireVerifyRom(onewireDriver *owp, const uint8_t *rom) {
+  uint8_t found[8];
+
+  osalDbgCheck((NULL != owp) && (NULL != rom));
+  osalDbgAssert(ONEWIRE_READY == owp->reg.state, "Invalid state");
+
+  search_target_start(&owp->search_rom, rom);
+  return search_pass(owp, ONEWIRE_CMD_SEARCH_ROM, found) &&
+         (0 == memcmp(found, rom, 8));
+}
+
+/**
+ * @brief   Initializes the @p onewireTopology object.
+ *
+ * @param[out] tp       pointer to the @p onewireTopology object
+ * @param[in] roms      buffer for known ROMs, 8 bytes per ROM
+ * @param[in] max       buffer size in ROMs count
+ */
+void onewireTopologyObjectInit(onewireTopology *tp,
+                               uint8_t *roms, size_t max) {
+
+  osalDbgCheck((NULL != tp) && (NULL != roms) && (max > 0));
+
+  tp->roms = roms;
+  tp->max = max;
+  tp->count = 0;
+  tp->added = 0;
+  tp->removed = 0;
+  tp->overflow = false;
+  tp->branches = 0;
+}
+
+/**
+ * @brief   Brings the topology cache in line with bus.
+ * @details Every known ROM is verified by single steered search
+ *          iteration. Collision on its path leading to a branch without
+ *          known ROMs means new device, only such branches are searched
+ *          after verification. So the refresh costs one iteration per
+ *          known ROM plus one per new device, and the search is never
+ *          started over. Empty cache results in full search.
+ * @note    Known ROMs keep their relative order, removed ones are dropped
+ *          and new ones are appended to the end of the cache.
+ * @note    Bus errors during verification are taken as device removal.
+ *
+ * @param[in] owp       pointer to a @p OWDriver object
+ * @param[in,out] tp    pointer to the @p onewireTopology object
+ *
+ * @return              Number of changes, sum of @p added and @p removed.
+ */
+size_t onewireTopologyRefresh(onewireDriver *owp, onewireTopology *tp) {
+  onewire_search_rom_t *sr = &owp->search_rom;
+  uint8_t found[8];
+  size_t i, b, known, kept = 0;
+
+  osalDbgCheck((NULL != owp) && (NULL != tp));
+  osalDbgAssert(ONEWIRE_READY == owp->reg.state, "Invalid state");
+
+  tp->added = 0;
+  tp->removed = 0;
+  tp->overflow = false;
+  tp->branches = 0;
+
+  if (0 == tp->count) {
+    memset(found, 0, 8);
+    topology_add_branch(tp, found, 0);
+  }
+
+  for (i = 0; i < tp->count; i++) {
+    const uint8_t *rom = &tp->roms[8 * i];
+
+    search_target_start(sr, rom);
+    if (search_pass(owp, ONEWIRE_CMD_SEARCH_ROM, found)) {
+      topology_collect_branches(tp, found, sr->collisions, kept, i);
+      if (0 == memcmp(found, rom, 8)) {
+        memmove(&tp->roms[8 * kept], rom, 8);
+        kept++;
+        continue;
+      }
+      /* Path leads to unknown device, known one has gone.*/
+      topology_add_branch(tp, found, 64);
     }
+    tp->removed++;
   }
-  while (ONEWIRE_SEARCH_ROM_SUCCESS == owp->search_rom.reg.result);
+  tp->count = kept;
+
+  /* Only branches without known ROMs are searched.*/
+  known = tp->count;
+  for (b = 0; b < tp->branches; b++) {
+    size_t n, j, base = tp->count;
+
+    search_target_start(sr, tp->branch[b]);
+    n = search_run(owp, ONEWIRE_CMD_SEARCH_ROM, tp->branch[b],
+                   tp->branch_bits[b], &tp->roms[8 * base],
+                   tp->max - base);
+    if (n > tp->max - base) {
+      n = tp->max - base;
+      tp->overflow = true;
+    }
+    /* the same device may be reached through two branches */
+    for (j = 0; j < n; j++) {
+      const uint8_t *rom = &tp->roms[8 * (base + j)];
 
-  /**/
-  if (ONEWIRE_SEARCH_ROM_ERROR == owp->search_rom.reg.result)
-    return 0;
-  else
-    return owp->search_rom.reg.devices_found;
+      if (!topology_contains(tp, rom, 64, 0, tp->count)) {
+        memmove(&tp->roms[8 * tp->count], rom, 8);
+        tp->count++;
+      }
+    }
+  }
+  tp->added = tp->count - known;
+
+  return tp->added + tp->removed;
 }
 #endif /* ONEWIRE_USE_SEARCH_ROM */
 
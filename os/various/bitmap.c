@@ -69,6 +69,143 @@ static inline size_t pos_in_word(size_t bit) {
   return bit % (sizeof(bitmap_word_t) * 8);
 }
 
+/**
+ * @brief Get mask of all bits starting from specified position in word.
+ *
+ * @param[in] pos       position of the first bit in word
+ *
+ * @return              Mask with bits @p pos..(BITMAP_WORD_BITS - 1) set.
+ */
+static inline bitmap_word_t mask_from(size_t pos) {
+  return ~(bitmap_word_t)0 << pos;
+}
+
+/**
+ * @brief Get mask of bits in word covered by range.
+ *
+ * @param[in] pos       position of the first bit in word
+ * @param[in] len       number of bits, must be in range 1..BITMAP_WORD_BITS-pos
+ *
+ * @return              Mask with bits @p pos..(pos + len - 1) set.
+ */
+static inline bitmap_word_t mask_range(size_t pos, size_t len) {
+  bitmap_word_t m = mask_from(pos);
+
+  if ((pos + len) < BITMAP_WORD_BITS)
+    m &= ~mask_from(pos + len);
+  return m;
+}
+
+/**
+ * @brief Get position of the lowest set bit in word.
+ * @note  Compiles to RBIT+CLZ on Cortex-M3 and newer.
+ *
+ * @param[in] w         word value, must not be zero
+ *
+ * @return              Position of the lowest set bit.
+ */
+static inline size_t lowest_set(bitmap_word_t w) {
+  return (size_t)__builtin_ctz(w);
+}
+
+/**
+ * @brief Search for the first word bit set in range of bitmap.
+ *
+ * @param[in] map       the @p bitmap_t structure
+ * @param[in] from      number of the first bit to check
+ * @param[in] invert    search for cleared bits instead of set ones
+ *
+ * @return              Number of the found bit or @p BITMAP_NO_BIT.
+ */
+static size_t find_next(const bitmap_t *map, size_t from, bool invert) {
+  const bitmap_word_t flip = invert ? ~(bitmap_word_t)0 : 0;
+  size_t w = word(from);
+  bitmap_word_t tmp;
+
+  if (w >= map->len)
+    return BITMAP_NO_BIT;
+
+  /* first word is partial */
+  tmp = (map->array[w] ^ flip) & mask_from(pos_in_word(from));
+  while (0 == tmp) {
+    w++;
+    if (w >= map->len)
+      return BITMAP_NO_BIT;
+    tmp = map->array[w] ^ flip;
+  }
+
+  return w * BITMAP_WORD_BITS + lowest_set(tmp);
+}
+
+/**
+ * @brief Apply operation to range of bits word at a time.
+ *
+ * @param[out] map      the @p bitmap_t structure
+ * @param[in] start     number of the first bit in range
+ * @param[in] len       number of bits in range
+ * @param[in] set       set bits if @p true, clear otherwise
+ */
+static void fill_range(bitmap_t *map, size_t start, size_t len, bool set) {
+  size_t w = word(start);
+  size_t pos = pos_in_word(start);
+
+  osalDbgCheck((start + len) <= bitmapGetBitsCount(map));
+
+  while (len > 0) {
+    size_t n = BITMAP_WORD_BITS - pos;
+    bitmap_word_t m;
+
+    if (n > len)
+      n = len;
+    m = mask_range(pos, n);
+
+    if (set)
+      map->array[w] |= m;
+    else
+      map->array[w] &= ~m;
+
+    len -= n;
+    pos = 0;
+    w++;
+  }
+}
+
+/**
+ * @brief Check that all bits in range have the same value.
+ *
+ * @param[in] map       the @p bitmap_t structure
+ * @param[in] start     number of the first bit in range
+ * @param[in] len       number of bits in range
+ * @param[in] set       expected value of bits
+ *
+ * @return              The operation status.
+ * @retval true         all bits in range equal to @p set.
+ * @retval false        at least one bit differs.
+ */
+static bool test_range(const bitmap_t *map, size_t start, size_t len,
+                       bool set) {
+  const bitmap_word_t flip = set ? ~(bitmap_word_t)0 : 0;
+  size_t w = word(start);
+  size_t pos = pos_in_word(start);
+
+  osalDbgCheck((start + len) <= bitmapGetBitsCount(map));
+
+  while (len > 0) {
+    size_t n = BITMAP_WORD_BITS - pos;
+
+    if (n > len)
+      n = len;
+    if (0 != ((map->array[w] ^ flip) & mask_range(pos, n)))
+      return false;
+
+    len -= n;
+    pos = 0;
+    w++;
+  }
+
+  return true;
+}
+
 /*===========================================================================*/
 /* Module exported functions.                                                */
 /*===========================================================================*/
@@ -155,4 +292,131 @@ bitmap_word_t bitmapGet(const bitmap_t *map, size_t bit) {
 size_t bitmapGetBitsCount(const bitmap_t *map) {
   return map->len * sizeof(bitmap_word_t) * 8;
 }
+
+/**
+ * @brief Find the first set bit starting from specified position.
+ * @details Whole words are skipped at once, so the cost depends on
+ *          number of words, not bits.
+ *
+ * @param[in] map       the @p bitmap_t structure
+ * @param[in] from      number of the first bit to check
+ *
+ * @return              Number of the found bit.
+ * @retval BITMAP_NO_BIT no set bits found.
+ */
+size_t bitmapFindNextSet(const bitmap_t *map, size_t from) {
+  return find_next(map, from, false);
+}
+
+/**
+ * @brief Find the first cleared bit starting from specified position.
+ *
+ * @param[in] map       the @p bitmap_t structure
+ * @param[in] from      number of the first bit to check
+ *
+ * @return              Number of the found bit.
+ * @retval BITMAP_NO_BIT no cleared bits found.
+ */
+size_t bitmapFindNextClear(const bitmap_t *map, size_t from) {
+  return find_next(map, from, true);
+}
+
+/**
+ * @brief Set range of bits in an @p bitmap_t structure.
+ *
+ * @param[out] map      the @p bitmap_t structure
+ * @param[in] start     number of the first bit to be set
+ * @param[in] len       number of bits to be set
+ */
+void bitmapSetRange(bitmap_t *map, size_t start, size_t len) {
+  fill_range(map, start, len, true);
+}
+
+/**
+ * @brief Clear range of bits in an @p bitmap_t structure.
+ *
+ * @param[out] map      the @p bitmap_t structure
+ * @param[in] start     number of the first bit to be cleared
+ * @param[in] len       number of bits to be cleared
+ */
+void bitmapClearRange(bitmap_t *map, size_t start, size_t len) {
+  fill_range(map, start, len, false);
+}
+
+/**
+ * @brief Check whether all bits in range are set.
+ *
+ * @param[in] map       the @p bitmap_t structure
+ * @param[in] start     number of the first bit to be checked
+ * @param[in] len       number of bits to be checked
+ *
+ * @return              The operation status.
+ * @retval true         all bits are set.
+ * @retval false        at least one bit is cleared.
+ */
+bool bitmapIsRangeSet(const bitmap_t *map, size_t start, size_t len) {
+  return test_range(map, start, len, true);
+}
+
+/**
+ * @brief Check whether all bits in range are cleared.
+ *
+ * @param[in] map       the @p bitmap_t structure
+ * @param[in] start     number of the first bit to be checked
+ * @param[in] len       number of bits to be checked
+ *
+ * @return              The operation status.
+ * @retval true         all bits are cleared.
+ * @retval false        at least one bit is set.
+ */
+bool bitmapIsRangeClear(const bitmap_t *map, size_t start, size_t len) {
+  return test_range(map, start, len, false);
+}
+
+/**
+ * @brief Get number of set bits in an @p bitmap_t structure.
+ *
+ * @param[in] map       the @p bitmap_t structure
+ *
+ * @return              Number of set bits.
+ */
+size_t bitmapPopcount(const bitmap_t *map) {
+  size_t cnt = 0;
+  size_t w;
+
+  for (w=0; w<map->len; w++)
+    cnt += (size_t)__builtin_popcount(map->array[w]);
+
+  return cnt;
+}
+
+/**
+ * @brief Bitwise AND of two @p bitmap_t structures.
+ *
+ * @param[in,out] dst   the @p bitmap_t structure storing result
+ * @param[in] src       the second operand
+ */
+void bitmapAnd(bitmap_t *dst, const bitmap_t *src) {
+  size_t w;
+
+  osalDbgCheck(dst->len == src->len);
+
+  for (w=0; w<dst->len; w++)
+    dst->array[w] &= src->array[w];
+}
+
+/**
+ * @brief Bitwise OR of two @p bitmap_t structures.
+ *
+ * @param[in,out] dst   the @p bitmap_t structure storing result
+ * @param[in] src       the second operand
+ */
+void bitmapOr(bitmap_t *dst, const bitmap_t *src) {
+  size_t w;
+
+  osalDbgCheck(dst->len == src->len);
+
+  for (w=0; w<dst->len; w++)
+    dst->array[w] |= src->array[w];
+}
 /** @} */
@@ -29,6 +29,11 @@
 /* Module constants.                                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Value returned by search functions when no bit was found.
+ */
+#define BITMAP_NO_BIT                   ((size_t)-1)
+
 /*===========================================================================*/
 /* Module pre-compile time settings.                                         */
 /*===========================================================================*/
@@ -55,6 +60,29 @@ typedef struct {
 /* Module macros.                                                            */
 /*===========================================================================*/
 
+/**
+ * @brief   Number of bits in single @p bitmap_word_t.
+ */
+#define BITMAP_WORD_BITS                (sizeof(bitmap_word_t) * 8)
+
+/**
+ * @brief   Number of words needed to store @p bits bits.
+ * @note    Useful for static allocation of bitmap arrays.
+ */
+#define BITMAP_WORDS(bits)                                                  \
+  (((bits) + BITMAP_WORD_BITS - 1) / BITMAP_WORD_BITS)
+
+/**
+ * @brief   Iterates over all set bits of an @p bitmap_t structure.
+ *
+ * @param[in] map       the @p bitmap_t structure
+ * @param[out] bit      @p size_t variable receiving number of the set bit
+ */
+#define BITMAP_FOREACH_SET(map, bit)                                        \
+  for ((bit) = bitmapFindNextSet((map), 0);                                 \
+       (bit) != BITMAP_NO_BIT;                                              \
+       (bit) = bitmapFindNextSet((map), (bit) + 1))
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
@@ -68,6 +96,15 @@ extern "C" {
   void bitmapInvert(bitmap_t *map, size_t bit);
   bitmap_word_t bitmapGet(const bitmap_t *map, size_t bit);
   size_t bitmapGetBitsCount(const bitmap_t *map);
+  size_t bitmapFindNextSet(const bitmap_t *map, size_t from);
+  size_t bitmapFindNextClear(const bitmap_t *map, size_t from);
+  void bitmapSetRange(bitmap_t *map, size_t start, size_t len);
+  void bitmapClearRange(bitmap_t *map, size_t start, size_t len);
+  bool bitmapIsRangeSet(const bitmap_t *map, size_t start, size_t len);
+  bool bitmapIsRangeClear(const bitmap_t *map, size_t start, size_t len);
+  size_t bitmapPopcount(const bitmap_t *map);
+  void bitmapAnd(bitmap_t *dst, const bitmap_t *src);
+  void bitmapOr(bitmap_t *dst, const bitmap_t *src);
 #ifdef __cplusplus
 }
 #endif
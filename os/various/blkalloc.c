@@ -0,0 +1,322 @@
+/*
+    ChibiOS/HAL - Copyright (C) 2026 agent
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    blkalloc.c
+ * @brief   Fixed-size block allocator code.
+ * @details Manages a memory region split into equal blocks, for example
+ *          DMA buffers placed in external SRAM/SDRAM started by
+ *          @p fsmcSramStart() or @p fsmcSdramStart(). Free blocks are
+ *          tracked by a @p bitmap_t and a second summary @p bitmap_t
+ *          holding one bit per map word, so a free block is found
+ *          with two CTZ lookups instead of a linear scan.
+ *
+ * @addtogroup blkalloc
+ * @{
+ */
+
+#include "hal.h"
+#include "blkalloc.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief Find first free block starting from specified one.
+ *
+ * @param[in] bap       pointer to the @p blkalloc_t object
+ * @param[in] from      number of the first block to check
+ *
+ * @return              Number of the free block or @p BITMAP_NO_BIT.
+ */
+static size_t next_free(const blkalloc_t *bap, size_t from) {
+  size_t w = from / BITMAP_WORD_BITS;
+  size_t b;
+
+  if (from >= bap->stats.total)
+    return BITMAP_NO_BIT;
+
+  /* rest of the current word */
+  if (bap->map->array[w] >> (from % BITMAP_WORD_BITS) != 0)
+    return bitmapFindNextSet(bap->map, from);
+
+  /* summary points directly to the next word having free blocks */
+  w = bitmapFindNextSet(bap->summary, w + 1);
+  if (BITMAP_NO_BIT == w)
+    return BITMAP_NO_BIT;
+  b = bitmapFindNextSet(bap->map, w * BITMAP_WORD_BITS);
+  osalDbgAssert(BITMAP_NO_BIT != b, "summary out of sync");
+  return b;
+}
+
+/**
+ * @brief Find first block with aligned address starting from specified one.
+ * @details Aligned blocks repeat every align / gcd(align, block_size)
+ *          blocks. The first of them is computed by solving the congruence
+ *          base + b * block_size = 0 (mod align), so no block is probed.
+ *
+ * @param[in] bap       pointer to the @p blkalloc_t object
+ * @param[in] from      number of the first block to check
+ * @param[in] align     required alignment, power of two
+ *
+ * @return              Number of the aligned block or @p BITMAP_NO_BIT.
+ */
+static size_t align_up(const blkalloc_t *bap, size_t from, size_t align) {
+  uintptr_t base = (uintptr_t)bap->base;
+  size_t g = bap->block_size & (0 - bap->block_size);
+  size_t step, odd, inv, first;
+  unsigned i;
+
+  /* g is the power of two part of gcd(align, block_size) */
+  if (g > align)
+    g = align;
+  if ((base & (g - 1)) != 0)
+    return BITMAP_NO_BIT;
+  step = align / g;
+  if (1 == step)
+    return from;
+
+  /* block_size / g is odd here, invert it modulo step by Newton iteration */
+  odd = bap->block_size / g;
+  inv = odd;
+  for (i=0; i<5; i++)
+    inv *= 2 - odd * inv;
+  first = ((size_t)(0 - base / g) * inv) & (step - 1);
+
+  if (from <= first)
+    return first;
+  return first + ((from - first + step - 1) & ~(step - 1));
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief Initializes an @p blkalloc_t structure.
+ *
+ * @param[out] bap      pointer to the @p blkalloc_t object
+ * @param[in] base      start of the managed memory region
+ * @param[in] block_size size of single block in bytes
+ * @param[in] blocks    number of blocks in region
+ * @param[in] map       bit map with at least @p blocks bits,
+ *                      see @p BLKALLOC_MAP_WORDS
+ * @param[in] summary   bit map with at least one bit per @p map word,
+ *                      see @p BLKALLOC_SUMMARY_WORDS
+ *
+ * @init
+ */
+void blkallocObjectInit(blkalloc_t *bap, void *base, size_t block_size,
+                        size_t blocks, bitmap_t *map, bitmap_t *summary) {
+  size_t w;
+
+  osalDbgCheck((bap != NULL) && (base != NULL) && (block_size > 0) &&
+               (blocks > 0) && (map != NULL) && (summary != NULL));
+  osalDbgCheck(bitmapGetBitsCount(map) >= blocks);
+  osalDbgCheck(bitmapGetBitsCount(summary) >= map->len);
+
+  bap->base       = base;
+  bap->block_size = block_size;
+  bap->map        = map;
+  bap->summary    = summary;
+
+  bap->stats.total    = blocks;
+  bap->stats.used     = 0;
+  bap->stats.peak     = 0;
+  bap->stats.failures = 0;
+
+  /* tail bits of the last word never become free */
+  bitmapObjectInit(map, 0);
+  bitmapSetRange(map, 0, blocks);
+
+  bitmapObjectInit(summary, 0);
+  for (w=0; w<map->len; w++) {
+    if (map->array[w] != 0)
+      bitmapSet(summary, w);
+  }
+}
+
+/**
+ * @brief Allocates run of contiguous blocks.
+ *
+ * @param[in] bap       pointer to the @p blkalloc_t object
+ * @param[in] n         number of blocks
+ * @param[in] align     required address alignment in bytes, power of two.
+ *                      Zero means no special alignment.
+ * @note    A single block without alignment takes two CTZ lookups. Other
+ *          requests step over whole free and used runs, so the search
+ *          costs one iteration per free run before the one that fits,
+ *          each iteration being a few word wise bitmap scans.
+ *
+ * @return              Pointer to the first block.
+ * @retval NULL         no suitable run of free blocks.
+ *
+ * @iclass
+ */
+void *blkallocAllocI(blkalloc_t *bap, size_t n, size_t align) {
+  size_t b;
+  size_t end;
+  size_t w;
+
+  osalDbgCheckClassI();
+  osalDbgCheck((bap != NULL) && (n > 0));
+  osalDbgCheck((align & (align - 1)) == 0);
+
+  if (0 == align)
+    align = 1;
+
+  b = next_free(bap, 0);
+  while (BITMAP_NO_BIT != b) {
+    b = align_up(bap, b, align);
+    if ((BITMAP_NO_BIT == b) || ((b + n) > bap->stats.total)) {
+      b = BITMAP_NO_BIT;
+      break;
+    }
+    if ((1 == n) && (bitmapGet(bap->map, b) != 0)) {
+      break;
+    }
+    /* end of the free run at b, equals b when b itself is used */
+    end = bitmapFindNextClear(bap->map, b);
+    if ((BITMAP_NO_BIT == end) || ((end - b) >= n)) {
+      break;
+    }
+    /* skip the whole run, free but too short or used */
+    b = next_free(bap, end);
+  }
+
+  if (BITMAP_NO_BIT == b) {
+    bap->stats.failures++;
+    return NULL;
+  }
+
+  bitmapClearRange(bap->map, b, n);
+  for (w = b / BITMAP_WORD_BITS; w <= (b + n - 1) / BITMAP_WORD_BITS; w++) {
+    if (0 == bap->map->array[w])
+      bitmapClear(bap->summary, w);
+  }
+
+  bap->stats.used += n;
+  if (bap->stats.used > bap->stats.peak)
+    bap->stats.peak = bap->stats.used;
+
+  return bap->base + b * bap->block_size;
+}
+
+/**
+ * @brief Allocates run of contiguous blocks.
+ *
+ * @param[in] bap       pointer to the @p blkalloc_t object
+ * @param[in] n         number of blocks
+ * @param[in] align     required address alignment in bytes, power of two.
+ *                      Zero means no special alignment.
+ *
+ * @return              Pointer to the first block.
+ * @retval NULL         no suitable run of free blocks.
+ *
+ * @api
+ */
+void *blkallocAlloc(blkalloc_t *bap, size_t n, size_t align) {
+  void *p;
+
+  osalSysLock();
+  p = blkallocAllocI(bap, n, align);
+  osalSysUnlock();
+
+  return p;
+}
+
+/**
+ * @brief Returns run of blocks to the allocator.
+ *
+ * @param[in] bap       pointer to the @p blkalloc_t object
+ * @param[in] p         pointer returned by allocation function
+ * @param[in] n         number of blocks used in allocation request
+ *
+ * @iclass
+ */
+void blkallocFreeI(blkalloc_t *bap, void *p, size_t n) {
+  size_t offset;
+  size_t b;
+  size_t first_w;
+
+  osalDbgCheckClassI();
+  osalDbgCheck((bap != NULL) && (p != NULL) && (n > 0));
+
+  offset = (size_t)((uint8_t *)p - bap->base);
+  b = offset / bap->block_size;
+
+  osalDbgCheck((offset % bap->block_size) == 0);
+  osalDbgCheck((b + n) <= bap->stats.total);
+  osalDbgAssert(bitmapIsRangeClear(bap->map, b, n), "double free");
+
+  bitmapSetRange(bap->map, b, n);
+  first_w = b / BITMAP_WORD_BITS;
+  bitmapSetRange(bap->summary, first_w,
+                 (b + n - 1) / BITMAP_WORD_BITS - first_w + 1);
+
+  bap->stats.used -= n;
+}
+
+/**
+ * @brief Returns run of blocks to the allocator.
+ *
+ * @param[in] bap       pointer to the @p blkalloc_t object
+ * @param[in] p         pointer returned by allocation function
+ * @param[in] n         number of blocks used in allocation request
+ *
+ * @api
+ */
+void blkallocFree(blkalloc_t *bap, void *p, size_t n) {
+
+  osalSysLock();
+  blkallocFreeI(bap, p, n);
+  osalSysUnlock();
+}
+
+/**
+ * @brief Gets snapshot of occupancy statistics.
+ *
+ * @param[in] bap       pointer to the @p blkalloc_t object
+ * @param[out] stats    pointer to the statistics storage
+ *
+ * @iclass
+ */
+void blkallocGetStatsI(const blkalloc_t *bap, blkalloc_stats_t *stats) {
+
+  osalDbgCheckClassI();
+  osalDbgCheck((bap != NULL) && (stats != NULL));
+
+  *stats = bap->stats;
+}
+
+/** @} */
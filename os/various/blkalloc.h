@@ -0,0 +1,129 @@
+/*
+    ChibiOS/HAL - Copyright (C) 2026 agent
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    blkalloc.h
+ * @brief   Fixed-size block allocator structures and macros.
+ *
+ * @addtogroup blkalloc
+ * @{
+ */
+
+#ifndef BLKALLOC_H_
+#define BLKALLOC_H_
+
+#include "bitmap.h"
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Allocator occupancy statistics.
+ */
+typedef struct {
+  /**
+   * @brief   Total number of blocks in pool.
+   */
+  size_t        total;
+  /**
+   * @brief   Number of currently allocated blocks.
+   */
+  size_t        used;
+  /**
+   * @brief   Maximum number of simultaneously allocated blocks.
+   */
+  size_t        peak;
+  /**
+   * @brief   Number of failed allocation requests.
+   */
+  uint32_t      failures;
+} blkalloc_stats_t;
+
+/**
+ * @brief   Type of a block allocator.
+ */
+typedef struct {
+  /**
+   * @brief   Start of the managed memory region.
+   */
+  uint8_t       *base;
+  /**
+   * @brief   Size of single block in bytes.
+   */
+  size_t        block_size;
+  /**
+   * @brief   Map of blocks. Set bit means free block.
+   */
+  bitmap_t      *map;
+  /**
+   * @brief   Summary map. Bit N is set when word N of @p map has free blocks.
+   */
+  bitmap_t      *summary;
+  /**
+   * @brief   Occupancy statistics.
+   */
+  blkalloc_stats_t stats;
+} blkalloc_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Number of words needed for the block map of @p blocks blocks.
+ */
+#define BLKALLOC_MAP_WORDS(blocks)      BITMAP_WORDS(blocks)
+
+/**
+ * @brief   Number of words needed for the summary map of @p blocks blocks.
+ */
+#define BLKALLOC_SUMMARY_WORDS(blocks)                                      \
+  BITMAP_WORDS(BLKALLOC_MAP_WORDS(blocks))
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void blkallocObjectInit(blkalloc_t *bap, void *base, size_t block_size,
+                          size_t blocks, bitmap_t *map, bitmap_t *summary);
+  void *blkallocAllocI(blkalloc_t *bap, size_t n, size_t align);
+  void *blkallocAlloc(blkalloc_t *bap, size_t n, size_t align);
+  void blkallocFreeI(blkalloc_t *bap, void *p, size_t n);
+  void blkallocFree(blkalloc_t *bap, void *p, size_t n);
+  void blkallocGetStatsI(const blkalloc_t *bap, blkalloc_stats_t *stats);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BLKALLOC_H_ */
+
+/** @} */
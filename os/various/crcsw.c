@@ -181,6 +181,20 @@ const CRCConfig crcsw_crc16_config = {
 /* Driver local variables and types.                                         */
 /*===========================================================================*/
 
+#if ((CRCSW_CRC32_TABLE == TRUE) && (CRCSW_SLICES > 1)) || defined(__DOXYGEN__)
+/**
+ * @brief   Additional slicing tables for CRC32, built on init.
+ */
+static uint32_t crc32_slices[CRCSW_SLICES - 1][256];
+#endif
+
+#if ((CRCSW_CRC16_TABLE == TRUE) && (CRCSW_SLICES > 1)) || defined(__DOXYGEN__)
+/**
+ * @brief   Additional slicing tables for CRC16, built on init.
+ */
+static uint32_t crc16_slices[CRCSW_SLICES - 1][256];
+#endif
+
 /*===========================================================================*/
 /* Driver local functions.                                                   */
 /*===========================================================================*/
@@ -204,6 +218,126 @@ static uint32_t reflect(uint32_t data, uint8_t nBits) {
 }
 #endif
 
+#if (CRCSW_SLICES > 1) || defined(__DOXYGEN__)
+/**
+ * @brief   Builds slicing tables from reflected byte table.
+ * @details Entry @p i of table @p k is the CRC of byte @p i followed
+ *          by @p k zero bytes.
+ *
+ * @param[in] table     byte table
+ * @param[out] slices   storage for @p CRCSW_SLICES - 1 tables
+ */
+static void build_slices(const uint32_t *table,
+                         uint32_t slices[CRCSW_SLICES - 1][256]) {
+  const uint32_t *prev = table;
+  size_t k, i;
+
+  for (k = 0; k < CRCSW_SLICES - 1; k++) {
+    for (i = 0; i < 256; i++)
+      slices[k][i] = (prev[i] >> 8) ^ table[prev[i] & 0xFF];
+    prev = slices[k];
+  }
+}
+
+/**
+ * @brief   Returns slicing tables matching byte table.
+ *
+ * @param[in] table     byte table
+ *
+ * @return              Slicing tables or @p NULL if there are none.
+ */
+static const uint32_t (*get_slices(const uint32_t *table))[256] {
+#if CRCSW_CRC32_TABLE == TRUE
+  if (table == crc32_table)
+    return (const uint32_t (*)[256])crc32_slices;
+#endif
+#if CRCSW_CRC16_TABLE == TRUE
+  if (table == crc16_table)
+    return (const uint32_t (*)[256])crc16_slices;
+#endif
+  return NULL;
+}
+#endif /* CRCSW_SLICES > 1 */
+
+/**
+ * @brief   Table driven calculation of reflected CRC.
+ * @details If slicing tables are available the main loop consumes
+ *          @p CRCSW_SLICES bytes per iteration using aligned word reads.
+ *
+ * @param[in] crc       current CRC value
+ * @param[in] table     byte table
+ * @param[in] n         size of buf in bytes
+ * @param[in] p         @p buffer location
+ *
+ * @return              Updated CRC value.
+ */
+static uint32_t calc_table_reflected(uint32_t crc, const uint32_t *table,
+                                     size_t n, const uint8_t *p) {
+#if CRCSW_SLICES > 1
+  const uint32_t (*t)[256] = get_slices(table);
+
+  if (t != NULL) {
+    /* Head until word boundary.*/
+    while ((n > 0) && (((uintptr_t)p & 3U) != 0)) {
+      crc = table[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+      n--;
+    }
+
+    while (n >= CRCSW_SLICES) {
+      const uint32_t *w = (const uint32_t *)p;
+#if CRCSW_SLICES == 8
+      uint32_t hi = w[1];
+      crc ^= w[0];
+      crc = t[6][crc & 0xFF]          ^ t[5][(crc >> 8) & 0xFF] ^
+            t[4][(crc >> 16) & 0xFF]  ^ t[3][crc >> 24]         ^
+            t[2][hi & 0xFF]           ^ t[1][(hi >> 8) & 0xFF]  ^
+            t[0][(hi >> 16) & 0xFF]   ^ table[hi >> 24];
+#else
+      crc ^= w[0];
+      crc = t[2][crc & 0xFF]          ^ t[1][(crc >> 8) & 0xFF] ^
+            t[0][(crc >> 16) & 0xFF]  ^ table[crc >> 24];
+#endif
+      p += CRCSW_SLICES;
+      n -= CRCSW_SLICES;
+    }
+  }
+#endif /* CRCSW_SLICES > 1 */
+
+  while (n > 0) {
+    crc = table[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+    n--;
+  }
+
+  return crc;
+}
+
+#if (CRCSW_PROGRAMMABLE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Table driven calculation of non reflected CRC.
+ * @note    Polynomial must be at least 8 bits wide.
+ *
+ * @param[in] crc       current CRC value
+ * @param[in] table     byte table
+ * @param[in] poly_size size of polynomial in bits
+ * @param[in] n         size of buf in bytes
+ * @param[in] p         @p buffer location
+ *
+ * @return              Updated CRC value.
+ */
+static uint32_t calc_table_normal(uint32_t crc, const uint32_t *table,
+                                  uint32_t poly_size, size_t n,
+                                  const uint8_t *p) {
+  const uint32_t shift = poly_size - 8;
+
+  while (n > 0) {
+    crc = table[((crc >> shift) ^ *p++) & 0xFF] ^ (crc << 8);
+    n--;
+  }
+
+  return crc;
+}
+#endif /* CRCSW_PROGRAMMABLE */
+
 /*===========================================================================*/
 /* Driver interrupt handlers.                                                */
 /*===========================================================================*/
@@ -218,8 +352,13 @@ static uint32_t reflect(uint32_t data, uint8_t nBits) {
  * @notapi
  */
 void crc_lld_init(void) {
+#if (CRCSW_CRC32_TABLE == TRUE) && (CRCSW_SLICES > 1)
+  build_slices(crc32_table, crc32_slices);
+#endif
+#if (CRCSW_CRC16_TABLE == TRUE) && (CRCSW_SLICES > 1)
+  build_slices(crc16_table, crc16_slices);
+#endif
   crcObjectInit(&CRCD1);
-  CRCD1.crc = CRCD1.config->initial_val;
 }
 
 /**
@@ -244,6 +383,12 @@ void crc_lld_start(CRCDriver *crcp) {
       "config must be CRCSW_CRC16_TABLE_CONFIG");
 #endif
 #endif
+  osalDbgAssert((crcp->config->table == NULL) ||
+      (crcp->config->reflect_data == crcp->config->reflect_remainder),
+      "table driven CRC requires reflect_data == reflect_remainder");
+  osalDbgAssert((crcp->config->table == NULL) ||
+      crcp->config->reflect_data || (crcp->config->poly_size >= 8),
+      "non reflected table driven CRC requires poly_size >= 8");
   crc_lld_reset(crcp);
 }
 
@@ -268,6 +413,12 @@ void crc_lld_stop(CRCDriver *crcp) {
  */
 void crc_lld_reset(CRCDriver *crcp) {
   crcp->crc = crcp->config->initial_val;
+#if CRCSW_PROGRAMMABLE == TRUE
+  /* Reflected table algorithm keeps the register bit reversed.*/
+  if ((crcp->config->table != NULL) && crcp->config->reflect_data) {
+    crcp->crc = reflect(crcp->crc, crcp->config->poly_size);
+  }
+#endif
 }
 
 /**
@@ -280,26 +431,30 @@ void crc_lld_reset(CRCDriver *crcp) {
  * @notapi
  */
 uint32_t crc_lld_calc(CRCDriver *crcp, size_t n, const void *buf) {
-  uint32_t i;
-  uint32_t crc;
-#if (CRCSW_CRC32_TABLE == TRUE) || (CRCSW_CRC16_TABLE == TRUE)
-  if (crcp->config->table != NULL) {
-    for (i = 0; i < n; i++) {
-      uint8_t data = *((uint8_t*)buf + i);
-      uint8_t idx = (crcp->crc ^ data);
-      crcp->crc = (crcp->config->table[idx] ^ (crcp->crc >> 8));
-    }
-    crc = crcp->crc;
-  }
-#endif
+  uint32_t crc = crcp->crc;
 
-#if (CRCSW_PROGRAMMABLE == TRUE)
   // Mask off bits to poly size
   uint32_t mask = 1 << (crcp->config->poly_size - 1);
   mask |= (mask - 1);
 
-  crc = crcp->crc;
+  if (crcp->config->table != NULL) {
+#if CRCSW_PROGRAMMABLE == TRUE
+    if (!crcp->config->reflect_data) {
+      crc = calc_table_normal(crcp->crc, crcp->config->table,
+                              crcp->config->poly_size, n, buf);
+    }
+    else
+#endif
+    {
+      crc = calc_table_reflected(crcp->crc, crcp->config->table, n, buf);
+    }
+    crcp->crc = crc;
+  }
+
+#if (CRCSW_PROGRAMMABLE == TRUE)
   if (crcp->config->table == NULL) {
+    uint32_t i;
+
     for (i = 0; i < n; i++) {
       uint8_t data = *((uint8_t*)buf + i);
       uint8_t bit;
@@ -333,6 +488,59 @@ uint32_t crc_lld_calc(CRCDriver *crcp, size_t n, const void *buf) {
   return (crc ^ crcp->config->final_val) & mask;
 }
 
+#if (CRCSW_PROGRAMMABLE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Builds lookup table for programmable configuration.
+ * @details Fills 256 entries table for the polynomial, size and reflection
+ *          of @p config. The @p table field of @p config is ignored, so the
+ *          same configuration may be used as a template. Point @p table of
+ *          the configuration passed to @p crcStart() to the result to get
+ *          table driven calculation instead of the bit serial one.
+ * @note    Tables can also be generated at build time using
+ *          @p tools/crcsw_table.py
+ *
+ * @param[in] config    pointer to the @p CRCConfig object
+ * @param[out] table    pointer to 256 entries buffer
+ *
+ * @api
+ */
+void crcswBuildTable(const CRCConfig *config, uint32_t *table) {
+  uint32_t size;
+  uint32_t mask;
+  uint32_t i;
+  uint8_t bit;
+
+  osalDbgCheck((config != NULL) && (table != NULL));
+  size = config->poly_size;
+  osalDbgCheck((size > 0) && (size <= 32));
+  osalDbgCheck(config->reflect_data || (size >= 8));
+
+  mask = 1 << (size - 1);
+  mask |= (mask - 1);
+
+  if (config->reflect_data) {
+    const uint32_t poly = reflect(config->poly, size);
+
+    for (i = 0; i < 256; i++) {
+      uint32_t crc = i;
+      for (bit = 0; bit < 8; bit++)
+        crc = (crc & 1) ? (crc >> 1) ^ poly : (crc >> 1);
+      table[i] = crc;
+    }
+  }
+  else {
+    const uint32_t top = 1U << (size - 1);
+
+    for (i = 0; i < 256; i++) {
+      uint32_t crc = i << (size - 8);
+      for (bit = 0; bit < 8; bit++)
+        crc = (crc & top) ? (crc << 1) ^ config->poly : (crc << 1);
+      table[i] = crc & mask;
+    }
+  }
+}
+#endif /* CRCSW_PROGRAMMABLE */
+
 #endif /* CRCSW_USE_CRC1 */
 
 #endif /* HAL_USE_CRC */
@@ -59,6 +59,20 @@
 #define CRCSW_CRC16_TABLE               FALSE
 #endif
 
+/**
+ * @brief   RAM budget in bytes for slicing tables of each built-in CRC.
+ * @details Selects the table variant used by @p CRCSW_CRC32_TABLE and
+ *          @p CRCSW_CRC16_TABLE configurations. Extra tables are built in
+ *          RAM by @p crc_lld_init():
+ *          - less than 3KiB: one byte per iteration.
+ *          - 3KiB: slice-by-4, four bytes per iteration.
+ *          - 7KiB: slice-by-8, eight bytes per iteration.
+ *          .
+ */
+#if !defined(CRCSW_SLICE_BUDGET) || defined(__DOXYGEN__)
+#define CRCSW_SLICE_BUDGET              0
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -72,6 +86,22 @@
 #error "At least one of CRCSW_PROGRAMMABLE, CRCSW_CRC32_TABLE, or CRCSW_CRC16_TABLE must be defined"
 #endif
 
+/**
+ * @brief   Number of bytes processed per table iteration.
+ */
+#if (CRCSW_SLICE_BUDGET >= 7 * 1024) || defined(__DOXYGEN__)
+#define CRCSW_SLICES                    8
+#elif CRCSW_SLICE_BUDGET >= 3 * 1024
+#define CRCSW_SLICES                    4
+#else
+#define CRCSW_SLICES                    1
+#endif
+
+#if (CRCSW_SLICES > 1) && defined(__BYTE_ORDER__) &&                        \
+    (__BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__)
+#error "CRCSW_SLICE_BUDGET requires little endian architecture"
+#endif
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -204,6 +234,9 @@ extern "C" {
   void crc_lld_stop(CRCDriver *crcp);
   void crc_lld_reset(CRCDriver *crcp);
   uint32_t crc_lld_calc(CRCDriver *crcp, size_t n, const void *buf);
+#if CRCSW_PROGRAMMABLE == TRUE
+  void crcswBuildTable(const CRCConfig *config, uint32_t *table);
+#endif
 #ifdef __cplusplus
 }
 #endif
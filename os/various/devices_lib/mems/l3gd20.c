@@ -34,6 +34,8 @@
  * @{
  */
 
+#include <string.h>
+
 #include "ch.h"
 #include "hal.h"
 
@@ -55,6 +57,107 @@
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+/**
+ * @brief   Number of samples stored in FIFO.
+ *
+ * @param[in] src       FIFO_SRC register value
+ */
+static size_t fifo_level(uint8_t src) {
+
+  if (src & L3GD20_FIFO_SRC_OVRN)
+    return L3GD20_FIFO_DEPTH;
+  if (src & L3GD20_FIFO_SRC_EMPTY)
+    return 0;
+  return src & L3GD20_FIFO_SRC_FSS;
+}
+
+/**
+ * @brief   Reads @p n samples from FIFO in single chip select cycle.
+ * @details Output register address rolls back from OUT_Z_H to OUT_X_L
+ *          while FIFO is enabled, so one auto-increment read drains any
+ *          number of samples.
+ */
+static void fifo_burst(L3GD20_Stream *sp, size_t n) {
+  uint8_t cmd = L3GD20_RW | L3GD20_MS | L3GD20_AD_OUT_X_L;
+
+  spiSelect(sp->spip);
+  spiSend(sp->spip, 1, &cmd);
+  spiReceive(sp->spip, n * L3GD20_SAMPLE_SIZE, sp->rxbuf);
+  spiUnselect(sp->spip);
+  sp->bursts++;
+}
+
+/**
+ * @brief   Timestamp of sample with given running index.
+ * @details Linear interpolation from the last anchor using measured
+ *          sample period.
+ */
+static uint32_t sample_time(const L3GD20_Stream *sp, uint32_t index) {
+  int64_t offset = (int64_t)(int32_t)(index - sp->anchorindex) * sp->period;
+
+  return sp->anchortime + (uint32_t)(int32_t)(offset / 256);
+}
+
+/**
+ * @brief   Moves anchor to the sample completing watermark level.
+ * @details Period is measured between two anchors timed by interrupts
+ *          when no sample has been lost in between. Measurements far from
+ *          the current period come from interrupts served late and are
+ *          ignored.
+ *
+ * @param[in] sp        pointer to the @p L3GD20_Stream object
+ * @param[in] index     running index of the sample
+ * @param[in] time      timestamp of the sample
+ * @param[in] measure   sample is timed by the interrupt, period can be
+ *                      measured from the previous anchor and this one
+ */
+static void set_anchor(L3GD20_Stream *sp, uint32_t index, uint32_t time,
+                       bool measure) {
+  uint32_t dn = index - sp->anchorindex;
+
+  if (sp->anchored && measure && (dn > 0)) {
+    uint32_t measured = (uint32_t)(((uint64_t)(time - sp->anchortime) << 8) /
+                                   dn);
+
+    /* first order filter against interrupt latency jitter */
+    if ((measured > sp->period - (sp->period >> 2)) &&
+        (measured < sp->period + (sp->period >> 2)))
+      sp->period = sp->period - (sp->period >> 3) + (measured >> 3);
+  }
+  sp->anchored = measure;
+  sp->anchortime = time;
+  sp->anchorindex = index;
+}
+
+/**
+ * @brief   Converts burst content to samples and pushes them in ring.
+ */
+static void push_samples(L3GD20_Stream *sp, size_t n) {
+  const uint8_t *p = sp->rxbuf;
+  size_t i;
+
+  for (i = 0; i < n; i++, p += L3GD20_SAMPLE_SIZE) {
+    size_t head = sp->head;
+    L3GD20_Sample *smp;
+
+    if (head - sp->tail >= sp->size) {
+      sp->dropped++;
+      sp->samples++;
+      continue;
+    }
+    smp = &sp->ring[head & (sp->size - 1)];
+    smp->timestamp = sample_time(sp, sp->samples);
+    smp->axis[0] = (int16_t)(p[0] | (p[1] << 8));
+    smp->axis[1] = (int16_t)(p[2] | (p[3] << 8));
+    smp->axis[2] = (int16_t)(p[4] | (p[5] << 8));
+    sp->samples++;
+
+    /* sample must be complete before consumer sees it */
+    __sync_synchronize();
+    sp->head = head + 1;
+  }
+}
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -120,4 +223,199 @@ void l3gd20WriteRegister(SPIDriver *spip, uint8_t reg, uint8_t value) {
       spiUnselect(spip);
   }
 }
+
+/**
+ * @brief   Initializes FIFO streaming object.
+ *
+ * @param[out] sp       pointer to the @p L3GD20_Stream object
+ * @param[in] spip      pointer to the SPI interface
+ * @param[in] ring      sample ring buffer
+ * @param[in] size      ring size in samples, must be a power of two
+ */
+void l3gd20StreamObjectInit(L3GD20_Stream *sp, SPIDriver *spip,
+                            L3GD20_Sample *ring, size_t size) {
+
+  osalDbgCheck((sp != NULL) && (spip != NULL) && (ring != NULL));
+  osalDbgCheck((size > 0) && ((size & (size - 1)) == 0));
+
+  memset(sp, 0, sizeof(*sp));
+  sp->spip = spip;
+  sp->ring = ring;
+  sp->size = size;
+}
+
+/**
+ * @brief   Configures gyroscope and enables FIFO in stream mode.
+ * @details Watermark flag is routed to INT2 pin. Application must call
+ *          @p l3gd20StreamInterruptI() on its rising edge.
+ * @pre     The SPI interface must be initialized and the driver started.
+ *
+ * @param[in] sp        pointer to the @p L3GD20_Stream object
+ * @param[in] config    pointer to the @p L3GD20_StreamConfig object
+ */
+void l3gd20StreamStart(L3GD20_Stream *sp, const L3GD20_StreamConfig *config) {
+
+  osalDbgCheck((sp != NULL) && (config != NULL));
+  osalDbgCheck((config->watermark > 0) &&
+               (config->watermark < L3GD20_FIFO_DEPTH) &&
+               (config->period > 0) && (config->clock != NULL));
+
+  sp->config = config;
+  sp->period = config->period << 8;
+  sp->anchored = false;
+  sp->pending = false;
+  sp->samples = 0;
+
+  /* FIFO is reset going through bypass mode.*/
+  l3gd20WriteRegister(sp->spip, L3GD20_AD_CTRL_REG1, L3GD20_PM_POWER_DOWN);
+  l3gd20WriteRegister(sp->spip, L3GD20_AD_FIFO_CTRL_REG,
+                      L3GD20_FIFO_CTRL_FM_BYPASS);
+  l3gd20WriteRegister(sp->spip, L3GD20_AD_CTRL_REG4,
+                      config->fullscale | L3GD20_End_LITTLE);
+  l3gd20WriteRegister(sp->spip, L3GD20_AD_CTRL_REG5, L3GD20_CTRL_REG5_FIFO_EN);
+  l3gd20WriteRegister(sp->spip, L3GD20_AD_FIFO_CTRL_REG,
+                      L3GD20_FIFO_CTRL_FM_STREAM |
+                      (config->watermark & L3GD20_FIFO_CTRL_WTM));
+  l3gd20WriteRegister(sp->spip, L3GD20_AD_CTRL_REG3, L3GD20_CTRL_REG3_I2_WTM);
+  l3gd20WriteRegister(sp->spip, L3GD20_AD_CTRL_REG1,
+                      config->outputdatarate | L3GD20_PM_SLEEP_NORMAL |
+                      config->axesenabling);
+}
+
+/**
+ * @brief   Stops streaming and powers gyroscope down.
+ *
+ * @param[in] sp        pointer to the @p L3GD20_Stream object
+ */
+void l3gd20StreamStop(L3GD20_Stream *sp) {
+
+  osalDbgCheck(sp != NULL);
+
+  l3gd20WriteRegister(sp->spip, L3GD20_AD_CTRL_REG1, L3GD20_PM_POWER_DOWN);
+  l3gd20WriteRegister(sp->spip, L3GD20_AD_CTRL_REG3, 0);
+  l3gd20WriteRegister(sp->spip, L3GD20_AD_FIFO_CTRL_REG,
+                      L3GD20_FIFO_CTRL_FM_BYPASS);
+  l3gd20WriteRegister(sp->spip, L3GD20_AD_CTRL_REG5, 0);
+
+  osalSysLock();
+  osalThreadResumeS(&sp->thread, MSG_RESET);
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Watermark interrupt handler.
+ * @details Must be called from INT2 rising edge ISR, the timestamp must
+ *          be taken as early as possible from a free running counter.
+ *
+ * @param[in] sp        pointer to the @p L3GD20_Stream object
+ * @param[in] timestamp current time
+ *
+ * @iclass
+ */
+void l3gd20StreamInterruptI(L3GD20_Stream *sp, uint32_t timestamp) {
+
+  osalDbgCheckClassI();
+
+  sp->irqtime = timestamp;
+  sp->pending = true;
+  sp->interrupts++;
+  osalThreadResumeI(&sp->thread, MSG_OK);
+}
+
+/**
+ * @brief   Waits for watermark interrupt and drains FIFO into ring.
+ * @details Sample completing the watermark level gets interrupt
+ *          timestamp, the others are interpolated using sample period
+ *          measured between interrupts. When FIFO still holds watermark
+ *          level after the burst no new edge will come, so it is drained
+ *          again without waiting. After FIFO overrun the newest sample is
+ *          timed by the configured clock read before FIFO_SRC.
+ * @note    Must be called from single thread, the same one or another
+ *          consumes samples by @p l3gd20StreamGet().
+ *
+ * @param[in] sp        pointer to the @p L3GD20_Stream object
+ * @param[in] timeout   interrupt wait timeout
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       FIFO has been drained.
+ * @retval MSG_TIMEOUT  no interrupt in time.
+ * @retval MSG_RESET    stream has been stopped.
+ */
+msg_t l3gd20StreamDrain(L3GD20_Stream *sp, systime_t timeout) {
+  msg_t msg = MSG_OK;
+  uint32_t irqtime, now;
+  uint8_t src;
+  size_t n;
+
+  osalDbgCheck(sp != NULL);
+
+  osalSysLock();
+  if (!sp->pending)
+    msg = osalThreadSuspendTimeoutS(&sp->thread, timeout);
+  irqtime = sp->irqtime;
+  sp->pending = false;
+  osalSysUnlock();
+
+  if (msg != MSG_OK)
+    return msg;
+
+  now = sp->config->clock();
+  src = l3gd20ReadRegister(sp->spip, L3GD20_AD_FIFO_SRC_REG);
+  n = fifo_level(src);
+
+  /* Sample stamped by the interrupt has been overwritten and the number
+     of lost samples is unknown. The newest one was completed within the
+     last period before the FIFO_SRC read, it is timed in the middle.*/
+  if (src & L3GD20_FIFO_SRC_OVRN) {
+    sp->overruns++;
+    set_anchor(sp, sp->samples + n - 1, now - (sp->period >> 9), false);
+  }
+  else {
+    set_anchor(sp, sp->samples + sp->config->watermark - 1, irqtime, true);
+  }
+
+  while (n > 0) {
+    fifo_burst(sp, n);
+    push_samples(sp, n);
+
+    src = l3gd20ReadRegister(sp->spip, L3GD20_AD_FIFO_SRC_REG);
+    if (!(src & L3GD20_FIFO_SRC_WTM))
+      break;
+    n = fifo_level(src);
+  }
+
+  return MSG_OK;
+}
+
+/**
+ * @brief   Number of samples waiting in ring.
+ *
+ * @param[in] sp        pointer to the @p L3GD20_Stream object
+ */
+size_t l3gd20StreamAvailable(const L3GD20_Stream *sp) {
+
+  return sp->head - sp->tail;
+}
+
+/**
+ * @brief   Takes the oldest sample from ring.
+ *
+ * @param[in] sp        pointer to the @p L3GD20_Stream object
+ * @param[out] sample   pointer to the sample
+ *
+ * @return              @p false if ring is empty.
+ */
+bool l3gd20StreamGet(L3GD20_Stream *sp, L3GD20_Sample *sample) {
+  size_t tail = sp->tail;
+
+  if (sp->head == tail)
+    return false;
+
+  /* head must be read before the sample it publishes */
+  __sync_synchronize();
+  *sample = sp->ring[tail & (sp->size - 1)];
+  __sync_synchronize();
+  sp->tail = tail + 1;
+  return true;
+}
 /** @} */
@@ -102,8 +102,33 @@
 #define  L3GD20_AD_INT1_TSH_ZL                   ((uint8_t)0x37)            /*!< INTERRUPT1 THRESHOLD Z-AXIS LOW */
 #define  L3GD20_AD_INT1_DURATION                 ((uint8_t)0x38)            /*!< INTERRUPT1 DURATION */
 
+/*******************  Bit definition for FIFO operation  **********************/
+#define  L3GD20_CTRL_REG3_I2_EMPTY               ((uint8_t)0x01)            /*!< FIFO empty on INT2 */
+#define  L3GD20_CTRL_REG3_I2_ORUN                ((uint8_t)0x02)            /*!< FIFO overrun on INT2 */
+#define  L3GD20_CTRL_REG3_I2_WTM                 ((uint8_t)0x04)            /*!< FIFO watermark on INT2 */
+#define  L3GD20_CTRL_REG3_I2_DRDY                ((uint8_t)0x08)            /*!< Data ready on INT2 */
+#define  L3GD20_CTRL_REG5_FIFO_EN                ((uint8_t)0x40)            /*!< FIFO enable */
+#define  L3GD20_FIFO_CTRL_WTM                    ((uint8_t)0x1F)            /*!< WTM[4:0] FIFO watermark level */
+#define  L3GD20_FIFO_CTRL_FM_BYPASS              ((uint8_t)0x00)            /*!< Bypass mode */
+#define  L3GD20_FIFO_CTRL_FM_FIFO                ((uint8_t)0x20)            /*!< FIFO mode */
+#define  L3GD20_FIFO_CTRL_FM_STREAM              ((uint8_t)0x40)            /*!< Stream mode */
+#define  L3GD20_FIFO_SRC_FSS                     ((uint8_t)0x1F)            /*!< FSS[4:0] FIFO stored data level */
+#define  L3GD20_FIFO_SRC_EMPTY                   ((uint8_t)0x20)            /*!< FIFO empty */
+#define  L3GD20_FIFO_SRC_OVRN                    ((uint8_t)0x40)            /*!< FIFO overrun, all levels filled */
+#define  L3GD20_FIFO_SRC_WTM                     ((uint8_t)0x80)            /*!< FIFO filling reached watermark */
+
 /** @} */
 
+/**
+ * @brief   FIFO depth in samples.
+ */
+#define  L3GD20_FIFO_DEPTH                       32U
+
+/**
+ * @brief   Size of single X/Y/Z sample in FIFO.
+ */
+#define  L3GD20_SAMPLE_SIZE                      6U
+
 /*===========================================================================*/
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
@@ -218,6 +243,117 @@ typedef struct {
    */
   L3GD20_BDU_t   blockdataupdate;
 } L3GD20_Config;
+
+/**
+ * @brief   Timestamped raw gyroscope sample.
+ */
+typedef struct {
+  /**
+   * @brief Sample time in units of @p L3GD20_StreamConfig timestamps.
+   */
+  uint32_t       timestamp;
+  /**
+   * @brief X, Y and Z raw values.
+   */
+  int16_t        axis[3];
+} L3GD20_Sample;
+
+/**
+ * @brief   Gyroscope FIFO streaming configuration structure.
+ */
+typedef struct {
+  /**
+   * @brief Gyroscope fullscale value.
+   */
+  L3GD20_FS_t    fullscale;
+  /**
+   * @brief Gyroscope output data rate selection.
+   */
+  L3GD20_ODR_t   outputdatarate;
+  /**
+   * @brief Gyroscope axes enabling.
+   */
+  L3GD20_AE_t    axesenabling;
+  /**
+   * @brief FIFO level raising INT2, 1..31 samples.
+   */
+  uint8_t        watermark;
+  /**
+   * @brief Nominal sample period in timestamp units.
+   * @details Used until period is measured from two interrupts.
+   */
+  uint32_t       period;
+  /**
+   * @brief Reads the free running counter interrupt timestamps come from.
+   * @details Times the newest sample after FIFO overrun, the interrupt
+   *          timestamp then belongs to an overwritten sample.
+   */
+  uint32_t       (*clock)(void);
+} L3GD20_StreamConfig;
+
+/**
+ * @brief   Gyroscope FIFO streaming object.
+ * @details Watermark interrupt stamps time and wakes the thread calling
+ *          @p l3gd20StreamDrain(). It reads the whole FIFO content by
+ *          single burst and pushes samples in the ring. The ring has
+ *          single producer and single consumer and needs no locking.
+ */
+typedef struct {
+  /**
+   * @brief SPI interface, must be started by application.
+   */
+  SPIDriver                 *spip;
+  /**
+   * @brief Current configuration.
+   */
+  const L3GD20_StreamConfig *config;
+  /**
+   * @brief Sample ring, its size is a power of two.
+   */
+  L3GD20_Sample             *ring;
+  size_t                    size;
+  /**
+   * @brief Ring indexes, head is written by producer, tail by consumer.
+   */
+  volatile size_t           head;
+  volatile size_t           tail;
+  /**
+   * @brief Thread waiting for the watermark interrupt.
+   */
+  thread_reference_t        thread;
+  /**
+   * @brief Timestamp of pending interrupt.
+   */
+  uint32_t                  irqtime;
+  bool                      pending;
+  /**
+   * @brief Timestamp anchor, sample with @p anchorindex was taken
+   *        at @p anchortime. @p anchored when the time comes from the
+   *        interrupt and the period can be measured from it.
+   */
+  bool                      anchored;
+  uint32_t                  anchortime;
+  uint32_t                  anchorindex;
+  /**
+   * @brief Running count of samples read from FIFO.
+   */
+  uint32_t                  samples;
+  /**
+   * @brief Sample period in timestamp units, 8 bit fraction.
+   */
+  uint32_t                  period;
+  /**
+   * @brief Statistics.
+   */
+  uint32_t                  interrupts;
+  uint32_t                  bursts;
+  uint32_t                  overruns;
+  uint32_t                  dropped;
+  /**
+   * @brief Burst receive buffer.
+   */
+  uint8_t                   rxbuf[L3GD20_FIFO_DEPTH * L3GD20_SAMPLE_SIZE];
+} L3GD20_Stream;
 /** @}  */
 /*===========================================================================*/
 /* Driver macros.                                                            */
@@ -233,6 +369,14 @@ extern "C" {
 
   uint8_t l3gd20ReadRegister(SPIDriver *spip, uint8_t reg);
   void l3gd20WriteRegister(SPIDriver *spip, uint8_t reg, uint8_t value);
+  void l3gd20StreamObjectInit(L3GD20_Stream *sp, SPIDriver *spip,
+                              L3GD20_Sample *ring, size_t size);
+  void l3gd20StreamStart(L3GD20_Stream *sp, const L3GD20_StreamConfig *config);
+  void l3gd20StreamStop(L3GD20_Stream *sp);
+  void l3gd20StreamInterruptI(L3GD20_Stream *sp, uint32_t timestamp);
+  msg_t l3gd20StreamDrain(L3GD20_Stream *sp, systime_t timeout);
+  size_t l3gd20StreamAvailable(const L3GD20_Stream *sp);
+  bool l3gd20StreamGet(L3GD20_Stream *sp, L3GD20_Sample *sample);
 #ifdef __cplusplus
 }
 #endif
@@ -38,6 +38,7 @@
 #include "hal.h"
 
 #include "lis3mdl.h"
+#include "mems_unpack.h"
 
 /*===========================================================================*/
 /* Driver local definitions.                                                 */
@@ -148,4 +149,53 @@ void lis3mdlWriteRegister(I2CDriver *i2cp, uint8_t sad, uint8_t sub,
     break;
   }
 }
+
+/**
+ * @brief   Reads a block of consecutive sub-registers.
+ * @details Whole block is read by a single bus transaction, sub-register
+ *          address is incremented by the device.
+ * @pre     The I2C interface must be initialized and the driver started.
+ * @note    On STM32F1 at least two bytes must be read.
+ *
+ * @param[in] i2cp      pointer to the I2C interface
+ * @param[in] sad       slave address without R bit
+ * @param[in] sub       first sub-register address
+ * @param[out] rxbuf    pointer to receive buffer
+ * @param[in] n         number of bytes to be read
+ * @param[out] message  pointer to message
+ */
+void lis3mdlReadRegisters(I2CDriver *i2cp, uint8_t sad, uint8_t sub,
+                          uint8_t *rxbuf, size_t n, msg_t* message) {
+  uint8_t txbuf;
+  msg_t msg;
+
+  chDbgCheck((rxbuf != NULL) && (n > 0U));
+
+  txbuf = LIS3MDL_SUB_MSB | sub;
+  msg = i2cMasterTransmitTimeout(i2cp, sad, &txbuf, 1, rxbuf, n,
+                                 TIME_INFINITE);
+  if(message != NULL){
+    *message = msg;
+  }
+}
+
+/**
+ * @brief   Reads X, Y and Z output registers by a single transaction.
+ * @pre     Output data are little endian.
+ *
+ * @param[in] i2cp      pointer to the I2C interface
+ * @param[in] sad       slave address without R bit
+ * @param[out] axis     X, Y and Z raw values
+ * @param[out] message  pointer to message
+ */
+void lis3mdlReadRaw(I2CDriver *i2cp, uint8_t sad, int16_t axis[3],
+                    msg_t* message) {
+
+  chDbgCheck(axis != NULL);
+
+  lis3mdlReadRegisters(i2cp, sad, LIS3MDL_SUB_OUT_X_L, (uint8_t *)axis,
+                       3U * sizeof(int16_t), message);
+  memsUnpackLE16(axis, 3U);
+}
+
 /** @} */
@@ -249,6 +249,10 @@ extern "C" {
                                  msg_t* message);
   void lis3mdlWriteRegister(I2CDriver *i2cp, uint8_t sad, uint8_t sub,
                                  uint8_t value, msg_t* message);
+  void lis3mdlReadRegisters(I2CDriver *i2cp, uint8_t sad, uint8_t sub,
+                            uint8_t *rxbuf, size_t n, msg_t* message);
+  void lis3mdlReadRaw(I2CDriver *i2cp, uint8_t sad, int16_t axis[3],
+                      msg_t* message);
 #ifdef __cplusplus
 }
 #endif
@@ -38,6 +38,7 @@
 #include "hal.h"
 
 #include "lsm303dlhc.h"
+#include "mems_unpack.h"
 
 /*===========================================================================*/
 /* Driver local definitions.                                                 */
@@ -202,4 +203,78 @@ void lsm303dlhcWriteRegister(I2CDriver *i2cp,uint8_t sad, uint8_t sub,
     }
   }
 }
+
+/**
+ * @brief   Reads a block of consecutive sub-registers.
+ * @details Whole block is read by a single bus transaction. Accelerometer
+ *          increments the sub-register address when its MSB is set, the
+ *          magnetometer always does.
+ * @pre     The I2C interface must be initialized and the driver started.
+ * @note    On STM32F1 at least two bytes must be read.
+ *
+ * @param[in] i2cp      pointer to the I2C interface
+ * @param[in] sad       slave address without R bit
+ * @param[in] sub       first sub-register address
+ * @param[out] rxbuf    pointer to receive buffer
+ * @param[in] n         number of bytes to be read
+ * @param[out] message  pointer to message
+ */
+void lsm303dlhcReadRegisters(I2CDriver *i2cp, uint8_t sad, uint8_t sub,
+                             uint8_t *rxbuf, size_t n, msg_t* message) {
+  uint8_t txbuf;
+  msg_t msg;
+
+  chDbgCheck((rxbuf != NULL) && (n > 0U));
+
+  txbuf = sub;
+  if(sad == LSM303DLHC_SAD_ACCEL){
+    txbuf |= LSM303DLHC_SUB_MSB;
+  }
+  msg = i2cMasterTransmitTimeout(i2cp, sad, &txbuf, 1, rxbuf, n,
+                                 TIME_INFINITE);
+  if(message != NULL){
+    *message = msg;
+  }
+}
+
+/**
+ * @brief   Reads accelerometer X, Y and Z outputs by a single transaction.
+ * @pre     Accelerometer output data are little endian.
+ *
+ * @param[in] i2cp      pointer to the I2C interface
+ * @param[out] axis     X, Y and Z raw values
+ * @param[out] message  pointer to message
+ */
+void lsm303dlhcAccReadRaw(I2CDriver *i2cp, int16_t axis[3], msg_t* message) {
+
+  chDbgCheck(axis != NULL);
+
+  lsm303dlhcReadRegisters(i2cp, LSM303DLHC_SAD_ACCEL,
+                          LSM303DLHC_SUB_ACC_OUT_X_L, (uint8_t *)axis,
+                          3U * sizeof(int16_t), message);
+  memsUnpackLE16(axis, 3U);
+}
+
+/**
+ * @brief   Reads magnetometer X, Y and Z outputs by a single transaction.
+ * @details Magnetometer registers are big endian in X, Z, Y order, values
+ *          are returned in X, Y, Z order.
+ *
+ * @param[in] i2cp      pointer to the I2C interface
+ * @param[out] axis     X, Y and Z raw values
+ * @param[out] message  pointer to message
+ */
+void lsm303dlhcCompReadRaw(I2CDriver *i2cp, int16_t axis[3], msg_t* message) {
+  uint8_t rxbuf[6];
+
+  chDbgCheck(axis != NULL);
+
+  lsm303dlhcReadRegisters(i2cp, LSM303DLHC_SAD_COMPASS,
+                          LSM303DLHC_SUB_COMP_OUT_X_H, rxbuf, sizeof(rxbuf),
+                          message);
+  axis[0] = (int16_t)(((uint16_t)rxbuf[0] << 8) | rxbuf[1]);
+  axis[1] = (int16_t)(((uint16_t)rxbuf[4] << 8) | rxbuf[5]);
+  axis[2] = (int16_t)(((uint16_t)rxbuf[2] << 8) | rxbuf[3]);
+}
+
 /** @} */
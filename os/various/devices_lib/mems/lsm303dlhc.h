@@ -343,6 +343,12 @@ extern "C" {
                                  msg_t* message);
   void lsm303dlhcWriteRegister(I2CDriver *i2cp,uint8_t sad, uint8_t sub,
                                  uint8_t value, msg_t* message);
+  void lsm303dlhcReadRegisters(I2CDriver *i2cp, uint8_t sad, uint8_t sub,
+                               uint8_t *rxbuf, size_t n, msg_t* message);
+  void lsm303dlhcAccReadRaw(I2CDriver *i2cp, int16_t axis[3],
+                            msg_t* message);
+  void lsm303dlhcCompReadRaw(I2CDriver *i2cp, int16_t axis[3],
+                             msg_t* message);
 
 #ifdef __cplusplus
 }
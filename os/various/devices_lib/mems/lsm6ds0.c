@@ -38,6 +38,7 @@
 #include "hal.h"
 
 #include "lsm6ds0.h"
+#include "mems_unpack.h"
 
 /*===========================================================================*/
 /* Driver local definitions.                                                 */
@@ -55,6 +56,22 @@
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+/**
+ * @brief   Sets and clears bits of a register.
+ * @note    Error of a previous access is kept in @p message.
+ */
+static void update_register(I2CDriver *i2cp, uint8_t sad, uint8_t sub,
+                            uint8_t clear, uint8_t set, msg_t* message) {
+  msg_t msg;
+  uint8_t value;
+
+  value = lsm6ds0ReadRegister(i2cp, sad, sub, &msg);
+  if (msg == MSG_OK)
+    lsm6ds0WriteRegister(i2cp, sad, sub, (value & ~clear) | set, &msg);
+  if ((message != NULL) && (*message == MSG_OK))
+    *message = msg;
+}
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -181,4 +198,167 @@ void lsm6ds0WriteRegister(I2CDriver *i2cp, uint8_t sad, uint8_t sub,
   }
 }
 
+/**
+ * @brief   Reads a block of consecutive sub-registers.
+ * @details Whole block is read by a single bus transaction, sub-register
+ *          address is incremented by the device.
+ * @pre     The I2C interface must be initialized and the driver started.
+ * @pre     IF_ADD_INC bit of CTRL_REG8 is set, it is the reset value.
+ * @note    On STM32F1 at least two bytes must be read.
+ *
+ * @param[in] i2cp      pointer to the I2C interface
+ * @param[in] sad       slave address without R bit
+ * @param[in] sub       first sub-register address
+ * @param[out] rxbuf    pointer to receive buffer
+ * @param[in] n         number of bytes to be read
+ * @param[out] message  pointer to message
+ */
+void lsm6ds0ReadRegisters(I2CDriver *i2cp, uint8_t sad, uint8_t sub,
+                          uint8_t *rxbuf, size_t n, msg_t* message) {
+  msg_t msg;
+
+  chDbgCheck((rxbuf != NULL) && (n > 0U));
+
+  msg = i2cMasterTransmitTimeout(i2cp, sad, &sub, 1, rxbuf, n, TIME_INFINITE);
+  if(message != NULL){
+    *message = msg;
+  }
+}
+
+/**
+ * @brief   Reads gyroscope and accelerometer output registers.
+ * @details Two bus transactions, one per output register set.
+ * @pre     Output data are little endian.
+ *
+ * @param[in] i2cp      pointer to the I2C interface
+ * @param[in] sad       slave address without R bit
+ * @param[out] sp       pointer to the sample
+ * @param[out] message  pointer to message
+ */
+void lsm6ds0ReadRaw(I2CDriver *i2cp, uint8_t sad, LSM6DS0_Sample *sp,
+                    msg_t* message) {
+  msg_t msg;
+
+  chDbgCheck(sp != NULL);
+
+  lsm6ds0ReadRegisters(i2cp, sad, LSM6DS0_SUB_OUT_X_L_G,
+                       (uint8_t *)sp->gyro, sizeof(sp->gyro), &msg);
+  if (msg == MSG_OK)
+    lsm6ds0ReadRegisters(i2cp, sad, LSM6DS0_SUB_OUT_X_L_XL,
+                         (uint8_t *)sp->acc, sizeof(sp->acc), &msg);
+  memsUnpackLE16((int16_t *)sp, 6U);
+  if(message != NULL){
+    *message = msg;
+  }
+}
+
+/**
+ * @brief   Enables the FIFO and its threshold interrupt on INT1_A/G.
+ * @details FIFO is stored with both gyroscope and accelerometer data,
+ *          so both must be running at the same output data rate.
+ * @pre     The gyroscope and accelerometer are configured.
+ *
+ * @param[in] i2cp      pointer to the I2C interface
+ * @param[in] cfgp      pointer to the FIFO configuration
+ * @param[out] message  pointer to message
+ */
+void lsm6ds0FifoStart(I2CDriver *i2cp, const LSM6DS0_FIFO_Config *cfgp,
+                      msg_t* message) {
+  uint8_t sad;
+  msg_t msg = MSG_OK;
+
+  chDbgCheck((cfgp != NULL) && (cfgp->threshold > 0U) &&
+             (cfgp->threshold < LSM6DS0_FIFO_DEPTH));
+
+  sad = cfgp->slaveaddress;
+  update_register(i2cp, sad, LSM6DS0_SUB_CTRL_REG8, 0,
+                  LSM6DS0_CTRL_REG8_IF_ADD_INC, &msg);
+  /* Mode is changed passing through bypass mode, it also empties the FIFO.*/
+  lsm6ds0WriteRegister(i2cp, sad, LSM6DS0_SUB_FIFO_CTRL,
+                       LSM6DS0_FIFO_MODE_BYPASS, (msg == MSG_OK) ? &msg : NULL);
+  update_register(i2cp, sad, LSM6DS0_SUB_CTRL_REG9,
+                  LSM6DS0_CTRL_REG9_STOP_ON_FTH,
+                  LSM6DS0_CTRL_REG9_FIFO_EN, &msg);
+  lsm6ds0WriteRegister(i2cp, sad, LSM6DS0_SUB_FIFO_CTRL,
+                       cfgp->mode | (cfgp->threshold & LSM6DS0_FIFO_CTRL_FTH),
+                       (msg == MSG_OK) ? &msg : NULL);
+  update_register(i2cp, sad, LSM6DS0_SUB_INT_CTRL, 0,
+                  LSM6DS0_INT_CTRL_INT1_FTH, &msg);
+  if(message != NULL){
+    *message = msg;
+  }
+}
+
+/**
+ * @brief   Disables the FIFO and its threshold interrupt.
+ *
+ * @param[in] i2cp      pointer to the I2C interface
+ * @param[in] sad       slave address without R bit
+ * @param[out] message  pointer to message
+ */
+void lsm6ds0FifoStop(I2CDriver *i2cp, uint8_t sad, msg_t* message) {
+  msg_t msg = MSG_OK;
+
+  update_register(i2cp, sad, LSM6DS0_SUB_INT_CTRL,
+                  LSM6DS0_INT_CTRL_INT1_FTH, 0, &msg);
+  lsm6ds0WriteRegister(i2cp, sad, LSM6DS0_SUB_FIFO_CTRL,
+                       LSM6DS0_FIFO_MODE_BYPASS, (msg == MSG_OK) ? &msg : NULL);
+  update_register(i2cp, sad, LSM6DS0_SUB_CTRL_REG9,
+                  LSM6DS0_CTRL_REG9_FIFO_EN, 0, &msg);
+  if(message != NULL){
+    *message = msg;
+  }
+}
+
+/**
+ * @brief   Returns number of samples stored in the FIFO.
+ *
+ * @param[in] i2cp      pointer to the I2C interface
+ * @param[in] sad       slave address without R bit
+ * @param[out] message  pointer to message
+ * @return              stored samples, 0..32.
+ */
+uint8_t lsm6ds0FifoLevel(I2CDriver *i2cp, uint8_t sad, msg_t* message) {
+
+  return lsm6ds0ReadRegister(i2cp, sad, LSM6DS0_SUB_FIFO_SRC, message) &
+         LSM6DS0_FIFO_SRC_FSS;
+}
+
+/**
+ * @brief   Reads samples stored in the FIFO.
+ * @details The FIFO level is read first, then all the available samples,
+ *          up to @p n, are read by a single bus transaction directly in
+ *          the buffer. With the FIFO enabled the device rolls the address
+ *          back from the accelerometer Z output to the gyroscope X output,
+ *          so consecutive levels follow each other in one burst.
+ * @pre     Output data are little endian.
+ *
+ * @param[in] i2cp      pointer to the I2C interface
+ * @param[in] sad       slave address without R bit
+ * @param[out] buf      pointer to the samples buffer
+ * @param[in] n         buffer size in samples
+ * @param[out] message  pointer to message
+ * @return              number of samples read.
+ */
+size_t lsm6ds0FifoRead(I2CDriver *i2cp, uint8_t sad, LSM6DS0_Sample *buf,
+                       size_t n, msg_t* message) {
+  msg_t msg;
+  size_t level;
+
+  chDbgCheck((buf != NULL) && (n > 0U));
+
+  level = lsm6ds0FifoLevel(i2cp, sad, &msg);
+  if (level > n)
+    level = n;
+  if ((msg == MSG_OK) && (level > 0U)) {
+    lsm6ds0ReadRegisters(i2cp, sad, LSM6DS0_SUB_OUT_X_L_G, (uint8_t *)buf,
+                         level * LSM6DS0_SAMPLE_SIZE, &msg);
+    memsUnpackLE16((int16_t *)buf, level * 6U);
+  }
+  if(message != NULL){
+    *message = msg;
+  }
+  return (msg == MSG_OK) ? level : 0U;
+}
+
 /** @} */
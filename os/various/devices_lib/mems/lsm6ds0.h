@@ -119,8 +119,30 @@
 #define  LSM6DS0_SUB_INT_GEN_THS_ZL_G            ((uint8_t)0x36)            /*!< Gyroscope Z-axis high interrupt generator threshold registers */
 #define  LSM6DS0_SUB_INT_GEN_DUR_G               ((uint8_t)0x37)            /*!< Gyroscope interrupt generator duration register */
 
+/*******************  Bit definition for FIFO operation  **********************/
+#define  LSM6DS0_INT_CTRL_INT1_FTH               ((uint8_t)0x08)            /*!< FIFO threshold on INT1_A/G */
+#define  LSM6DS0_INT_CTRL_INT1_OVR               ((uint8_t)0x10)            /*!< FIFO overrun on INT1_A/G */
+#define  LSM6DS0_CTRL_REG8_IF_ADD_INC            ((uint8_t)0x04)            /*!< Register address incremented on multiple byte access */
+#define  LSM6DS0_CTRL_REG9_STOP_ON_FTH           ((uint8_t)0x01)            /*!< FIFO depth limited to threshold level */
+#define  LSM6DS0_CTRL_REG9_FIFO_EN               ((uint8_t)0x02)            /*!< FIFO enable */
+#define  LSM6DS0_FIFO_CTRL_FTH                   ((uint8_t)0x1F)            /*!< FTH[4:0] FIFO threshold level */
+#define  LSM6DS0_FIFO_CTRL_FMODE                 ((uint8_t)0xE0)            /*!< FMODE[2:0] FIFO mode selection */
+#define  LSM6DS0_FIFO_SRC_FSS                    ((uint8_t)0x3F)            /*!< FSS[5:0] FIFO stored data level */
+#define  LSM6DS0_FIFO_SRC_OVRN                   ((uint8_t)0x40)            /*!< FIFO overrun, all levels filled */
+#define  LSM6DS0_FIFO_SRC_FTH                    ((uint8_t)0x80)            /*!< FIFO filling reached threshold */
+
 /** @} */
 
+/**
+ * @brief   FIFO depth in samples.
+ */
+#define  LSM6DS0_FIFO_DEPTH                      32U
+
+/**
+ * @brief   Size of single gyroscope and accelerometer sample in FIFO.
+ */
+#define  LSM6DS0_SAMPLE_SIZE                     12U
+
 /*===========================================================================*/
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
@@ -457,6 +479,61 @@ typedef struct {
   LSM6DS0_BDU_t   blockdataupdate;
 } LSM6DS0_GYRO_Config;
 /** @}  */
+
+/**
+ * @name    LSM6DS0 FIFO data structures and types
+ * @{
+ */
+
+/**
+ * @brief   FIFO Mode Selection
+ */
+typedef enum {
+  LSM6DS0_FIFO_MODE_BYPASS         = 0x00,              /*!< FIFO turned off */
+  LSM6DS0_FIFO_MODE_FIFO           = 0x20,              /*!< Stops collecting data when FIFO is full */
+  LSM6DS0_FIFO_MODE_CONT_TO_FIFO   = 0x60,              /*!< Continuous until trigger, then FIFO mode */
+  LSM6DS0_FIFO_MODE_BYPASS_TO_CONT = 0x80,              /*!< Bypass until trigger, then continuous mode */
+  LSM6DS0_FIFO_MODE_CONTINUOUS     = 0xC0               /*!< Older samples overwritten when FIFO is full */
+}LSM6DS0_FIFO_MODE_t;
+
+/**
+ * @brief   Raw gyroscope and accelerometer sample.
+ * @details Layout matches a FIFO level, so FIFO content is received
+ *          directly into arrays of this type.
+ */
+typedef struct {
+  /**
+   * @brief  Gyroscope X, Y and Z raw values
+   */
+  int16_t         gyro[3];
+  /**
+   * @brief  Accelerometer X, Y and Z raw values
+   */
+  int16_t         acc[3];
+} LSM6DS0_Sample;
+
+/**
+ * @brief   FIFO configuration structure.
+ * @details Threshold event is routed to INT1_A/G pin. The application
+ *          wakes its thread from the pin interrupt and the thread calls
+ *          @p lsm6ds0FifoRead() which fetches all the stored levels by a
+ *          single bus transaction.
+ */
+typedef struct {
+  /**
+   * @brief  LSM6DS0 Slave Address
+   */
+  LSM6DS0_SAD_t   slaveaddress;
+  /**
+   * @brief  FIFO Mode
+   */
+  LSM6DS0_FIFO_MODE_t mode;
+  /**
+   * @brief  FIFO level raising INT1_A/G, 1..31 samples
+   */
+  uint8_t         threshold;
+} LSM6DS0_FIFO_Config;
+/** @}  */
 /*===========================================================================*/
 /* Driver macros.                                                            */
 /*===========================================================================*/
@@ -473,6 +550,16 @@ extern "C" {
                                  msg_t* message);
   void lsm6ds0WriteRegister(I2CDriver *i2cp, uint8_t sad, uint8_t sub,
                                  uint8_t value, msg_t* message);
+  void lsm6ds0ReadRegisters(I2CDriver *i2cp, uint8_t sad, uint8_t sub,
+                            uint8_t *rxbuf, size_t n, msg_t* message);
+  void lsm6ds0ReadRaw(I2CDriver *i2cp, uint8_t sad, LSM6DS0_Sample *sp,
+                      msg_t* message);
+  void lsm6ds0FifoStart(I2CDriver *i2cp, const LSM6DS0_FIFO_Config *cfgp,
+                        msg_t* message);
+  void lsm6ds0FifoStop(I2CDriver *i2cp, uint8_t sad, msg_t* message);
+  uint8_t lsm6ds0FifoLevel(I2CDriver *i2cp, uint8_t sad, msg_t* message);
+  size_t lsm6ds0FifoRead(I2CDriver *i2cp, uint8_t sad, LSM6DS0_Sample *buf,
+                         size_t n, msg_t* message);
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,50 @@
+/*
+    ChibiOS - Copyright (C) 2026 agent
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    mems_unpack.h
+ * @brief   Raw output conversion shared by MEMS drivers.
+ *
+ * @addtogroup mems_unpack
+ * @{
+ */
+
+#ifndef MEMS_UNPACK_H
+#define MEMS_UNPACK_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief   Converts little endian raw values received in place.
+ * @details Burst reads land in the buffer as bytes, conversion does not
+ *          depend on the CPU byte order.
+ *
+ * @param[in,out] axis  received values
+ * @param[in] n         number of values
+ */
+static inline void memsUnpackLE16(int16_t *axis, size_t n) {
+  uint8_t *p = (uint8_t *)axis;
+
+  while (n-- > 0U) {
+    *axis++ = (int16_t)((uint16_t)p[0] | ((uint16_t)p[1] << 8));
+    p += 2;
+  }
+}
+
+#endif /* MEMS_UNPACK_H */
+
+/** @} */
@@ -0,0 +1,671 @@
+/*
+    ChibiOS - Copyright (C) 2026 agent
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    nrf24l01_engine.c
+ * @brief   NRF24L01 interrupt driven packet engine code.
+ * @details The chip TX FIFO only tells whether it is empty or full, so
+ *          the payloads loaded and not yet acknowledged are counted in
+ *          @p inflight and confirmed each time the FIFO is seen empty or
+ *          full. The TX FIFO carries ACK payloads in PRX role and data
+ *          payloads in PTX role, the same accounting applies to both.
+ *
+ * @addtogroup nrf24l01
+ * @{
+ */
+
+#include <string.h>
+
+#include "ch.h"
+#include "hal.h"
+
+#include "nrf24l01_engine.h"
+
+#if !SPI_USE_WAIT
+#error "NRF24L01 engine requires SPI_USE_WAIT"
+#endif
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+#define TX_FIFO_SIZE              3U
+#define ACTIVATE_KEY              0x73U
+
+#define STATUS_FLAGS              (NRF24L01_DI_STATUS_RX_DR |               \
+                                   NRF24L01_DI_STATUS_TX_DS |               \
+                                   NRF24L01_DI_STATUS_MAX_RT)
+#define STATUS_PIPE(st)           (((st) >> 1) & 0x07U)
+#define OBSERVE_ARC_CNT(obs)      ((obs) & 0x0FU)
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Exchanges a frame, the calling thread sleeps until its end.
+ */
+static void frame(NRF24L01Engine *ep, size_t n,
+                  const uint8_t *txbuf, uint8_t *rxbuf) {
+  SPIDriver *spip = ep->config->radiocfg->spip;
+
+  spiSelect(spip);
+  spiExchange(spip, n, txbuf, rxbuf);
+  spiUnselect(spip);
+}
+
+/**
+ * @brief   Exchanges a command frame, arguments are in @p cmdtx.
+ *
+ * @return              the status register value
+ */
+static uint8_t command(NRF24L01Engine *ep, uint8_t cmd, size_t n) {
+
+  ep->cmdtx[0] = cmd;
+  frame(ep, n, ep->cmdtx, ep->cmdrx);
+  return ep->cmdrx[0];
+}
+
+static uint8_t read_reg(NRF24L01Engine *ep, uint8_t reg) {
+
+  ep->cmdtx[1] = NRF24L01_CMD_NOP;
+  (void)command(ep, NRF24L01_CMD_READ | reg, 2);
+  return ep->cmdrx[1];
+}
+
+static uint8_t write_reg(NRF24L01Engine *ep, uint8_t reg, uint8_t value) {
+
+  ep->cmdtx[1] = value;
+  return command(ep, NRF24L01_CMD_WRITE | reg, 2);
+}
+
+/**
+ * @brief   Confirms loaded payloads knowing how many are still in the FIFO.
+ */
+static void tx_confirm(NRF24L01Engine *ep, size_t remaining) {
+  size_t done;
+
+  if (remaining >= ep->inflight)
+    return;
+  done = ep->inflight - remaining;
+  ep->inflight = remaining;
+
+  osalSysLock();
+  if (ep->config->prim_rx) {
+    ep->stats.ack_payloads += done;
+  }
+  else {
+    ep->txrd = (ep->txrd + done) % NRF24L01_ENGINE_TX_DEPTH;
+    ep->txcnt -= done;
+    ep->stats.tx_packets += done;
+    osalThreadDequeueAllI(&ep->txwait, MSG_OK);
+  }
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Handles MAX_RT, the payload at the FIFO head has been dropped.
+ * @details The chip does not transmit while MAX_RT is set so the FIFO is
+ *          frozen, its occupancy is found filling it up with dummy
+ *          payloads before the flush. Payloads queued behind the failed
+ *          one are loaded again.
+ */
+static void tx_failed(NRF24L01Engine *ep) {
+  uint8_t obs = read_reg(ep, NRF24L01_AD_OBSERVE_TX);
+  size_t loaded = 0;
+
+  osalSysLock();
+  ep->stats.retries += OBSERVE_ARC_CNT(obs);
+  osalSysUnlock();
+
+  ep->cmdtx[1] = 0;
+  while ((command(ep, NRF24L01_CMD_NOP, 1) & NRF24L01_DI_STATUS_TX_FULL) == 0) {
+    (void)command(ep, NRF24L01_CMD_W_TX_PAYLOAD, 2);
+    loaded++;
+  }
+  (void)command(ep, NRF24L01_CMD_FLUSH_TX, 1);
+  tx_confirm(ep, TX_FIFO_SIZE - loaded);
+
+  osalSysLock();
+  if (ep->inflight > 0U) {
+    ep->txrd = (ep->txrd + 1U) % NRF24L01_ENGINE_TX_DEPTH;
+    ep->txcnt--;
+    ep->stats.tx_lost++;
+    osalThreadDequeueAllI(&ep->txwait, MSG_OK);
+  }
+  osalSysUnlock();
+  ep->txhw = ep->txrd;
+  ep->inflight = 0;
+}
+
+/**
+ * @brief   Moves received payloads to the pipe queues.
+ * @details Payloads are read by DMA straight into the queue slot.
+ */
+static void rx_drain(NRF24L01Engine *ep) {
+
+  while (true) {
+    nrf24l01_slot_t *sp = NULL;
+    uint8_t st, pipe, wid;
+
+    ep->cmdtx[1] = NRF24L01_CMD_NOP;
+    st = command(ep, NRF24L01_CMD_R_RX_PL_WID, 2);
+    wid = ep->cmdrx[1];
+    pipe = STATUS_PIPE(st);
+    if (pipe >= NRF24L01_PIPES)
+      return;
+    if ((0U == wid) || (wid > NRF24L01_MAX_PL_LENGHT)) {
+      /* Corrupted payload width, the datasheet requires a flush.*/
+      (void)command(ep, NRF24L01_CMD_FLUSH_RX, 1);
+      osalSysLock();
+      ep->stats.rx_errors++;
+      osalSysUnlock();
+      return;
+    }
+
+    osalSysLock();
+    if (ep->rxcnt[pipe] < NRF24L01_ENGINE_RX_DEPTH)
+      sp = &ep->rx[pipe][(ep->rxrd[pipe] + ep->rxcnt[pipe]) %
+                         NRF24L01_ENGINE_RX_DEPTH];
+    osalSysUnlock();
+
+    ep->cmdtx[0] = NRF24L01_CMD_R_RX_PAYLOAD;
+    frame(ep, wid + 1U, ep->cmdtx, (NULL != sp) ? sp->frame : ep->cmdrx);
+
+    osalSysLock();
+    if (NULL != sp) {
+      sp->len = wid;
+      ep->rxcnt[pipe]++;
+      ep->stats.rx_packets++;
+      osalThreadDequeueNextI(&ep->rxwait[pipe], MSG_OK);
+    }
+    else {
+      ep->stats.rx_overruns++;
+    }
+    osalSysUnlock();
+  }
+}
+
+/**
+ * @brief   Loads payloads in the TX FIFO.
+ * @details In streaming mode the FIFO is filled up, otherwise a payload is
+ *          loaded only when the previous one has been confirmed.
+ */
+static void tx_fill(NRF24L01Engine *ep) {
+  const NRF24L01EngineConfig *cfg = ep->config;
+  uint8_t st = command(ep, NRF24L01_CMD_NOP, 1);
+
+  while (true) {
+    nrf24l01_slot_t *sp;
+    uint8_t pipe = 0;
+
+    if ((st & NRF24L01_DI_STATUS_TX_FULL) != 0U) {
+      tx_confirm(ep, TX_FIFO_SIZE);
+      return;
+    }
+    if (!cfg->streaming && (ep->inflight > 0U))
+      return;
+
+    osalSysLock();
+    if (cfg->prim_rx) {
+      while ((pipe < NRF24L01_PIPES) && ((ep->ackpending & (1U << pipe)) == 0U))
+        pipe++;
+      sp = (pipe < NRF24L01_PIPES) ? &ep->ack[pipe] : NULL;
+    }
+    else {
+      sp = (ep->txcnt > ep->inflight) ? &ep->tx[ep->txhw] : NULL;
+    }
+    osalSysUnlock();
+    if (NULL == sp)
+      return;
+
+    frame(ep, sp->len + 1U, sp->frame, ep->cmdrx);
+    if (!cfg->prim_rx)
+      ep->txhw = (ep->txhw + 1U) % NRF24L01_ENGINE_TX_DEPTH;
+    ep->inflight++;
+    if (cfg->prim_rx) {
+      osalSysLock();
+      ep->ackpending &= (uint8_t)~(1U << pipe);
+      osalSysUnlock();
+    }
+    st = command(ep, NRF24L01_CMD_NOP, 1);
+  }
+}
+
+/**
+ * @brief   Serves the chip, called by the worker on each wakeup.
+ */
+static void service(NRF24L01Engine *ep) {
+  uint8_t st = command(ep, NRF24L01_CMD_NOP, 1);
+
+  /* MAX_RT is handled before being cleared, clearing it resumes the
+     transmission of the failed payload.*/
+  if ((st & NRF24L01_DI_STATUS_MAX_RT) != 0U)
+    tx_failed(ep);
+  if ((st & STATUS_FLAGS) != 0U)
+    (void)write_reg(ep, NRF24L01_AD_STATUS, st & STATUS_FLAGS);
+
+  if (((st & NRF24L01_DI_STATUS_TX_DS) != 0U) && !ep->config->prim_rx) {
+    uint8_t obs = read_reg(ep, NRF24L01_AD_OBSERVE_TX);
+
+    osalSysLock();
+    ep->stats.retries += OBSERVE_ARC_CNT(obs);
+    osalSysUnlock();
+  }
+  if ((read_reg(ep, NRF24L01_AD_FIFO_STATUS) &
+       NRF24L01_DI_FIFO_STATUS_TX_EMPTY) != 0U)
+    tx_confirm(ep, 0);
+
+  rx_drain(ep);
+  tx_fill(ep);
+}
+
+/**
+ * @brief   Updates packet rates at the end of each window.
+ */
+static void rate_update(NRF24L01Engine *ep) {
+  systime_t now = osalOsGetSystemTimeX();
+  sysinterval_t elapsed = osalTimeDiffX(ep->rate_start, now);
+  uint32_t ms;
+
+  if (elapsed < NRF24L01_ENGINE_RATE_WINDOW)
+    return;
+  ms = (uint32_t)TIME_I2MS(elapsed);
+
+  osalSysLock();
+  ep->stats.tx_rate = (uint32_t)(((uint64_t)(ep->stats.tx_packets -
+                                             ep->rate_tx) * 1000U) / ms);
+  ep->stats.rx_rate = (uint32_t)(((uint64_t)(ep->stats.rx_packets -
+                                             ep->rate_rx) * 1000U) / ms);
+  ep->rate_tx = ep->stats.tx_packets;
+  ep->rate_rx = ep->stats.rx_packets;
+  osalSysUnlock();
+  ep->rate_start = now;
+}
+
+static THD_FUNCTION(engine_thread, arg) {
+  NRF24L01Engine *ep = (NRF24L01Engine *)arg;
+  SPIDriver *spip = ep->config->radiocfg->spip;
+
+  chRegSetThreadName("nrf24l01");
+  while (!chThdShouldTerminateX()) {
+    (void)chBSemWaitTimeout(&ep->wakeup, NRF24L01_ENGINE_POLL_INTERVAL);
+#if SPI_USE_MUTUAL_EXCLUSION
+    spiAcquireBus(spip);
+#endif
+    service(ep);
+#if SPI_USE_MUTUAL_EXCLUSION
+    spiReleaseBus(spip);
+#endif
+    rate_update(ep);
+  }
+}
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes an instance.
+ *
+ * @param[out] ep       pointer to the @p NRF24L01Engine object
+ *
+ * @init
+ */
+void nrf24l01EngineObjectInit(NRF24L01Engine *ep) {
+  size_t i;
+
+  osalDbgCheck(NULL != ep);
+
+  ep->state = NRF24L01_ENGINE_STOP;
+  ep->config = NULL;
+  ep->worker = NULL;
+  chBSemObjectInit(&ep->wakeup, true);
+  osalThreadQueueObjectInit(&ep->txwait);
+  for (i = 0; i < NRF24L01_PIPES; i++)
+    osalThreadQueueObjectInit(&ep->rxwait[i]);
+  memset(ep->cmdtx, NRF24L01_CMD_NOP, sizeof(ep->cmdtx));
+}
+
+/**
+ * @brief   Configures the transceiver and starts the worker.
+ * @details The application IRQ line callback must call
+ *          @p nrf24l01EngineIrqI().
+ * @pre     In PTX role pipe 0 must be enabled, ACKs come on it.
+ * @note    Buffers of the object are used by DMA, it must be allocated in
+ *          DMA capable memory.
+ *
+ * @param[in] ep        pointer to the @p NRF24L01Engine object
+ * @param[in] config    pointer to the @p NRF24L01EngineConfig object
+ *
+ * @api
+ */
+void nrf24l01EngineStart(NRF24L01Engine *ep,
+                         const NRF24L01EngineConfig *config) {
+  const NRF24L01_Config *rcp;
+  uint8_t feature, addrlen, i;
+
+  osalDbgCheck((NULL != ep) && (NULL != config) &&
+               (NULL != config->radiocfg) && (NULL != config->address));
+  osalDbgAssert(NRF24L01_ENGINE_STOP == ep->state, "invalid state");
+  osalDbgAssert(config->prim_rx || ((config->pipes & NRF24L01_DI_EN_RXADDR_P0) != 0U),
+                "PTX requires pipe 0");
+
+  ep->config = config;
+  rcp = config->radiocfg;
+  ep->txrd = 0;
+  ep->txhw = 0;
+  ep->txwr = 0;
+  ep->txcnt = 0;
+  ep->inflight = 0;
+  for (i = 0; i < NRF24L01_PIPES; i++) {
+    ep->rxrd[i] = 0;
+    ep->rxcnt[i] = 0;
+  }
+  ep->ackpending = 0;
+  memset(&ep->stats, 0, sizeof(ep->stats));
+  ep->rate_tx = 0;
+  ep->rate_rx = 0;
+
+  spiStart(rcp->spip, rcp->spicfg);
+#if SPI_USE_MUTUAL_EXCLUSION
+  spiAcquireBus(rcp->spip);
+#endif
+  palClearPad(rcp->ceport, rcp->cepad);
+  (void)write_reg(ep, NRF24L01_AD_CONFIG, 0);
+  (void)write_reg(ep, NRF24L01_AD_SETUP_AW, rcp->address_width);
+  (void)write_reg(ep, NRF24L01_AD_SETUP_RETR,
+                  rcp->auto_retr_delay | rcp->auto_retr_count);
+  (void)write_reg(ep, NRF24L01_AD_RF_CH, rcp->channel_freq);
+  (void)write_reg(ep, NRF24L01_AD_RF_SETUP,
+                  rcp->data_rate | rcp->out_pwr | rcp->lna);
+
+  /* Dynamic payload length is always used, the plain nRF24L01 needs
+     ACTIVATE before the feature register can be written.*/
+  feature = NRF24L01_DI_FEATURE_EN_DPL | rcp->en_ack_pay | rcp->en_dyn_ack;
+  (void)write_reg(ep, NRF24L01_AD_FEATURE, feature);
+  if (read_reg(ep, NRF24L01_AD_FEATURE) != feature) {
+    ep->cmdtx[1] = ACTIVATE_KEY;
+    (void)command(ep, NRF24L01_CMD_ACTIVATE, 2);
+    (void)write_reg(ep, NRF24L01_AD_FEATURE, feature);
+  }
+  (void)write_reg(ep, NRF24L01_AD_DYNPD, config->pipes);
+  (void)write_reg(ep, NRF24L01_AD_EN_AA, config->pipes);
+  (void)write_reg(ep, NRF24L01_AD_EN_RXADDR, config->pipes);
+
+  addrlen = (uint8_t)(rcp->address_width + 2U);
+  memcpy(&ep->cmdtx[1], config->address, addrlen);
+  (void)command(ep, NRF24L01_CMD_WRITE | NRF24L01_AD_RX_ADDR_P0, addrlen + 1U);
+  if (!config->prim_rx) {
+    memcpy(&ep->cmdtx[1], config->address, addrlen);
+    (void)command(ep, NRF24L01_CMD_WRITE | NRF24L01_AD_TX_ADDR, addrlen + 1U);
+  }
+
+  (void)command(ep, NRF24L01_CMD_FLUSH_TX, 1);
+  (void)command(ep, NRF24L01_CMD_FLUSH_RX, 1);
+  (void)write_reg(ep, NRF24L01_AD_STATUS, STATUS_FLAGS);
+  (void)write_reg(ep, NRF24L01_AD_CONFIG,
+                  NRF24L01_DI_CONFIG_EN_CRC | NRF24L01_DI_CONFIG_CRCO |
+                  NRF24L01_DI_CONFIG_PWR_UP |
+                  (config->prim_rx ? NRF24L01_DI_CONFIG_PRIM_RX : 0U));
+#if SPI_USE_MUTUAL_EXCLUSION
+  spiReleaseBus(rcp->spip);
+#endif
+
+  /* Power up to standby takes 1.5ms, CE then stays high: the chip sits in
+     standby-II whenever the TX FIFO is empty.*/
+  osalThreadSleepMilliseconds(2);
+  palSetPad(rcp->ceport, rcp->cepad);
+
+  ep->rate_start = osalOsGetSystemTimeX();
+  ep->state = NRF24L01_ENGINE_ACTIVE;
+  ep->worker = chThdCreateStatic(ep->wa, sizeof(ep->wa),
+                                 NRF24L01_ENGINE_THD_PRIO, engine_thread, ep);
+}
+
+/**
+ * @brief   Stops the worker and powers the transceiver down.
+ * @details Threads waiting on the queues are released with @p MSG_RESET.
+ *
+ * @param[in] ep        pointer to the @p NRF24L01Engine object
+ *
+ * @api
+ */
+void nrf24l01EngineStop(NRF24L01Engine *ep) {
+  const NRF24L01_Config *rcp;
+  size_t i;
+
+  osalDbgCheck(NULL != ep);
+  osalDbgAssert((NRF24L01_ENGINE_STOP == ep->state) ||
+                (NRF24L01_ENGINE_ACTIVE == ep->state), "invalid state");
+
+  if (NRF24L01_ENGINE_ACTIVE != ep->state)
+    return;
+  rcp = ep->config->radiocfg;
+
+  chThdTerminate(ep->worker);
+  chBSemSignal(&ep->wakeup);
+  (void)chThdWait(ep->worker);
+  ep->worker = NULL;
+
+  palClearPad(rcp->ceport, rcp->cepad);
+#if SPI_USE_MUTUAL_EXCLUSION
+  spiAcquireBus(rcp->spip);
+#endif
+  (void)write_reg(ep, NRF24L01_AD_CONFIG, NRF24L01_DI_CONFIG_EN_CRC);
+#if SPI_USE_MUTUAL_EXCLUSION
+  spiReleaseBus(rcp->spip);
+#endif
+
+  osalSysLock();
+  ep->state = NRF24L01_ENGINE_STOP;
+  osalThreadDequeueAllI(&ep->txwait, MSG_RESET);
+  for (i = 0; i < NRF24L01_PIPES; i++)
+    osalThreadDequeueAllI(&ep->rxwait[i], MSG_RESET);
+  osalOsRescheduleS();
+  osalSysUnlock();
+}
+
+/**
+ * @brief   IRQ line notification.
+ * @details To be called from the IRQ line (falling edge) callback.
+ *
+ * @param[in] ep        pointer to the @p NRF24L01Engine object
+ *
+ * @iclass
+ */
+void nrf24l01EngineIrqI(NRF24L01Engine *ep) {
+
+  osalDbgCheckClassI();
+  osalDbgCheck(NULL != ep);
+
+  ep->stats.irqs++;
+  chBSemSignalI(&ep->wakeup);
+}
+
+/**
+ * @brief   Queues a payload for transmission, PTX role.
+ *
+ * @param[in] ep        pointer to the @p NRF24L01Engine object
+ * @param[in] buf       payload
+ * @param[in] n         payload length, up to @p NRF24L01_MAX_PL_LENGHT
+ * @param[in] timeout   time to wait for space in the TX queue
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the payload has been queued.
+ * @retval MSG_TIMEOUT  if the queue stayed full.
+ * @retval MSG_RESET    if the engine is stopped.
+ *
+ * @api
+ */
+msg_t nrf24l01EngineSend(NRF24L01Engine *ep, const uint8_t *buf,
+                         size_t n, sysinterval_t timeout) {
+  nrf24l01_slot_t *sp;
+
+  osalDbgCheck((NULL != ep) && (NULL != buf) &&
+               (n > 0U) && (n <= NRF24L01_MAX_PL_LENGHT));
+
+  osalSysLock();
+  while ((NRF24L01_ENGINE_ACTIVE == ep->state) &&
+         (ep->txcnt >= NRF24L01_ENGINE_TX_DEPTH)) {
+    msg_t msg = osalThreadEnqueueTimeoutS(&ep->txwait, timeout);
+
+    if (MSG_OK != msg) {
+      osalSysUnlock();
+      return msg;
+    }
+  }
+  if (NRF24L01_ENGINE_ACTIVE != ep->state) {
+    osalSysUnlock();
+    return MSG_RESET;
+  }
+  osalDbgAssert(!ep->config->prim_rx, "PTX role only");
+
+  sp = &ep->tx[ep->txwr];
+  sp->len = (uint8_t)n;
+  sp->frame[0] = NRF24L01_CMD_W_TX_PAYLOAD;
+  memcpy(&sp->frame[1], buf, n);
+  ep->txwr = (ep->txwr + 1U) % NRF24L01_ENGINE_TX_DEPTH;
+  ep->txcnt++;
+  chBSemSignalI(&ep->wakeup);
+  osalOsRescheduleS();
+  osalSysUnlock();
+
+  return MSG_OK;
+}
+
+/**
+ * @brief   Gets a received payload from a pipe queue.
+ *
+ * @param[in] ep        pointer to the @p NRF24L01Engine object
+ * @param[in] pipe      data pipe
+ * @param[out] buf      payload buffer, @p NRF24L01_MAX_PL_LENGHT bytes
+ * @param[out] np       payload length
+ * @param[in] timeout   time to wait for a payload
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if a payload has been returned.
+ * @retval MSG_TIMEOUT  if no payload came.
+ * @retval MSG_RESET    if the engine is stopped.
+ *
+ * @api
+ */
+msg_t nrf24l01EngineReceive(NRF24L01Engine *ep, uint8_t pipe,
+                            uint8_t *buf, size_t *np,
+                            sysinterval_t timeout) {
+  nrf24l01_slot_t *sp;
+
+  osalDbgCheck((NULL != ep) && (pipe < NRF24L01_PIPES) &&
+               (NULL != buf) && (NULL != np));
+
+  osalSysLock();
+  while (0U == ep->rxcnt[pipe]) {
+    msg_t msg;
+
+    if (NRF24L01_ENGINE_ACTIVE != ep->state) {
+      osalSysUnlock();
+      return MSG_RESET;
+    }
+    msg = osalThreadEnqueueTimeoutS(&ep->rxwait[pipe], timeout);
+    if (MSG_OK != msg) {
+      osalSysUnlock();
+      return msg;
+    }
+  }
+  sp = &ep->rx[pipe][ep->rxrd[pipe]];
+  memcpy(buf, &sp->frame[1], sp->len);
+  *np = sp->len;
+  ep->rxrd[pipe] = (ep->rxrd[pipe] + 1U) % NRF24L01_ENGINE_RX_DEPTH;
+  ep->rxcnt[pipe]--;
+  osalSysUnlock();
+
+  return MSG_OK;
+}
+
+/**
+ * @brief   Sets the payload sent with the next ACK on a pipe, PRX role.
+ * @note    Requires @p NRF24L01_ACK_PAY_enabled in the radio configuration.
+ *
+ * @param[in] ep        pointer to the @p NRF24L01Engine object
+ * @param[in] pipe      data pipe
+ * @param[in] buf       payload
+ * @param[in] n         payload length, up to @p NRF24L01_MAX_PL_LENGHT
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the payload has been accepted.
+ * @retval MSG_TIMEOUT  if the previous payload of the pipe has not been
+ *                      loaded in the chip yet.
+ * @retval MSG_RESET    if the engine is stopped.
+ *
+ * @api
+ */
+msg_t nrf24l01EngineSetAckPayload(NRF24L01Engine *ep, uint8_t pipe,
+                                  const uint8_t *buf, size_t n) {
+  nrf24l01_slot_t *sp;
+
+  osalDbgCheck((NULL != ep) && (pipe < NRF24L01_PIPES) && (NULL != buf) &&
+               (n > 0U) && (n <= NRF24L01_MAX_PL_LENGHT));
+
+  osalSysLock();
+  if (NRF24L01_ENGINE_ACTIVE != ep->state) {
+    osalSysUnlock();
+    return MSG_RESET;
+  }
+  osalDbgAssert(ep->config->prim_rx, "PRX role only");
+  if ((ep->ackpending & (1U << pipe)) != 0U) {
+    osalSysUnlock();
+    return MSG_TIMEOUT;
+  }
+
+  sp = &ep->ack[pipe];
+  sp->len = (uint8_t)n;
+  sp->frame[0] = (uint8_t)(NRF24L01_CMD_W_ACK_PAYLOAD | pipe);
+  memcpy(&sp->frame[1], buf, n);
+  ep->ackpending |= (uint8_t)(1U << pipe);
+  chBSemSignalI(&ep->wakeup);
+  osalOsRescheduleS();
+  osalSysUnlock();
+
+  return MSG_OK;
+}
+
+/**
+ * @brief   Gets a snapshot of the statistics.
+ *
+ * @param[in] ep        pointer to the @p NRF24L01Engine object
+ * @param[out] statsp   pointer to the statistics structure
+ *
+ * @api
+ */
+void nrf24l01EngineGetStats(NRF24L01Engine *ep,
+                            nrf24l01_engine_stats_t *statsp) {
+
+  osalDbgCheck((NULL != ep) && (NULL != statsp));
+
+  osalSysLock();
+  *statsp = ep->stats;
+  osalSysUnlock();
+}
+
+/** @} */
@@ -0,0 +1,331 @@
+/*
+    ChibiOS - Copyright (C) 2026 agent
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    nrf24l01_engine.h
+ * @brief   NRF24L01 interrupt driven packet engine header.
+ * @details The engine owns the transceiver once started: a worker thread,
+ *          woken by the IRQ line, moves payloads between the chip FIFOs
+ *          and a TX queue plus one RX queue per data pipe. SPI frames are
+ *          exchanged with @p spiExchange() directly from and to the queue
+ *          slots.
+ *
+ * @addtogroup nrf24l01
+ * @{
+ */
+
+#ifndef _NRF24L01_ENGINE_H_
+#define _NRF24L01_ENGINE_H_
+
+#include "nrf24l01.h"
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Number of data pipes.
+ */
+#define NRF24L01_PIPES                          6U
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @name    NRF24L01 engine configuration options
+ * @{
+ */
+/**
+ * @brief   TX queue depth in payloads.
+ * @note    Payloads loaded in the chip FIFO and not yet acknowledged keep
+ *          their slot, the queue must be deeper than the chip FIFO.
+ */
+#if !defined(NRF24L01_ENGINE_TX_DEPTH) || defined(__DOXYGEN__)
+#define NRF24L01_ENGINE_TX_DEPTH                8U
+#endif
+
+/**
+ * @brief   RX queue depth in payloads, for each data pipe.
+ */
+#if !defined(NRF24L01_ENGINE_RX_DEPTH) || defined(__DOXYGEN__)
+#define NRF24L01_ENGINE_RX_DEPTH                4U
+#endif
+
+/**
+ * @brief   Interval of status polling when no IRQ comes.
+ * @details Recovers from an edge lost while the IRQ line was still low.
+ */
+#if !defined(NRF24L01_ENGINE_POLL_INTERVAL) || defined(__DOXYGEN__)
+#define NRF24L01_ENGINE_POLL_INTERVAL           TIME_MS2I(10)
+#endif
+
+/**
+ * @brief   Window of the packet rate measurement.
+ */
+#if !defined(NRF24L01_ENGINE_RATE_WINDOW) || defined(__DOXYGEN__)
+#define NRF24L01_ENGINE_RATE_WINDOW             TIME_MS2I(1000)
+#endif
+
+/**
+ * @brief   Worker thread priority.
+ */
+#if !defined(NRF24L01_ENGINE_THD_PRIO) || defined(__DOXYGEN__)
+#define NRF24L01_ENGINE_THD_PRIO                (NORMALPRIO + 2)
+#endif
+
+/**
+ * @brief   Worker thread working area size.
+ */
+#if !defined(NRF24L01_ENGINE_THD_WA_SIZE) || defined(__DOXYGEN__)
+#define NRF24L01_ENGINE_THD_WA_SIZE             256
+#endif
+/** @} */
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if !NRF24L01_USE_FEATURE
+#error "NRF24L01 engine requires NRF24L01_USE_FEATURE"
+#endif
+
+#if NRF24L01_ENGINE_TX_DEPTH < 4U
+#error "NRF24L01_ENGINE_TX_DEPTH must hold at least the chip FIFO plus one"
+#endif
+
+#if NRF24L01_ENGINE_RX_DEPTH < 1U
+#error "invalid NRF24L01_ENGINE_RX_DEPTH value"
+#endif
+
+#if !CH_CFG_USE_WAITEXIT
+#error "NRF24L01 engine requires CH_CFG_USE_WAITEXIT"
+#endif
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Engine state machine possible states.
+ */
+typedef enum {
+  NRF24L01_ENGINE_UNINIT = 0,               /**< Not initialized.           */
+  NRF24L01_ENGINE_STOP = 1,                 /**< Stopped.                   */
+  NRF24L01_ENGINE_ACTIVE = 2                /**< Worker running.            */
+} nrf24l01_engine_state_t;
+
+/**
+ * @brief   Queue slot.
+ * @details @p frame is the SPI frame: byte zero carries the command on the
+ *          way out and the chip status on the way in, the payload follows.
+ */
+typedef struct {
+  /**
+   * @brief Payload length.
+   */
+  uint8_t                   len;
+  /**
+   * @brief SPI frame.
+   */
+  uint8_t                   frame[NRF24L01_MAX_PL_LENGHT + 1];
+} nrf24l01_slot_t;
+
+/**
+ * @brief   Engine statistics.
+ */
+typedef struct {
+  /**
+   * @brief Payloads acknowledged by the receiver, or sent without ACK.
+   */
+  uint32_t                  tx_packets;
+  /**
+   * @brief Payloads dropped after the auto retransmit count ran out.
+   */
+  uint32_t                  tx_lost;
+  /**
+   * @brief Retransmissions, from the ARC_CNT field of OBSERVE_TX.
+   * @note  Exact in packet mode. In streaming mode the chip starts the next
+   *        payload before the worker samples the counter, so this is a
+   *        lower bound.
+   */
+  uint32_t                  retries;
+  /**
+   * @brief ACK payloads delivered, PRX role.
+   */
+  uint32_t                  ack_payloads;
+  /**
+   * @brief Payloads received.
+   */
+  uint32_t                  rx_packets;
+  /**
+   * @brief Payloads dropped because their RX queue was full.
+   */
+  uint32_t                  rx_overruns;
+  /**
+   * @brief Invalid payload widths, the chip RX FIFO was flushed.
+   */
+  uint32_t                  rx_errors;
+  /**
+   * @brief IRQ notifications.
+   */
+  uint32_t                  irqs;
+  /**
+   * @brief Transmitted packets per second over the last rate window.
+   */
+  uint32_t                  tx_rate;
+  /**
+   * @brief Received packets per second over the last rate window.
+   */
+  uint32_t                  rx_rate;
+} nrf24l01_engine_stats_t;
+
+/**
+ * @brief   Engine configuration structure.
+ */
+typedef struct {
+  /**
+   * @brief Transceiver configuration.
+   */
+  const NRF24L01_Config     *radiocfg;
+  /**
+   * @brief Primary receiver role, primary transmitter otherwise.
+   */
+  bool                      prim_rx;
+  /**
+   * @brief Streaming mode, PTX role.
+   * @details The TX FIFO is kept full and payloads are chained back to
+   *          back. Otherwise one payload at a time is loaded, which makes
+   *          the retry statistics exact.
+   */
+  bool                      streaming;
+  /**
+   * @brief Enabled data pipes mask, auto ACK and dynamic payload length
+   *        are enabled on the same pipes.
+   */
+  uint8_t                   pipes;
+  /**
+   * @brief Pipe 0 address, also used as TX address in PTX role.
+   * @note  Addresses of pipes 1 to 5 are written with
+   *        @p nrf24l01WriteAddress() before starting the engine.
+   */
+  const uint8_t             *address;
+} NRF24L01EngineConfig;
+
+/**
+ * @brief   Structure representing a packet engine.
+ */
+typedef struct {
+  /**
+   * @brief Driver state.
+   */
+  nrf24l01_engine_state_t   state;
+  /**
+   * @brief Current configuration data.
+   */
+  const NRF24L01EngineConfig *config;
+  /**
+   * @brief Worker wakeup, signaled by the IRQ and by producers.
+   */
+  binary_semaphore_t        wakeup;
+  /**
+   * @brief Worker thread.
+   */
+  thread_t                  *worker;
+  /**
+   * @brief Threads waiting for TX queue space.
+   */
+  threads_queue_t           txwait;
+  /**
+   * @brief Threads waiting for received payloads.
+   */
+  threads_queue_t           rxwait[NRF24L01_PIPES];
+  /**
+   * @brief TX queue, slots from @p txrd to @p txhw are in the chip FIFO.
+   */
+  nrf24l01_slot_t           tx[NRF24L01_ENGINE_TX_DEPTH];
+  size_t                    txrd;
+  size_t                    txhw;
+  size_t                    txwr;
+  size_t                    txcnt;
+  /**
+   * @brief Payloads loaded in the chip TX FIFO and not yet confirmed.
+   */
+  size_t                    inflight;
+  /**
+   * @brief Per pipe RX queues.
+   */
+  nrf24l01_slot_t           rx[NRF24L01_PIPES][NRF24L01_ENGINE_RX_DEPTH];
+  size_t                    rxrd[NRF24L01_PIPES];
+  size_t                    rxcnt[NRF24L01_PIPES];
+  /**
+   * @brief Pending ACK payloads, one for each pipe, PRX role.
+   */
+  nrf24l01_slot_t           ack[NRF24L01_PIPES];
+  uint8_t                   ackpending;
+  /**
+   * @brief Short command frames.
+   */
+  uint8_t                   cmdtx[NRF24L01_MAX_PL_LENGHT + 1];
+  uint8_t                   cmdrx[NRF24L01_MAX_PL_LENGHT + 1];
+  /**
+   * @brief Statistics.
+   */
+  nrf24l01_engine_stats_t   stats;
+  /**
+   * @brief Rate window start and counters at that time.
+   */
+  systime_t                 rate_start;
+  uint32_t                  rate_tx;
+  uint32_t                  rate_rx;
+  /**
+   * @brief Worker working area.
+   */
+  THD_WORKING_AREA(wa, NRF24L01_ENGINE_THD_WA_SIZE);
+} NRF24L01Engine;
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void nrf24l01EngineObjectInit(NRF24L01Engine *ep);
+  void nrf24l01EngineStart(NRF24L01Engine *ep,
+                           const NRF24L01EngineConfig *config);
+  void nrf24l01EngineStop(NRF24L01Engine *ep);
+  void nrf24l01EngineIrqI(NRF24L01Engine *ep);
+  msg_t nrf24l01EngineSend(NRF24L01Engine *ep, const uint8_t *buf,
+                           size_t n, sysinterval_t timeout);
+  msg_t nrf24l01EngineReceive(NRF24L01Engine *ep, uint8_t pipe,
+                              uint8_t *buf, size_t *np,
+                              sysinterval_t timeout);
+  msg_t nrf24l01EngineSetAckPayload(NRF24L01Engine *ep, uint8_t pipe,
+                                    const uint8_t *buf, size_t n);
+  void nrf24l01EngineGetStats(NRF24L01Engine *ep,
+                              nrf24l01_engine_stats_t *statsp);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _NRF24L01_ENGINE_H_ */
+
+/** @} */
@@ -0,0 +1,466 @@
+/*
+    ChibiOS/RT - Copyright (C) 2026 agent
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/*===========================================================================*/
+/* Main ideas:                                                               */
+/*===========================================================================
+
+Instead of convert-and-wait cycle for every sensor the whole network
+is handled in single sweep:
+
+1) configuration changes (resolution, alarm thresholds) are written to
+   devices addressed by cached ROM codes, only for devices having them.
+2) one SKIP ROM + CONVERT T starts conversion on all devices at once.
+3) bus is polled (or strong pull up is held) until the slowest device
+   finished. Conversion time depends on the highest configured resolution.
+4) scratchpads are read device by device and checked against CRC. Devices
+   failed to deliver valid scratchpad are retried in subsequent passes,
+   devices already read are never touched again in this sweep.
+
+So full sweep takes single conversion period plus ~10 ms of bus traffic
+per device regardless of devices count.
+*/
+
+/**
+ * @file    ds18b20.c
+ * @brief   DS18B20 1-wire temperature sensor network manager.
+ *
+ * @addtogroup ds18b20
+ * @{
+ */
+
+#include <string.h>
+
+#include "ds18b20.h"
+
+#if (HAL_USE_ONEWIRE == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+/**
+ * @brief   Power-on reset value of temperature register.
+ * @note    It is a valid 85 C reading as well, see @p is_power_on().
+ */
+#define DS18B20_POWER_ON_RAW          0x0550
+#define DS18S20_POWER_ON_RAW          0x00AA
+#define DS18B20_POWER_ON_TEMP         85000
+
+/**
+ * @brief   Extra time given to conversion before declaring timeout.
+ */
+#define DS18B20_CONVERSION_MARGIN(ms) ((ms) / 4U)
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+/**
+ * @brief   Returns family code of device @p i.
+ */
+static uint8_t family(const ds18b20Net *netp, size_t i) {
+
+  return ds18b20GetRom(netp, i)[0];
+}
+
+/**
+ * @brief   Resets bus and addresses single device followed by command.
+ *
+ * @return              Bool flag denoting device presence.
+ */
+static bool match_rom(ds18b20Net *netp, size_t i,
+                      const uint8_t *cmd, size_t cmdlen) {
+  uint8_t buf[1 + 8 + 4];
+
+  osalDbgCheck(cmdlen <= 4);
+
+  if (false == onewireReset(netp->owp))
+    return false;
+
+  buf[0] = ONEWIRE_CMD_MATCH_ROM;
+  memcpy(&buf[1], ds18b20GetRom(netp, i), 8);
+  memcpy(&buf[9], cmd, cmdlen);
+  onewireWrite(netp->owp, buf, 9 + cmdlen, 0);
+  return true;
+}
+
+/**
+ * @brief   Reads and validates scratchpad of device @p i.
+ *
+ * @return              Bool flag denoting valid scratchpad.
+ */
+static bool read_scratchpad(ds18b20Net *netp, size_t i, uint8_t *sp) {
+  const uint8_t cmd = ONEWIRE_CMD_READ_SCRATCHPAD;
+  size_t k;
+  uint8_t acc_or = 0, acc_and = 0xFF;
+
+  if (false == match_rom(netp, i, &cmd, 1))
+    return false;
+
+  onewireRead(netp->owp, sp, DS18B20_SCRATCHPAD_LEN);
+  netp->reads++;
+
+  /* Shorted bus reads as zeroes which pass CRC check, released bus
+     reads as all ones. Both mean no answer from device.*/
+  for (k = 0; k < DS18B20_SCRATCHPAD_LEN; k++) {
+    acc_or |= sp[k];
+    acc_and &= sp[k];
+  }
+  if ((0 == acc_or) || (0xFF == acc_and) ||
+      (sp[8] != onewireCRC(sp, 8))) {
+    netp->crc_errors++;
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief   Tells a power-on reset value from a real 85 C reading.
+ * @details The reset value is only trusted when the rest of the scratchpad
+ *          agrees: either the configuration reverted to something else than
+ *          was written, or the DS18B20 COUNT REMAIN byte still holds its
+ *          reset value 0x0C (a real 85 C conversion leaves 0x10 there).
+ *          The DS18S20 COUNT REMAIN reads 0x0C at 85 C too, so there only the
+ *          configuration can tell. A reset value dropped in the previous
+ *          sweep is accepted as real reading when it shows up again, a device
+ *          resetting during two conversions in a row is far less likely.
+ *          It is accepted as well when the last valid reading was 85 C.
+ * @note    A real 85 C reading is dropped once from a DS18S20, or from a
+ *          clone not emulating COUNT REMAIN, if the configuration written
+ *          matches its EEPROM content.
+ */
+static bool is_power_on(const ds18b20Net *netp, size_t i, const uint8_t *sp) {
+  const ds18b20dev_t *dp = &netp->dev[i];
+  int16_t raw = (int16_t)(sp[0] | (sp[1] << 8));
+  bool s20 = (DS18B20_FAMILY_DS18S20 == family(netp, i));
+
+  if (raw != (s20 ? DS18S20_POWER_ON_RAW : DS18B20_POWER_ON_RAW))
+    return false;
+
+  if ((0 != (dp->flags & DS18B20_FLAG_POWER_ON_SEEN)) ||
+      (DS18B20_POWER_ON_TEMP == dp->temperature))
+    return false;
+
+  if ((0 == (dp->flags & DS18B20_FLAG_DIRTY)) &&
+      (((int8_t)sp[2] != dp->th) || ((int8_t)sp[3] != dp->tl) ||
+       (!s20 && ((9U + ((sp[4] >> 5) & 3U)) != dp->resolution))))
+    return true;
+
+  if (s20)
+    return true;
+
+  return (0xFF == sp[5]) && (0x0C == sp[6]) && (0x10 == sp[7]);
+}
+
+/**
+ * @brief   Stores scratchpad content into device state.
+ */
+static void decode(ds18b20Net *netp, size_t i, const uint8_t *sp) {
+  ds18b20dev_t *dp = &netp->dev[i];
+  int16_t raw = (int16_t)(sp[0] | (sp[1] << 8));
+
+  if (true == is_power_on(netp, i, sp)) {
+    /* Device was reset, volatile configuration is lost too.*/
+    dp->flags |= DS18B20_FLAG_POWER_ON | DS18B20_FLAG_DIRTY;
+    return;
+  }
+
+  if (DS18B20_FAMILY_DS18S20 == family(netp, i)) {
+    dp->temperature = (int32_t)raw * 500;
+  }
+  else {
+    /* Least significant bits are undefined for low resolutions.*/
+    raw &= (int16_t)~((1U << (12U - dp->resolution)) - 1U);
+    dp->temperature = ((int32_t)raw * 625) / 10;
+  }
+  dp->flags |= DS18B20_FLAG_VALID;
+}
+
+/**
+ * @brief   Writes pending configuration to device @p i.
+ */
+static void write_config(ds18b20Net *netp, size_t i) {
+  ds18b20dev_t *dp = &netp->dev[i];
+  uint8_t cmd[4];
+  size_t len = 3;
+
+  cmd[0] = DS18B20_CMD_WRITE_SCRATCHPAD;
+  cmd[1] = (uint8_t)dp->th;
+  cmd[2] = (uint8_t)dp->tl;
+  if (DS18B20_FAMILY_DS18S20 != family(netp, i)) {
+    cmd[3] = (uint8_t)(((dp->resolution - 9U) << 5) | 0x1FU);
+    len = 4;
+  }
+
+  if (true == match_rom(netp, i, cmd, len))
+    dp->flags &= ~DS18B20_FLAG_DIRTY;
+}
+
+/**
+ * @brief   Longest conversion time over all devices in milliseconds.
+ */
+static uint32_t conversion_time(const ds18b20Net *netp) {
+  uint32_t ms = 0;
+  size_t i;
+
+  for (i = 0; i < netp->devices; i++) {
+    uint32_t t = DS18B20_CONVERSION_MS(netp->dev[i].resolution);
+    if (t > ms)
+      ms = t;
+  }
+  return ms;
+}
+
+/**
+ * @brief   Starts conversion on all devices and waits for completion.
+ *
+ * @return              Bool flag denoting successful conversion.
+ */
+static bool convert_all(ds18b20Net *netp) {
+  uint8_t buf[2];
+  uint32_t ms = conversion_time(netp);
+  systime_t pullup_time = 0;
+  uint32_t waited;
+
+  if (false == onewireReset(netp->owp))
+    return false;
+
+#if ONEWIRE_USE_STRONG_PULLUP
+  if (netp->parasite)
+    pullup_time = OSAL_MS2I(ms);
+#endif
+
+  buf[0] = ONEWIRE_CMD_SKIP_ROM;
+  buf[1] = ONEWIRE_CMD_CONVERT_TEMP;
+  onewireWrite(netp->owp, buf, 2, pullup_time);
+
+  if (0 != pullup_time)
+    return true;
+
+  if (netp->parasite) {
+    /* Parasite powered devices can not signal completion.*/
+    osalThreadSleepMilliseconds(ms);
+    return true;
+  }
+
+  /* Every converting device holds read slots low.*/
+  waited = 0;
+  do {
+    osalThreadSleepMilliseconds(DS18B20_POLL_PERIOD_MS);
+    waited += DS18B20_POLL_PERIOD_MS;
+    onewireRead(netp->owp, buf, 1);
+    if (0 != buf[0])
+      return true;
+  } while (waited < ms + DS18B20_CONVERSION_MARGIN(ms));
+
+  return false;
+}
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes @p ds18b20Net structure.
+ *
+ * @param[out] netp         pointer to the @p ds18b20Net object
+ * @param[in] owp           pointer to started @p onewireDriver object
+ * @param[in] rom           buffer for ROM cache, 8 * @p max_devices bytes
+ * @param[in] dev           array of @p max_devices device states
+ * @param[in] max_devices   capacity of buffers, 1..256
+ *
+ * @init
+ */
+void ds18b20ObjectInit(ds18b20Net *netp, onewireDriver *owp,
+                       uint8_t *rom, ds18b20dev_t *dev, size_t max_devices) {
+
+  osalDbgCheck((NULL != netp) && (NULL != owp));
+  osalDbgCheck((NULL != rom) && (NULL != dev));
+  osalDbgCheck((max_devices > 0) && (max_devices <= 256));
+
+  netp->owp = owp;
+  netp->rom = rom;
+  netp->dev = dev;
+  netp->max_devices = max_devices;
+  netp->devices = 0;
+  netp->parasite = false;
+  netp->reads = 0;
+  netp->crc_errors = 0;
+}
+
+/**
+ * @brief   Discovers devices and fills ROM cache.
+ * @details Current resolution and alarm thresholds are fetched from every
+ *          discovered device. Devices beyond @p max_devices are ignored.
+ *
+ * @param[in] netp      pointer to the @p ds18b20Net object
+ *
+ * @return              Count of cached devices.
+ * @retval 0            no devices found or communication error occurred.
+ *
+ * @api
+ */
+size_t ds18b20Discover(ds18b20Net *netp) {
+  uint8_t sp[DS18B20_SCRATCHPAD_LEN];
+  size_t i, n;
+
+  osalDbgCheck(NULL != netp);
+
+  n = onewireSearchRom(netp->owp, netp->rom, netp->max_devices);
+  if (n > netp->max_devices)
+    n = netp->max_devices;
+  netp->devices = n;
+
+  for (i = 0; i < n; i++) {
+    ds18b20dev_t *dp = &netp->dev[i];
+
+    dp->temperature = DS18B20_TEMP_INVALID;
+    dp->flags = 0;
+    dp->errors = 0;
+    dp->resolution = 12;
+    dp->th = 0;
+    dp->tl = 0;
+    if (DS18B20_FAMILY_DS18S20 == family(netp, i))
+      dp->resolution = 9;
+
+    if (true == read_scratchpad(netp, i, sp)) {
+      dp->th = (int8_t)sp[2];
+      dp->tl = (int8_t)sp[3];
+      if (DS18B20_FAMILY_DS18S20 != family(netp, i))
+        dp->resolution = 9U + ((sp[4] >> 5) & 3U);
+    }
+  }
+
+  /* Parasite powered devices pull bus low in read slot.*/
+  netp->parasite = false;
+  if ((n > 0) && (true == onewireReset(netp->owp))) {
+    uint8_t buf[2];
+
+    buf[0] = ONEWIRE_CMD_SKIP_ROM;
+    buf[1] = DS18B20_CMD_READ_POWER_SUPPLY;
+    onewireWrite(netp->owp, buf, 2, 0);
+    onewireRead(netp->owp, buf, 1);
+    netp->parasite = (0 == (buf[0] & 1));
+  }
+
+  return n;
+}
+
+/**
+ * @brief   Sets resolution and alarm thresholds of single device.
+ * @details Configuration is written to device at the beginning of next
+ *          sweep. It is stored in device RAM only, so it is written again
+ *          automatically after the device power-on reset is detected.
+ * @note    Resolution of DS18S20 is fixed, only thresholds are applied.
+ *
+ * @param[in] netp        pointer to the @p ds18b20Net object
+ * @param[in] idx         device index in ROM cache
+ * @param[in] resolution  resolution in bits, 9..12
+ * @param[in] th          high alarm threshold in degrees Celsius
+ * @param[in] tl          low alarm threshold in degrees Celsius
+ *
+ * @api
+ */
+void ds18b20SetConfig(ds18b20Net *netp, size_t idx,
+                      uint8_t resolution, int8_t th, int8_t tl) {
+  ds18b20dev_t *dp;
+
+  osalDbgCheck((NULL != netp) && (idx < netp->devices));
+  osalDbgCheck((resolution >= 9) && (resolution <= 12));
+
+  dp = &netp->dev[idx];
+  if (DS18B20_FAMILY_DS18S20 != family(netp, idx))
+    dp->resolution = resolution;
+  dp->th = th;
+  dp->tl = tl;
+  dp->flags |= DS18B20_FLAG_DIRTY;
+}
+
+/**
+ * @brief   Measures temperature on all cached devices.
+ * @details Device failed to deliver valid scratchpad keeps previous
+ *          temperature value and gets its @p errors counter increased.
+ *          A power-on reset value is dropped only when the scratchpad
+ *          confirms the reset, a real 85 C reading is kept.
+ *
+ * @param[in] netp      pointer to the @p ds18b20Net object
+ *
+ * @return              Count of devices with fresh temperature.
+ *
+ * @api
+ */
+size_t ds18b20Sweep(ds18b20Net *netp) {
+  uint8_t sp[DS18B20_SCRATCHPAD_LEN];
+  size_t i, ok, attempt;
+  bool pending;
+
+  osalDbgCheck(NULL != netp);
+
+  for (i = 0; i < netp->devices; i++) {
+    ds18b20dev_t *dp = &netp->dev[i];
+
+    /* Remember the reset value dropped last time, see is_power_on().*/
+    dp->flags &= ~(DS18B20_FLAG_VALID | DS18B20_FLAG_POWER_ON_SEEN);
+    if (0 != (dp->flags & DS18B20_FLAG_POWER_ON))
+      dp->flags = (dp->flags & ~DS18B20_FLAG_POWER_ON) |
+                  DS18B20_FLAG_POWER_ON_SEEN;
+    if (0 != (dp->flags & DS18B20_FLAG_DIRTY))
+      write_config(netp, i);
+  }
+
+  if ((0 == netp->devices) || (false == convert_all(netp)))
+    pending = false;
+  else
+    pending = true;
+
+  for (attempt = 0; pending && (attempt < DS18B20_READ_ATTEMPTS); attempt++) {
+    pending = false;
+    for (i = 0; i < netp->devices; i++) {
+      if (0 != (netp->dev[i].flags &
+               (DS18B20_FLAG_VALID | DS18B20_FLAG_POWER_ON)))
+        continue;
+      if (true == read_scratchpad(netp, i, sp))
+        decode(netp, i, sp);
+      else
+        pending = true;
+    }
+  }
+
+  ok = 0;
+  for (i = 0; i < netp->devices; i++) {
+    ds18b20dev_t *dp = &netp->dev[i];
+
+    if (0 != (dp->flags & DS18B20_FLAG_VALID)) {
+      dp->errors = 0;
+      ok++;
+    }
+    else if (dp->errors < UINT8_MAX) {
+      dp->errors++;
+    }
+  }
+  return ok;
+}
+
+#endif /* HAL_USE_ONEWIRE */
+
+/** @} */
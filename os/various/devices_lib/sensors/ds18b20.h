@@ -0,0 +1,200 @@
+/*
+    ChibiOS/RT - Copyright (C) 2026 agent
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    ds18b20.h
+ * @brief   DS18B20 1-wire temperature sensor network manager.
+ *
+ * @addtogroup ds18b20
+ * @{
+ */
+
+#ifndef DS18B20_H_
+#define DS18B20_H_
+
+#include "hal.h"
+
+#if (HAL_USE_ONEWIRE == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+/**
+ * @brief   Supported family codes.
+ */
+#define DS18B20_FAMILY_DS18S20            0x10
+#define DS18B20_FAMILY_DS1822             0x22
+#define DS18B20_FAMILY_DS18B20            0x28
+#define DS18B20_FAMILY_DS1825             0x3B
+
+/**
+ * @brief   Function commands not covered by 1-wire driver.
+ */
+#define DS18B20_CMD_WRITE_SCRATCHPAD      0x4E
+#define DS18B20_CMD_COPY_SCRATCHPAD       0x48
+#define DS18B20_CMD_READ_POWER_SUPPLY     0xB4
+
+/**
+ * @brief   Scratchpad length including CRC byte.
+ */
+#define DS18B20_SCRATCHPAD_LEN            9U
+
+/**
+ * @brief   Marker stored in temperature field until first valid reading.
+ */
+#define DS18B20_TEMP_INVALID              INT32_MIN
+
+/**
+ * @brief   Device status flags.
+ */
+#define DS18B20_FLAG_VALID                0x01  /**< Temperature is fresh.  */
+#define DS18B20_FLAG_DIRTY                0x02  /**< Config not written yet.*/
+#define DS18B20_FLAG_POWER_ON             0x04  /**< Reported 85 C reset
+                                                     value, reading dropped.*/
+#define DS18B20_FLAG_POWER_ON_SEEN        0x08  /**< Reset value dropped in
+                                                     previous sweep.        */
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+/**
+ * @brief   Scratchpad read attempts for every device per sweep.
+ */
+#if !defined(DS18B20_READ_ATTEMPTS) || defined(__DOXYGEN__)
+#define DS18B20_READ_ATTEMPTS             3
+#endif
+
+/**
+ * @brief   Conversion polling period in milliseconds.
+ */
+#if !defined(DS18B20_POLL_PERIOD_MS) || defined(__DOXYGEN__)
+#define DS18B20_POLL_PERIOD_MS            10
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+#if !ONEWIRE_USE_SEARCH_ROM
+#error "DS18B20 network manager requires ONEWIRE_USE_SEARCH_ROM"
+#endif
+
+#if DS18B20_READ_ATTEMPTS < 1
+#error "DS18B20_READ_ATTEMPTS must be at least 1"
+#endif
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+/**
+ * @brief   State of single sensor on the network.
+ */
+typedef struct {
+  /**
+   * @brief   Last valid temperature in millicelsius.
+   */
+  int32_t       temperature;
+  /**
+   * @brief   Resolution in bits, 9..12.
+   */
+  uint8_t       resolution;
+  /**
+   * @brief   High alarm threshold in degrees Celsius.
+   */
+  int8_t        th;
+  /**
+   * @brief   Low alarm threshold in degrees Celsius.
+   */
+  int8_t        tl;
+  /**
+   * @brief   Status flags (@p DS18B20_FLAG_* bits).
+   */
+  uint8_t       flags;
+  /**
+   * @brief   Sweeps failed in a row.
+   */
+  uint8_t       errors;
+} ds18b20dev_t;
+
+/**
+ * @brief   Structure representing a network of sensors on single bus.
+ */
+typedef struct {
+  /**
+   * @brief   Bus driver.
+   */
+  onewireDriver         *owp;
+  /**
+   * @brief   Cached ROM codes, 8 bytes per device.
+   */
+  uint8_t               *rom;
+  /**
+   * @brief   Per device state, same order as @p rom.
+   */
+  ds18b20dev_t          *dev;
+  /**
+   * @brief   Capacity of @p rom and @p dev arrays in devices.
+   */
+  size_t                max_devices;
+  /**
+   * @brief   Devices discovered on bus.
+   */
+  size_t                devices;
+  /**
+   * @brief   At least one device is parasite powered.
+   */
+  bool                  parasite;
+  /**
+   * @brief   Statistics: total scratchpad reads and CRC failures.
+   */
+  uint32_t              reads;
+  uint32_t              crc_errors;
+} ds18b20Net;
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+/**
+ * @brief   Conversion time in milliseconds for given resolution.
+ */
+#define DS18B20_CONVERSION_MS(res)  (750U >> (12U - (unsigned)(res)))
+
+/**
+ * @brief   Pointer to the cached ROM code of device @p i.
+ */
+#define ds18b20GetRom(netp, i)      (&(netp)->rom[(i) * 8U])
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void ds18b20ObjectInit(ds18b20Net *netp, onewireDriver *owp,
+                         uint8_t *rom, ds18b20dev_t *dev, size_t max_devices);
+  size_t ds18b20Discover(ds18b20Net *netp);
+  void ds18b20SetConfig(ds18b20Net *netp, size_t idx,
+                        uint8_t resolution, int8_t th, int8_t tl);
+  size_t ds18b20Sweep(ds18b20Net *netp);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HAL_USE_ONEWIRE */
+
+#endif /* DS18B20_H_ */
+
+/** @} */
@@ -78,6 +78,16 @@
 #define HDC1000_DELAY_ACQUIRE (HDC1000_DELAY_ACQUIRE_TRES_14 + 		\
 			       HDC1000_DELAY_ACQUIRE_HRES_14)
 
+/* Fixed-point scaling, result = (raw * MUL + round) >> SHIFT
+ *  temperature: raw * 165000 / 2^16  in m°C  (exact, 165000 = 8 * 20625)
+ *  humidity   : raw * 10000  / 65535 in 0.01 %RH, MUL rounded up
+ */
+#define HDC1000_FIXED_TEMP_MUL     20625U
+#define HDC1000_FIXED_TEMP_SHIFT   13
+#define HDC1000_FIXED_TEMP_OFFSET  40000
+#define HDC1000_FIXED_HUM_MUL      40001U  /* 10000 * 2^18 / 65535 */
+#define HDC1000_FIXED_HUM_SHIFT    18
+
 /*===========================================================================*/
 /* Driver exported variables.                                                */
 /*===========================================================================*/
@@ -126,6 +136,32 @@ _decode_measure(HDC1000_drv *drv,
     return MSG_OK;
 }
 
+static inline msg_t
+_decode_measure_fixed(HDC1000_drv *drv,
+	uint32_t val, int32_t *temperature, uint16_t *humidity) {
+    (void)drv;
+
+    /* Temperature (m°C), at most 0.5 m°C from the exact value */
+    if (temperature) {
+	uint32_t temp = (val >> 16);
+	temp *= HDC1000_FIXED_TEMP_MUL;
+	temp += 1U << (HDC1000_FIXED_TEMP_SHIFT - 1);
+	*temperature = (int32_t)(temp >> HDC1000_FIXED_TEMP_SHIFT)
+	             - HDC1000_FIXED_TEMP_OFFSET;
+    }
+
+    /* Humidity (0.01 %RH), at most 0.65 LSB from the exact value */
+    if (humidity) {
+	uint32_t hum = (val & 0xFFFF);
+	hum *= HDC1000_FIXED_HUM_MUL;
+	hum += 1U << (HDC1000_FIXED_HUM_SHIFT - 1);
+	*humidity = (uint16_t)(hum >> HDC1000_FIXED_HUM_SHIFT);
+    }
+
+    /* ok */
+    return MSG_OK;
+}
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -237,6 +273,26 @@ HDC1000_readMeasure(HDC1000_drv *drv,
     return _decode_measure(drv, val, temperature, humidity);
 }
 
+msg_t
+HDC1000_readMeasureFixed(HDC1000_drv *drv,
+	int32_t *temperature, uint16_t *humidity) {
+    msg_t    msg;
+    uint32_t val;
+
+    osalDbgAssert((drv->state == SENSOR_MEASURING) ||
+		  (drv->state == SENSOR_READY    ),
+		  "invalid state");
+
+    if ((msg = i2c_recv32_be(&val)) < MSG_OK) {
+	drv->state = SENSOR_ERROR;
+	return msg;
+    }
+
+    drv->state = SENSOR_STARTED;
+
+    return _decode_measure_fixed(drv, val, temperature, humidity);
+}
+
 msg_t
 HDC1000_readTemperatureHumidity(HDC1000_drv *drv,
 	float *temperature, float *humidity) {
@@ -262,4 +318,33 @@ HDC1000_readTemperatureHumidity(HDC1000_drv *drv,
 }
 
 
+/*===========================================================================*/
+/* Sensor scheduler interface.                                               */
+/*===========================================================================*/
+
+static msg_t
+_ops_start(void *drv) {
+    return HDC1000_startMeasure(drv);
+}
+
+static unsigned int
+_ops_time(void *drv) {
+    return HDC1000_getAcquisitionTime(drv);
+}
+
+static msg_t
+_ops_read(void *drv, float *values) {
+    return HDC1000_readMeasure(drv, &values[0], &values[1]);
+}
+
+static const I2CHelper *
+_ops_bus(void *drv) {
+    return &((HDC1000_drv *)drv)->config->i2c;
+}
+
+const sensor_ops_t HDC1000_ops = {
+    _ops_start, _ops_time, _ops_read, _ops_bus, 2
+};
+
+
 /** @} */
@@ -170,6 +170,18 @@ msg_t
 HDC1000_readMeasure(HDC1000_drv *drv,
 	float *temperature, float *humidity);
 
+/**
+ * @brief Read the newly acquiered measure, without floating point
+ *
+ * @details Same as readMeasure() for targets without FPU.
+ *
+ * @param[out] temperature  temperature in m°C (can be NULL)
+ * @param[out] humidity     humidity in 0.01 %RH (can be NULL)
+ */
+msg_t
+HDC1000_readMeasureFixed(HDC1000_drv *drv,
+	int32_t *temperature, uint16_t *humidity);
+
 
 /**
  * @brief   Read temperature and humidity
@@ -232,6 +244,11 @@ HDC1000_getTemperature(HDC1000_drv *drv) {
     return temperature;
 }
 
+/**
+ * @brief   Measure interface for the sensor scheduler.
+ */
+extern const sensor_ops_t HDC1000_ops;
+
 
 #endif
 
@@ -205,3 +205,32 @@ MCP9808_readTemperature(MCP9808_drv *drv,
 
     return _decode_measure(drv, val, temperature);    
 }
+
+
+/*===========================================================================*/
+/* Sensor scheduler interface.                                               */
+/*===========================================================================*/
+
+static msg_t
+_ops_start(void *drv) {
+    return MCP9808_startMeasure(drv);
+}
+
+static unsigned int
+_ops_time(void *drv) {
+    return MCP9808_getAcquisitionTime(drv);
+}
+
+static msg_t
+_ops_read(void *drv, float *values) {
+    return MCP9808_readMeasure(drv, &values[0]);
+}
+
+static const I2CHelper *
+_ops_bus(void *drv) {
+    return &((MCP9808_drv *)drv)->config->i2c;
+}
+
+const sensor_ops_t MCP9808_ops = {
+    _ops_start, _ops_time, _ops_read, _ops_bus, 1
+};
@@ -200,5 +200,10 @@ MCP9808_getTemperature(MCP9808_drv *drv) {
     return temperature;
 }
 
+/**
+ * @brief   Measure interface for the sensor scheduler.
+ */
+extern const sensor_ops_t MCP9808_ops;
+
 #endif
 
@@ -76,6 +76,41 @@ typedef enum __attribute__ ((__packed__)) {
     SENSOR_ERROR     = 6,            /**< Error.                          */
 } sensor_state_t;
 
+/**
+ * @brief   Maximum number of values returned by a single measure.
+ */
+#define SENSOR_MAX_VALUES 2
+
+/**
+ * @brief   Generic measure interface, used by the sensor scheduler.
+ *
+ * @details Each driver exports one instance (ie: HDC1000_ops),
+ *          the @p drv argument is a pointer to its driver structure.
+ * @note    The I2CHelper type must be defined before inclusion.
+ */
+typedef struct {
+    /**
+     * @brief Trigger a measure acquisition.
+     */
+    msg_t        (*start)(void *drv);
+    /**
+     * @brief Time in milli-seconds necessary for acquiring a new measure.
+     */
+    unsigned int (*time)(void *drv);
+    /**
+     * @brief Read the acquired measure into @p values.
+     */
+    msg_t        (*read)(void *drv, float *values);
+    /**
+     * @brief I2C helper the sensor is reached through.
+     */
+    const I2CHelper *(*bus)(void *drv);
+    /**
+     * @brief Number of values returned by read (1..SENSOR_MAX_VALUES).
+     */
+    uint8_t      values;
+} sensor_ops_t;
+
 #endif
 
 
@@ -0,0 +1,314 @@
+/*
+    Copyright (C) 2026 agent
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/*===========================================================================*/
+/* Main ideas:                                                               */
+/*===========================================================================
+
+Instead of start-sleep-read cycle for every sensor all the registered
+sensors are handled in single sweep:
+
+1) measures are started on every sensor. Sensors sharing a bus are kept
+   adjacent, so each bus is acquired once for all of its sensors. Every
+   sensor gets its ready deadline from its own acquisition time.
+2) the thread sleeps until the earliest deadline, then acquires that bus
+   and reads every sensor on it whose deadline has already passed, in
+   deadline order.
+3) bus is released and readings of the batch are published to the
+   subscribers, then 2) is repeated until no sensor is pending.
+
+So full sweep takes the longest acquisition time plus bus traffic,
+regardless of sensors count.
+*/
+
+/**
+ * @file    sensor_sched.c
+ * @brief   Measurement scheduler for I2C sensors following sensor.h.
+ *
+ * @addtogroup sensor_sched
+ * @{
+ */
+
+#include "sensor_sched.h"
+
+#if (HAL_USE_I2C == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+/**
+ * @note    With @p I2C_HELPERS_USE_QUEUE the bus is locked by the queue
+ *          worker, holding it here would deadlock.
+ */
+static void bus_acquire(sensorSched *sp, I2CDriver *i2cp) {
+
+  sp->acquisitions++;
+#if (I2C_USE_MUTUAL_EXCLUSION == TRUE) && (I2C_HELPERS_USE_QUEUE == FALSE)
+  i2cAcquireBus(i2cp);
+#else
+  (void)i2cp;
+#endif
+}
+
+static void bus_release(I2CDriver *i2cp) {
+
+#if (I2C_USE_MUTUAL_EXCLUSION == TRUE) && (I2C_HELPERS_USE_QUEUE == FALSE)
+  i2cReleaseBus(i2cp);
+#else
+  (void)i2cp;
+#endif
+}
+
+static sysinterval_t elapsed(systime_t start) {
+
+  return (sysinterval_t)(osalOsGetSystemTimeX() - start);
+}
+
+/**
+ * @brief   Publishes readings of entries marked ready.
+ */
+static void publish(sensorSched *sp) {
+  sensorSchedEntry *ep;
+  sensorSchedListener *lp;
+
+  for (ep = sp->entries; NULL != ep; ep = ep->next) {
+    if (!ep->ready)
+      continue;
+    ep->ready = false;
+    if (MSG_OK != ep->reading.status)
+      sp->errors++;
+    for (lp = sp->listeners; NULL != lp; lp = lp->next)
+      lp->cb(ep, lp->arg);
+  }
+}
+
+/**
+ * @brief   Starts measures, one bus acquisition per bus.
+ */
+static void start_all(sensorSched *sp, systime_t start) {
+  sensorSchedEntry *ep;
+  I2CDriver *bus = NULL;
+
+  for (ep = sp->entries; NULL != ep; ep = ep->next) {
+    msg_t msg;
+
+    if (ep->i2cp != bus) {
+      if (NULL != bus)
+        bus_release(bus);
+      bus = ep->i2cp;
+      bus_acquire(sp, bus);
+    }
+    msg = ep->ops->start(ep->drv);
+    if (MSG_OK == msg) {
+      ep->due = elapsed(start) + OSAL_MS2I(ep->ops->time(ep->drv));
+      ep->pending = true;
+    }
+    else {
+      ep->reading.status = msg;
+      ep->reading.timestamp = osalOsGetSystemTimeX();
+      ep->ready = true;
+    }
+  }
+  if (NULL != bus)
+    bus_release(bus);
+}
+
+/**
+ * @brief   Returns pending entry with the earliest deadline.
+ *
+ * @param[in] i2cp      restricts search to the bus, @p NULL for any bus
+ * @param[in] limit     restricts search to deadlines not after it
+ */
+static sensorSchedEntry *earliest(sensorSched *sp, I2CDriver *i2cp,
+                                  sysinterval_t limit) {
+  sensorSchedEntry *ep, *best = NULL;
+
+  for (ep = sp->entries; NULL != ep; ep = ep->next) {
+    if (!ep->pending || (ep->due > limit))
+      continue;
+    if ((NULL != i2cp) && (ep->i2cp != i2cp))
+      continue;
+    if ((NULL == best) || (ep->due < best->due))
+      best = ep;
+  }
+  return best;
+}
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a scheduler object.
+ *
+ * @param[out] sp       pointer to the @p sensorSched object
+ *
+ * @init
+ */
+void sensorSchedObjectInit(sensorSched *sp) {
+
+  osalDbgCheck(NULL != sp);
+
+  sp->entries = NULL;
+  sp->listeners = NULL;
+  sp->sweeps = 0;
+  sp->acquisitions = 0;
+  sp->errors = 0;
+  sp->duration = 0;
+}
+
+/**
+ * @brief   Registers a sensor.
+ * @details The entry is linked next to other sensors of the same bus.
+ * @pre     The sensor driver is initialized and started.
+ * @pre     With @p I2C_HELPERS_USE_QUEUE the sensor helper has a client.
+ *
+ * @param[in] sp        pointer to the @p sensorSched object
+ * @param[out] ep       entry to be registered
+ * @param[in] ops       measure interface of the driver (ie: &HDC1000_ops)
+ * @param[in] drv       pointer to the driver structure
+ *
+ * @api
+ */
+void sensorSchedAdd(sensorSched *sp, sensorSchedEntry *ep,
+                    const sensor_ops_t *ops, void *drv) {
+  const I2CHelper *i2c;
+  sensorSchedEntry **epp;
+  bool found = false;
+
+  osalDbgCheck((NULL != sp) && (NULL != ep));
+  osalDbgCheck((NULL != ops) && (NULL != ops->bus) && (NULL != drv));
+  osalDbgCheck((ops->values > 0) && (ops->values <= SENSOR_MAX_VALUES));
+
+  i2c = ops->bus(drv);
+  osalDbgCheck((NULL != i2c) && (NULL != i2c->driver));
+#if I2C_HELPERS_USE_QUEUE == TRUE
+  osalDbgCheck(NULL != i2c->client);
+#endif
+
+  ep->ops = ops;
+  ep->drv = drv;
+  ep->i2cp = i2c->driver;
+  ep->due = 0;
+  ep->pending = false;
+  ep->ready = false;
+  ep->reading.status = MSG_RESET;
+  ep->reading.timestamp = 0;
+
+  /* Inserted after the last entry of its bus, or at the end.*/
+  for (epp = &sp->entries; NULL != *epp; epp = &(*epp)->next) {
+    if ((*epp)->i2cp == ep->i2cp)
+      found = true;
+    else if (found)
+      break;
+  }
+  ep->next = *epp;
+  *epp = ep;
+}
+
+/**
+ * @brief   Subscribes to readings.
+ * @details The callback is invoked for every sensor after each sweep
+ *          read it, or failed to start it, without any bus held.
+ *
+ * @param[in] sp        pointer to the @p sensorSched object
+ * @param[out] lp       listener to be registered
+ * @param[in] cb        callback
+ * @param[in] arg       callback argument
+ *
+ * @api
+ */
+void sensorSchedSubscribe(sensorSched *sp, sensorSchedListener *lp,
+                          sensor_sched_cb_t cb, void *arg) {
+
+  osalDbgCheck((NULL != sp) && (NULL != lp) && (NULL != cb));
+
+  lp->cb = cb;
+  lp->arg = arg;
+  lp->next = sp->listeners;
+  sp->listeners = lp;
+}
+
+/**
+ * @brief   Acquires a measure from every registered sensor.
+ * @details Measures are started on all sensors together and read back in
+ *          deadline order, every bus access batching all sensors of the
+ *          bus being ready at that moment.
+ *
+ * @param[in] sp        pointer to the @p sensorSched object
+ *
+ * @return              Count of sensors read successfully.
+ *
+ * @api
+ */
+size_t sensorSchedSweep(sensorSched *sp) {
+  systime_t start;
+  size_t n = 0;
+
+  osalDbgCheck(NULL != sp);
+
+  start = osalOsGetSystemTimeX();
+  start_all(sp, start);
+  publish(sp);
+
+  while (true) {
+    sensorSchedEntry *ep = earliest(sp, NULL, (sysinterval_t)-1);
+    I2CDriver *bus;
+    sysinterval_t now;
+
+    if (NULL == ep)
+      break;
+
+    now = elapsed(start);
+    if (ep->due > now) {
+      osalThreadSleep(ep->due - now);
+      now = elapsed(start);
+    }
+
+    bus = ep->i2cp;
+    bus_acquire(sp, bus);
+    while (NULL != (ep = earliest(sp, bus, now))) {
+      ep->reading.status = ep->ops->read(ep->drv, ep->reading.values);
+      ep->reading.timestamp = osalOsGetSystemTimeX();
+      ep->pending = false;
+      ep->ready = true;
+      if (MSG_OK == ep->reading.status)
+        n++;
+    }
+    bus_release(bus);
+    publish(sp);
+  }
+
+  sp->sweeps++;
+  sp->duration = elapsed(start);
+  return n;
+}
+
+#endif /* HAL_USE_I2C */
+
+/** @} */
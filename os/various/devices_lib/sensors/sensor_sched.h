@@ -0,0 +1,191 @@
+/*
+    Copyright (C) 2026 agent
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    sensor_sched.h
+ * @brief   Measurement scheduler for I2C sensors following sensor.h.
+ *
+ * Example of function calls.
+ *
+ * @code
+ * static sensorSched      sched;
+ * static sensorSchedEntry hdc_entry, tsl_entry;
+ * static sensorSchedListener listener;
+ *
+ * sensorSchedObjectInit(&sched);
+ * sensorSchedAdd(&sched, &hdc_entry, &HDC1000_ops, &hdc1000_drv);
+ * sensorSchedAdd(&sched, &tsl_entry, &TSL2561_ops, &tsl2561_drv);
+ * sensorSchedSubscribe(&sched, &listener, publish, NULL);
+ *
+ * while(true) {
+ *   sensorSchedSweep(&sched);
+ * }
+ * @endcode
+ *
+ * @addtogroup sensor_sched
+ * @{
+ */
+
+#ifndef SENSOR_SCHED_H_
+#define SENSOR_SCHED_H_
+
+#include "hal.h"
+#include "i2c_helpers.h"
+#include "sensor.h"
+
+#if (HAL_USE_I2C == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+/**
+ * @brief   Type of a scheduled sensor.
+ */
+typedef struct sensor_sched_entry sensorSchedEntry;
+
+/**
+ * @brief   Reading published to subscribers.
+ */
+typedef struct {
+  /**
+   * @brief   Result of the start or read operation.
+   */
+  msg_t                 status;
+  /**
+   * @brief   System time the values were read at.
+   */
+  systime_t             timestamp;
+  /**
+   * @brief   Values, meaning and count given by the sensor interface.
+   */
+  float                 values[SENSOR_MAX_VALUES];
+} sensor_reading_t;
+
+/**
+ * @brief   Reading notification, called from the sweeping thread.
+ */
+typedef void (*sensor_sched_cb_t)(sensorSchedEntry *ep, void *arg);
+
+/**
+ * @brief   Subscriber to readings.
+ */
+typedef struct sensor_sched_listener {
+  struct sensor_sched_listener  *next;
+  sensor_sched_cb_t             cb;
+  void                          *arg;
+} sensorSchedListener;
+
+/**
+ * @brief   Scheduled sensor.
+ */
+struct sensor_sched_entry {
+  /**
+   * @brief   Next entry, entries sharing a bus are kept adjacent.
+   */
+  sensorSchedEntry      *next;
+  /**
+   * @brief   Measure interface and driver structure of the sensor.
+   */
+  const sensor_ops_t    *ops;
+  void                  *drv;
+  /**
+   * @brief   Bus the sensor is connected to.
+   */
+  I2CDriver             *i2cp;
+  /**
+   * @brief   Ready deadline, relative to the sweep start.
+   */
+  sysinterval_t         due;
+  /**
+   * @brief   Conversion started and not yet read.
+   */
+  bool                  pending;
+  /**
+   * @brief   Read in the current batch, not yet published.
+   */
+  bool                  ready;
+  /**
+   * @brief   Last reading.
+   */
+  sensor_reading_t      reading;
+};
+
+/**
+ * @brief   Scheduler object.
+ */
+typedef struct {
+  /**
+   * @brief   Registered sensors.
+   */
+  sensorSchedEntry      *entries;
+  /**
+   * @brief   Subscribers.
+   */
+  sensorSchedListener   *listeners;
+  /**
+   * @brief   Statistics: sweeps done, bus acquisitions and failed sensors.
+   */
+  uint32_t              sweeps;
+  uint32_t              acquisitions;
+  uint32_t              errors;
+  /**
+   * @brief   Duration of the last sweep.
+   */
+  sysinterval_t         duration;
+} sensorSched;
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+/**
+ * @brief   Last reading of a scheduled sensor.
+ */
+#define sensorSchedGetReading(ep)   (&(ep)->reading)
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void sensorSchedObjectInit(sensorSched *sp);
+  void sensorSchedAdd(sensorSched *sp, sensorSchedEntry *ep,
+                      const sensor_ops_t *ops, void *drv);
+  void sensorSchedSubscribe(sensorSched *sp, sensorSchedListener *lp,
+                            sensor_sched_cb_t cb, void *arg);
+  size_t sensorSchedSweep(sensorSched *sp);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HAL_USE_I2C */
+
+#endif /* SENSOR_SCHED_H_ */
+
+/** @} */
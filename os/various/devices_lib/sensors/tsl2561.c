@@ -384,3 +384,44 @@ TSL2561_readIlluminance(TSL2561_drv *drv,
     return SENSOR_OK;
 }
 
+msg_t
+TSL2561_readMeasure(TSL2561_drv *drv,
+	unsigned int *illuminance) {
+    return TSL2561_readIlluminance(drv, illuminance);
+}
+
+
+/*===========================================================================*/
+/* Sensor scheduler interface.                                               */
+/*===========================================================================*/
+
+static msg_t
+_ops_start(void *drv) {
+    return TSL2561_startMeasure(drv);
+}
+
+static unsigned int
+_ops_time(void *drv) {
+    return TSL2561_getAcquisitionTime(drv);
+}
+
+static msg_t
+_ops_read(void *drv, float *values) {
+    unsigned int illuminance;
+    msg_t msg;
+
+    if ((msg = TSL2561_readMeasure(drv, &illuminance)) < MSG_OK)
+	return msg;
+    values[0] = illuminance;
+    return MSG_OK;
+}
+
+static const I2CHelper *
+_ops_bus(void *drv) {
+    return &((TSL2561_drv *)drv)->config->i2c;
+}
+
+const sensor_ops_t TSL2561_ops = {
+    _ops_start, _ops_time, _ops_read, _ops_bus, 1
+};
+
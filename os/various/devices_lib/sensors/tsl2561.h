@@ -185,7 +185,7 @@ TSL2561_startMeasure(TSL2561_drv *drv) {
  */
 msg_t
 TSL2561_readMeasure(TSL2561_drv *drv,
-	unsigned int illuminance);
+	unsigned int *illuminance);
 
 msg_t
 TSL2561_setGain(TSL2561_drv *drv,
@@ -236,6 +236,11 @@ TSL2561_getIlluminance(TSL2561_drv *drv) {
     return illuminance;
 }
 
+/**
+ * @brief   Measure interface for the sensor scheduler.
+ */
+extern const sensor_ops_t TSL2561_ops;
+
 
 #endif
 
@@ -34,6 +34,19 @@
 #define TSL2591_LUX_COEFC         (0.59F)  // CH1 coefficient A
 #define TSL2591_LUX_COEFD         (0.86F)  // CH2 coefficient B
 
+/* Fixed-point lux equation, in milli-lux:
+ *   max(100 * CH0 - 164 * CH1, 59 * CH0 - 86 * CH1) * 4080 / (ATIME * AGAIN)
+ * with 4080 / (ATIME * AGAIN) precomputed as Q24 for every configuration.
+ */
+#define TSL2591_FIXED_COEFA       100
+#define TSL2591_FIXED_COEFB       164
+#define TSL2591_FIXED_COEFC        59
+#define TSL2591_FIXED_COEFD        86
+#define TSL2591_FIXED_SHIFT        24
+#define TSL2591_FIXED_SCALE(atime, again)				\
+    ((uint32_t)(((4080ULL << TSL2591_FIXED_SHIFT) + (atime) * (again) / 2) /	\
+		((atime) * (again))))
+
 /* I2C registers */
 #define TSL2591_REG_ENABLE        0x00
 #define TSL2591_REG_CONFIG        0x01 /**< @brief gain and integration */
@@ -80,6 +93,19 @@
 /* Driver local variables and types.                                         */
 /*===========================================================================*/
 
+/* Fixed-point scale, indexed by gain (>> 4) and integration time */
+#define TSL2591_FIXED_SCALE_ROW(again) {				\
+	TSL2591_FIXED_SCALE(100, again), TSL2591_FIXED_SCALE(200, again),	\
+	TSL2591_FIXED_SCALE(300, again), TSL2591_FIXED_SCALE(400, again),	\
+	TSL2591_FIXED_SCALE(500, again), TSL2591_FIXED_SCALE(600, again) }
+
+static const uint32_t fixed_scale[4][6] = {
+    TSL2591_FIXED_SCALE_ROW(1),
+    TSL2591_FIXED_SCALE_ROW(25),
+    TSL2591_FIXED_SCALE_ROW(415),
+    TSL2591_FIXED_SCALE_ROW(10000),
+};
+
 /*===========================================================================*/
 /* Driver local functions.                                                   */
 /*===========================================================================*/
@@ -102,6 +128,7 @@ calculateIlluminance(TSL2591_integration_time_t integration_time,
   case TSL2591_INTEGRATIONTIME_400MS : atime =   400; break;
   case TSL2591_INTEGRATIONTIME_500MS : atime =   500; break;
   case TSL2591_INTEGRATIONTIME_600MS : atime =   600; break;
+  default                            : atime =   100; break;
   }
   
   switch (gain) {
@@ -109,6 +136,7 @@ calculateIlluminance(TSL2591_integration_time_t integration_time,
   case TSL2591_GAIN_25X             : again =    25; break;
   case TSL2591_GAIN_415X            : again =   415; break;
   case TSL2591_GAIN_10000X          : again = 10000; break;
+  default                           : again =     1; break;
   }
 
   // cpl = (ATIME * AGAIN) / DF
@@ -120,6 +148,32 @@ calculateIlluminance(TSL2591_integration_time_t integration_time,
   return (uint32_t) (lux1 > lux2 ? lux1 : lux2);
 }
 
+/* Relative error is below 5e-5 plus 0.5 milli-lux of rounding */
+static inline uint32_t
+calculateIlluminanceFixed(TSL2591_integration_time_t integration_time,
+			  TSL2591_gain_t gain,
+			  uint16_t broadband, uint16_t ir) {
+  int32_t count1, count2;
+
+  /* Check for overflow conditions first */
+  if ((broadband == 0xFFFF) | (ir == 0xFFFF)) {
+      return 0xFFFFFFFF; /* Signal overflow */
+  }
+
+  count1 = (TSL2591_FIXED_COEFA * (int32_t)broadband) -
+	   (TSL2591_FIXED_COEFB * (int32_t)ir);
+  count2 = (TSL2591_FIXED_COEFC * (int32_t)broadband) -
+	   (TSL2591_FIXED_COEFD * (int32_t)ir);
+  if (count2 > count1)
+      count1 = count2;
+  if (count1 <= 0)
+      return 0;
+
+  return (uint32_t)(((uint64_t)count1 *
+		     fixed_scale[gain >> 4][integration_time] +
+		     (1U << (TSL2591_FIXED_SHIFT - 1))) >> TSL2591_FIXED_SHIFT);
+}
+
 static inline msg_t
 _readChannel(TSL2591_drv *drv, uint16_t *broadband, uint16_t *ir) {
     msg_t msg;
@@ -270,3 +324,63 @@ TSL2591_readIlluminance(TSL2591_drv *drv,
     return SENSOR_OK;
 }
 
+msg_t
+TSL2591_readIlluminanceFixed(TSL2591_drv *drv,
+	uint32_t *illuminance) {
+    uint16_t broadband;
+    uint16_t ir;
+
+    /* Read channels */
+    msg_t msg;
+    if ((msg = _readChannel(drv, &broadband, &ir)) < MSG_OK)
+	return msg;
+
+    /* Calculate illuminance */
+    *illuminance =
+	calculateIlluminanceFixed(drv->integration_time, drv->gain,
+				  broadband, ir);
+    /* Ok */
+    return SENSOR_OK;
+}
+
+msg_t
+TSL2591_readMeasure(TSL2591_drv *drv,
+	unsigned int *illuminance) {
+    return TSL2591_readIlluminance(drv, illuminance);
+}
+
+
+/*===========================================================================*/
+/* Sensor scheduler interface.                                               */
+/*===========================================================================*/
+
+static msg_t
+_ops_start(void *drv) {
+    return TSL2591_startMeasure(drv);
+}
+
+static unsigned int
+_ops_time(void *drv) {
+    return TSL2591_getAcquisitionTime(drv);
+}
+
+static msg_t
+_ops_read(void *drv, float *values) {
+    unsigned int illuminance;
+    msg_t msg;
+
+    if ((msg = TSL2591_readMeasure(drv, &illuminance)) < MSG_OK)
+	return msg;
+    values[0] = illuminance;
+    return MSG_OK;
+}
+
+static const I2CHelper *
+_ops_bus(void *drv) {
+    return &((TSL2591_drv *)drv)->config->i2c;
+}
+
+const sensor_ops_t TSL2591_ops = {
+    _ops_start, _ops_time, _ops_read, _ops_bus, 1
+};
+
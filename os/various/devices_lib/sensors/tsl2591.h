@@ -189,7 +189,7 @@ TSL2591_setIntegrationTime(TSL2591_drv *drv,
  */
 msg_t
 TSL2591_readMeasure(TSL2591_drv *drv,
-	unsigned int illuminance);
+	unsigned int *illuminance);
 
 
 /**
@@ -215,6 +215,16 @@ msg_t
 TSL2591_readIlluminance(TSL2591_drv *drv,
 	unsigned int *illuminance);
 
+/**
+ * @brief   Read illuminance without floating point
+ *
+ * @details Same as readIlluminance() for targets without FPU,
+ *          the value is in milli-lux, 0xFFFFFFFF on sensor overflow.
+ */
+msg_t
+TSL2591_readIlluminanceFixed(TSL2591_drv *drv,
+	uint32_t *illuminance);
+
 /**
  * @brief   Return the illuminance value in Lux
  *
@@ -233,6 +243,11 @@ TSL2591_getIlluminance(TSL2591_drv *drv) {
     return illuminance;
 }
 
+/**
+ * @brief   Measure interface for the sensor scheduler.
+ */
+extern const sensor_ops_t TSL2591_ops;
+
 
 #endif
 
@@ -20,6 +20,19 @@
 #include "hal.h"
 #include "bswap.h"
 
+/**
+ * @brief   Route transactions through the bus queue of i2cq.h.
+ * @note    When enabled, helpers having a client never lock the bus
+ *          themselves, the queue worker does.
+ */
+#if !defined(I2C_HELPERS_USE_QUEUE) || defined(__DOXYGEN__)
+#define I2C_HELPERS_USE_QUEUE FALSE
+#endif
+
+#if I2C_HELPERS_USE_QUEUE == TRUE
+#include "i2cq.h"
+#endif
+
 
 typedef struct {
     /**
@@ -30,6 +43,12 @@ typedef struct {
      * @brief I2C address.
      */
     i2caddr_t addr;
+#if I2C_HELPERS_USE_QUEUE == TRUE
+    /**
+     * @brief Queue client of the device, NULL for direct bus access.
+     */
+    i2cq_client_t *client;
+#endif
 } I2CHelper;
 
 
@@ -140,44 +159,51 @@ typedef struct {
 
 
 static inline msg_t
-_i2c_send(I2CHelper *i2c, const uint8_t *txbuf, size_t txbytes) {
+_i2c_transmit_timeout(I2CHelper *i2c, const uint8_t *txbuf, size_t txbytes,
+		     uint8_t *rxbuf, size_t rxbytes, systime_t timeout) {
+#if I2C_HELPERS_USE_QUEUE == TRUE
+    if (i2c->client != NULL)
+	return i2cqMasterTransmitTimeout(i2c->client, i2c->addr,
+				txbuf, txbytes, rxbuf, rxbytes, timeout);
+#endif
     return i2cMasterTransmitTimeout(i2c->driver, i2c->addr,
-			    txbuf, txbytes, NULL, 0, TIME_INFINITE);
-};
+				    txbuf, txbytes, rxbuf, rxbytes, timeout);
+}
 
 static inline msg_t
-_i2c_transmit(I2CHelper *i2c, const uint8_t *txbuf, size_t txbytes,
-	     uint8_t *rxbuf, size_t rxbytes) {
-    return i2cMasterTransmitTimeout(i2c->driver, i2c->addr,
-			    txbuf, txbytes, rxbuf, rxbytes, TIME_INFINITE);
-}
+_i2c_send_timeout(I2CHelper *i2c, const uint8_t *txbuf, size_t txbytes,
+		 systime_t timeout) {
+    return _i2c_transmit_timeout(i2c, txbuf, txbytes, NULL, 0, timeout);
+};
 
 static inline msg_t
-_i2c_receive(I2CHelper *i2c, uint8_t *rxbuf, size_t rxbytes) {
+_i2c_receive_timeout(I2CHelper *i2c, uint8_t *rxbuf, size_t rxbytes, systime_t timeout) {
+#if I2C_HELPERS_USE_QUEUE == TRUE
+    if (i2c->client != NULL)
+	return i2cqMasterTransmitTimeout(i2c->client, i2c->addr,
+				NULL, 0, rxbuf, rxbytes, timeout);
+#endif
     return i2cMasterReceiveTimeout(i2c->driver, i2c->addr,
-			    rxbuf, rxbytes, TIME_INFINITE);
+			    rxbuf, rxbytes, timeout);
 };
 
 
 
 static inline msg_t
-_i2c_send_timeout(I2CHelper *i2c, const uint8_t *txbuf, size_t txbytes,
-		 systime_t timeout) {
-    return i2cMasterTransmitTimeout(i2c->driver, i2c->addr,
-				    txbuf, txbytes, NULL, 0, timeout);
+_i2c_send(I2CHelper *i2c, const uint8_t *txbuf, size_t txbytes) {
+    return _i2c_send_timeout(i2c, txbuf, txbytes, TIME_INFINITE);
 };
 
 static inline msg_t
-_i2c_transmit_timeout(I2CHelper *i2c, const uint8_t *txbuf, size_t txbytes,
-		     uint8_t *rxbuf, size_t rxbytes, systime_t timeout) {
-    return i2cMasterTransmitTimeout(i2c->driver, i2c->addr,
-				    txbuf, txbytes, rxbuf, rxbytes, timeout);
+_i2c_transmit(I2CHelper *i2c, const uint8_t *txbuf, size_t txbytes,
+	     uint8_t *rxbuf, size_t rxbytes) {
+    return _i2c_transmit_timeout(i2c, txbuf, txbytes, rxbuf, rxbytes,
+				 TIME_INFINITE);
 }
 
 static inline msg_t
-_i2c_receive_timeout(I2CHelper *i2c, uint8_t *rxbuf, size_t rxbytes, systime_t timeout) {
-    return i2cMasterReceiveTimeout(i2c->driver, i2c->addr,
-			    rxbuf, rxbytes, timeout);
+_i2c_receive(I2CHelper *i2c, uint8_t *rxbuf, size_t rxbytes) {
+    return _i2c_receive_timeout(i2c, rxbuf, rxbytes, TIME_INFINITE);
 };
 
 
@@ -193,12 +219,12 @@ _i2c_reg(I2CHelper *i2c, uint8_t reg) {
 
 static inline msg_t
 _i2c_reg_recv8(I2CHelper *i2c, uint8_t reg, uint8_t *val) {
-    return _i2c_transmit(i2c, &reg, sizeof(reg), (uint8_t*)val, sizeof(val));
+    return _i2c_transmit(i2c, &reg, sizeof(reg), (uint8_t*)val, sizeof(*val));
 };
 
 static inline msg_t
 _i2c_reg_recv16(I2CHelper *i2c, uint8_t reg, uint16_t *val) {
-    return _i2c_transmit(i2c, &reg, sizeof(reg), (uint8_t*)val, sizeof(val));
+    return _i2c_transmit(i2c, &reg, sizeof(reg), (uint8_t*)val, sizeof(*val));
 };
 
 static inline msg_t
@@ -217,7 +243,7 @@ _i2c_reg_recv16_be(I2CHelper *i2c, uint8_t reg, uint16_t *val) {
 
 static inline msg_t
 _i2c_reg_recv32(I2CHelper *i2c, uint8_t reg, uint32_t *val) {
-    return _i2c_transmit(i2c, &reg, sizeof(reg), (uint8_t*)val, sizeof(val));
+    return _i2c_transmit(i2c, &reg, sizeof(reg), (uint8_t*)val, sizeof(*val));
 };
 
 static inline msg_t
@@ -239,12 +265,12 @@ _i2c_reg_recv32_be(I2CHelper *i2c, uint8_t reg, uint32_t *val) {
 
 static inline msg_t
 _i2c_recv8(I2CHelper *i2c, uint8_t *val) {
-    return _i2c_receive(i2c, (uint8_t*)val, sizeof(val));
+    return _i2c_receive(i2c, (uint8_t*)val, sizeof(*val));
 };
 
 static inline msg_t
 _i2c_recv16(I2CHelper *i2c, uint16_t *val) {
-    return _i2c_receive(i2c, (uint8_t*)val, sizeof(val));
+    return _i2c_receive(i2c, (uint8_t*)val, sizeof(*val));
 };
 
 static inline msg_t
@@ -263,7 +289,7 @@ _i2c_recv16_be(I2CHelper *i2c, uint16_t *val) {
 
 static inline msg_t
 _i2c_recv32(I2CHelper *i2c, uint32_t *val) {
-    return _i2c_receive(i2c, (uint8_t*)val, sizeof(val));
+    return _i2c_receive(i2c, (uint8_t*)val, sizeof(*val));
 };
 
 static inline msg_t
@@ -0,0 +1,472 @@
+/*
+    ChibiOS/HAL - Copyright (C) 2026 agent
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/*===========================================================================*/
+/* Main ideas:                                                               */
+/*===========================================================================
+
+Drivers sharing a bus do not lock it by themselves, they post transaction
+descriptors to the queue of the bus and a single worker thread executes
+them back-to-back:
+
+1) descriptors are sorted on submission by client priority, descriptors of
+   equal priority by time left to their deadline, then by arrival.
+2) worker acquires the bus once, executes descriptors until the queue is
+   empty, then releases the bus and sleeps until next submission.
+3) descriptor not started before its deadline is dropped without touching
+   the bus, its result is MSG_TIMEOUT.
+
+HAL transactions can not be preempted, so a high priority descriptor
+waits at most for the one being executed. Latency from submission to
+completion is accounted per client.
+*/
+
+/**
+ * @file    i2cq.c
+ * @brief   Prioritized I2C transaction queue code.
+ *
+ * @addtogroup i2cq
+ * @{
+ */
+
+#include "i2cq.h"
+
+#if (HAL_USE_I2C == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Time left to the request deadline, zero when passed.
+ */
+static sysinterval_t time_left(const i2cq_request_t *rp, systime_t now) {
+  sysinterval_t elapsed = (sysinterval_t)(now - rp->submitted);
+
+  if (I2CQ_NO_DEADLINE == rp->deadline)
+    return I2CQ_NO_DEADLINE;
+  if (elapsed >= rp->deadline)
+    return 0;
+  return rp->deadline - elapsed;
+}
+
+/**
+ * @brief   Checks whether @p rp has to be served before @p other.
+ */
+static bool goes_before(const i2cq_request_t *rp,
+                        const i2cq_request_t *other, systime_t now) {
+
+  if (rp->client->prio != other->client->prio)
+    return rp->client->prio > other->client->prio;
+  return time_left(rp, now) < time_left(other, now);
+}
+
+static void bus_acquire(I2CDriver *i2cp) {
+
+#if I2C_USE_MUTUAL_EXCLUSION == TRUE
+  i2cAcquireBus(i2cp);
+#else
+  (void)i2cp;
+#endif
+}
+
+static void bus_release(I2CDriver *i2cp) {
+
+#if I2C_USE_MUTUAL_EXCLUSION == TRUE
+  i2cReleaseBus(i2cp);
+#else
+  (void)i2cp;
+#endif
+}
+
+/**
+ * @brief   Executes the first queued request.
+ * @pre     The bus is acquired.
+ *
+ * @return              The operation status.
+ * @retval false        queue was empty.
+ * @retval true         one request has been completed.
+ */
+static bool process(i2cq_t *qp) {
+  I2CDriver *i2cp = qp->i2cp;
+  i2cq_request_t *rp;
+  i2cq_stats_t *sp;
+  sysinterval_t latency;
+  bool expired;
+  msg_t status;
+  i2cflags_t errors = 0;
+
+  osalSysLock();
+  rp = qp->head;
+  if (NULL == rp) {
+    osalSysUnlock();
+    return false;
+  }
+  qp->head = rp->next;
+  rp->next = NULL;
+  rp->state = I2CQ_REQ_ACTIVE;
+  expired = (0U == time_left(rp, osalOsGetSystemTimeX()));
+  osalSysUnlock();
+
+  if (expired) {
+    status = MSG_TIMEOUT;
+  }
+  else {
+    if (0U == rp->txbytes)
+      status = i2cMasterReceiveTimeout(i2cp, rp->addr,
+                                       rp->rxbuf, rp->rxbytes, rp->timeout);
+    else
+      status = i2cMasterTransmitTimeout(i2cp, rp->addr,
+                                        rp->txbuf, rp->txbytes,
+                                        rp->rxbuf, rp->rxbytes, rp->timeout);
+    if (MSG_RESET == status)
+      errors = i2cGetErrors(i2cp);
+    else if (MSG_TIMEOUT == status)
+      /* Driver is locked after a timeout, it has to be restarted.*/
+      i2cStart(i2cp, i2cp->config);
+  }
+  latency = (sysinterval_t)(osalOsGetSystemTimeX() - rp->submitted);
+  rp->status = status;
+  rp->errors = errors;
+
+  /* Callback owner may release the request as soon as it is marked done,
+     so the callback goes first.*/
+  if (NULL != rp->cb)
+    rp->cb(rp);
+
+  osalSysLock();
+  sp = &rp->client->stats;
+  sp->requests++;
+  if (expired)
+    sp->missed++;
+  else if (MSG_OK != status)
+    sp->errors++;
+  sp->latency_sum += latency;
+  if (latency > sp->latency_max)
+    sp->latency_max = latency;
+  qp->transactions++;
+  rp->state = I2CQ_REQ_DONE;
+  osalThreadResumeI(&rp->thread, status);
+  osalOsRescheduleS();
+  osalSysUnlock();
+
+  return true;
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a transaction queue.
+ *
+ * @param[out] qp       pointer to the @p i2cq_t object
+ * @param[in] i2cp      pointer to the started @p I2CDriver object
+ *
+ * @init
+ */
+void i2cqObjectInit(i2cq_t *qp, I2CDriver *i2cp) {
+
+  osalDbgCheck((NULL != qp) && (NULL != i2cp));
+
+  qp->i2cp = i2cp;
+  qp->head = NULL;
+  qp->worker = NULL;
+  qp->stop = false;
+  qp->runs = 0;
+  qp->transactions = 0;
+}
+
+/**
+ * @brief   Initializes a queue client.
+ *
+ * @param[out] cp       pointer to the @p i2cq_client_t object
+ * @param[in] qp        pointer to the @p i2cq_t object
+ * @param[in] prio      priority of client requests, higher is served first
+ * @param[in] deadline  default deadline of client requests relative to
+ *                      submission, @p I2CQ_NO_DEADLINE if none
+ *
+ * @init
+ */
+void i2cqClientObjectInit(i2cq_client_t *cp, i2cq_t *qp, uint8_t prio,
+                          sysinterval_t deadline) {
+
+  osalDbgCheck((NULL != cp) && (NULL != qp));
+
+  cp->qp = qp;
+  cp->prio = prio;
+  cp->deadline = deadline;
+  memset(&cp->stats, 0, sizeof(cp->stats));
+}
+
+/**
+ * @brief   Initializes a transaction descriptor.
+ * @details Bus timeout is infinite, deadline is the client one and no
+ *          callback is set, fields may be changed before submission.
+ *
+ * @param[out] rp       pointer to the @p i2cq_request_t object
+ * @param[in] cp        pointer to the submitting client
+ * @param[in] addr      slave address (7 bits) without R/W bit
+ * @param[in] txbuf     pointer to transmit buffer
+ * @param[in] txbytes   bytes to transmit, zero for receive only
+ * @param[out] rxbuf    pointer to receive buffer
+ * @param[in] rxbytes   bytes to receive, zero for transmit only
+ *
+ * @init
+ */
+void i2cqRequestObjectInit(i2cq_request_t *rp, i2cq_client_t *cp,
+                           i2caddr_t addr,
+                           const uint8_t *txbuf, size_t txbytes,
+                           uint8_t *rxbuf, size_t rxbytes) {
+
+  osalDbgCheck((NULL != rp) && (NULL != cp));
+  osalDbgCheck((txbytes > 0U) || (rxbytes > 0U));
+
+  rp->next = NULL;
+  rp->client = cp;
+  rp->addr = addr;
+  rp->txbuf = txbuf;
+  rp->txbytes = txbytes;
+  rp->rxbuf = rxbuf;
+  rp->rxbytes = rxbytes;
+  rp->timeout = TIME_INFINITE;
+  rp->deadline = cp->deadline;
+  rp->cb = NULL;
+  rp->arg = NULL;
+  rp->submitted = 0;
+  rp->state = I2CQ_REQ_IDLE;
+  rp->status = MSG_RESET;
+  rp->errors = 0;
+  rp->thread = NULL;
+}
+
+/**
+ * @brief   Queues a transaction descriptor.
+ * @details Descriptor is inserted after every descriptor that has to be
+ *          served before it and the worker is woken up.
+ * @pre     The descriptor is not queued nor being executed.
+ *
+ * @param[in] rp        pointer to the @p i2cq_request_t object
+ *
+ * @iclass
+ */
+void i2cqSubmitI(i2cq_request_t *rp) {
+  i2cq_t *qp;
+  i2cq_request_t **rpp;
+  systime_t now;
+
+  osalDbgCheckClassI();
+  osalDbgCheck((NULL != rp) && (NULL != rp->client));
+  osalDbgAssert((I2CQ_REQ_QUEUED != rp->state) &&
+                (I2CQ_REQ_ACTIVE != rp->state), "invalid state");
+
+  qp = rp->client->qp;
+  now = osalOsGetSystemTimeX();
+  rp->submitted = now;
+  rp->state = I2CQ_REQ_QUEUED;
+  rp->status = MSG_RESET;
+  rp->errors = 0;
+
+  for (rpp = &qp->head; NULL != *rpp; rpp = &(*rpp)->next) {
+    if (goes_before(rp, *rpp, now))
+      break;
+  }
+  rp->next = *rpp;
+  *rpp = rp;
+
+  osalThreadResumeI(&qp->worker, MSG_OK);
+}
+
+/**
+ * @brief   Queues a transaction descriptor.
+ * @details Completion is signaled by the descriptor callback or can be
+ *          polled with @p i2cqIsDone().
+ *
+ * @param[in] rp        pointer to the @p i2cq_request_t object
+ *
+ * @api
+ */
+void i2cqSubmit(i2cq_request_t *rp) {
+
+  osalSysLock();
+  i2cqSubmitI(rp);
+  osalOsRescheduleS();
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Queues a transaction descriptor and waits for its completion.
+ * @note    Must not be called from the worker thread or its callbacks.
+ *
+ * @param[in] rp        pointer to the @p i2cq_request_t object
+ *
+ * @return              The operation status.
+ * @retval MSG_OK       if the function succeeded.
+ * @retval MSG_RESET    if one or more I2C errors occurred, the errors can
+ *                      be retrieved from @p rp->errors.
+ * @retval MSG_TIMEOUT  if the bus timeout expired or the descriptor was
+ *                      dropped after its deadline.
+ *
+ * @api
+ */
+msg_t i2cqTransmit(i2cq_request_t *rp) {
+
+  osalSysLock();
+  i2cqSubmitI(rp);
+  (void)osalThreadSuspendS(&rp->thread);
+  osalSysUnlock();
+
+  return rp->status;
+}
+
+/**
+ * @brief   Queued equivalent of @p i2cMasterTransmitTimeout().
+ * @details Receive only transaction when @p txbytes is zero.
+ *
+ * @param[in] cp        pointer to the submitting client
+ * @param[in] addr      slave address (7 bits) without R/W bit
+ * @param[in] txbuf     pointer to transmit buffer
+ * @param[in] txbytes   bytes to transmit
+ * @param[out] rxbuf    pointer to receive buffer
+ * @param[in] rxbytes   bytes to receive
+ * @param[in] timeout   bus timeout of the transaction
+ *
+ * @return              The operation status, see @p i2cqTransmit().
+ *
+ * @api
+ */
+msg_t i2cqMasterTransmitTimeout(i2cq_client_t *cp, i2caddr_t addr,
+                                const uint8_t *txbuf, size_t txbytes,
+                                uint8_t *rxbuf, size_t rxbytes,
+                                sysinterval_t timeout) {
+  i2cq_request_t req;
+
+  i2cqRequestObjectInit(&req, cp, addr, txbuf, txbytes, rxbuf, rxbytes);
+  req.timeout = timeout;
+  return i2cqTransmit(&req);
+}
+
+/**
+ * @brief   Executes the first queued descriptor in the calling thread.
+ * @details Polled alternative to @p i2cqServe(), the bus is acquired for
+ *          the single transaction.
+ *
+ * @param[in] qp        pointer to the @p i2cq_t object
+ *
+ * @return              The operation status.
+ * @retval false        queue was empty.
+ * @retval true         one descriptor has been completed.
+ *
+ * @api
+ */
+bool i2cqProcess(i2cq_t *qp) {
+  bool done;
+
+  osalDbgCheck(NULL != qp);
+
+  bus_acquire(qp->i2cp);
+  done = process(qp);
+  bus_release(qp->i2cp);
+
+  return done;
+}
+
+/**
+ * @brief   Worker loop of the queue.
+ * @details Executes descriptors back-to-back while the queue is not empty,
+ *          holding the bus for the whole run. Returns after
+ *          @p i2cqStop() once the queue has been drained.
+ *
+ * @param[in] qp        pointer to the @p i2cq_t object
+ *
+ * @api
+ */
+void i2cqServe(i2cq_t *qp) {
+
+  osalDbgCheck(NULL != qp);
+
+  while (true) {
+    osalSysLock();
+    while ((NULL == qp->head) && !qp->stop)
+      (void)osalThreadSuspendS(&qp->worker);
+    if (NULL == qp->head) {
+      qp->stop = false;
+      osalSysUnlock();
+      return;
+    }
+    qp->runs++;
+    osalSysUnlock();
+
+    bus_acquire(qp->i2cp);
+    while (process(qp))
+      ;
+    bus_release(qp->i2cp);
+  }
+}
+
+/**
+ * @brief   Makes @p i2cqServe() return once the queue is empty.
+ *
+ * @param[in] qp        pointer to the @p i2cq_t object
+ *
+ * @api
+ */
+void i2cqStop(i2cq_t *qp) {
+
+  osalDbgCheck(NULL != qp);
+
+  osalSysLock();
+  qp->stop = true;
+  osalThreadResumeI(&qp->worker, MSG_RESET);
+  osalOsRescheduleS();
+  osalSysUnlock();
+}
+
+/**
+ * @brief   Copies statistics of a client.
+ *
+ * @param[in] cp        pointer to the @p i2cq_client_t object
+ * @param[out] stats    statistics snapshot
+ *
+ * @iclass
+ */
+void i2cqGetStatsI(const i2cq_client_t *cp, i2cq_stats_t *stats) {
+
+  osalDbgCheckClassI();
+  osalDbgCheck((NULL != cp) && (NULL != stats));
+
+  *stats = cp->stats;
+}
+
+#endif /* HAL_USE_I2C */
+
+/** @} */
@@ -0,0 +1,245 @@
+/*
+    ChibiOS/HAL - Copyright (C) 2026 agent
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    i2cq.h
+ * @brief   Prioritized I2C transaction queue structures and macros.
+ *
+ * @addtogroup i2cq
+ * @{
+ */
+
+#ifndef I2CQ_H_
+#define I2CQ_H_
+
+#include "hal.h"
+
+#if (HAL_USE_I2C == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Deadline value meaning the request never expires.
+ */
+#define I2CQ_NO_DEADLINE                TIME_INFINITE
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Request states.
+ */
+typedef enum {
+  I2CQ_REQ_IDLE = 0,                /**< Not queued.                        */
+  I2CQ_REQ_QUEUED = 1,              /**< Waiting in queue.                  */
+  I2CQ_REQ_ACTIVE = 2,              /**< Being executed.                    */
+  I2CQ_REQ_DONE = 3                 /**< Completed, status is valid.        */
+} i2cq_reqstate_t;
+
+/**
+ * @brief   Per client statistics.
+ */
+typedef struct {
+  /**
+   * @brief   Completed requests, including failed and expired ones.
+   */
+  uint32_t      requests;
+  /**
+   * @brief   Requests failed on bus.
+   */
+  uint32_t      errors;
+  /**
+   * @brief   Requests dropped because not started before the deadline.
+   */
+  uint32_t      missed;
+  /**
+   * @brief   Sum and maximum of submission to completion time.
+   */
+  uint64_t      latency_sum;
+  sysinterval_t latency_max;
+} i2cq_stats_t;
+
+/**
+ * @brief   Type of a transaction queue.
+ */
+typedef struct i2cq i2cq_t;
+
+/**
+ * @brief   Type of a queue client.
+ */
+typedef struct {
+  /**
+   * @brief   Queue the client submits to.
+   */
+  i2cq_t        *qp;
+  /**
+   * @brief   Priority of the client requests, higher is served first.
+   */
+  uint8_t       prio;
+  /**
+   * @brief   Default deadline of the client requests, relative to the
+   *          submission, or @p I2CQ_NO_DEADLINE.
+   */
+  sysinterval_t deadline;
+  /**
+   * @brief   Statistics.
+   */
+  i2cq_stats_t  stats;
+} i2cq_client_t;
+
+/**
+ * @brief   Type of a transaction request.
+ */
+typedef struct i2cq_request i2cq_request_t;
+
+/**
+ * @brief   Completion callback, called from the worker thread.
+ */
+typedef void (*i2cqcb_t)(i2cq_request_t *rp);
+
+/**
+ * @brief   Transaction descriptor.
+ */
+struct i2cq_request {
+  /**
+   * @brief   Next request in queue.
+   */
+  i2cq_request_t        *next;
+  /**
+   * @brief   Submitting client.
+   */
+  i2cq_client_t         *client;
+  /**
+   * @brief   Transaction, receive only when @p txbytes is zero.
+   */
+  i2caddr_t             addr;
+  const uint8_t         *txbuf;
+  size_t                txbytes;
+  uint8_t               *rxbuf;
+  size_t                rxbytes;
+  /**
+   * @brief   Bus timeout of the transaction.
+   */
+  sysinterval_t         timeout;
+  /**
+   * @brief   Latest start time relative to the submission, or
+   *          @p I2CQ_NO_DEADLINE.
+   */
+  sysinterval_t         deadline;
+  /**
+   * @brief   Completion callback, may be @p NULL.
+   */
+  i2cqcb_t              cb;
+  void                  *arg;
+  /**
+   * @brief   Submission time.
+   */
+  systime_t             submitted;
+  /**
+   * @brief   State, result and bus errors of the transaction.
+   */
+  volatile i2cq_reqstate_t state;
+  msg_t                 status;
+  i2cflags_t            errors;
+  /**
+   * @brief   Thread waiting for the completion.
+   */
+  thread_reference_t    thread;
+};
+
+/**
+ * @brief   Transaction queue.
+ * @details Requests are ordered by client priority, then by remaining
+ *          time to their deadline, then by submission order.
+ */
+struct i2cq {
+  /**
+   * @brief   Bus, started by application.
+   */
+  I2CDriver             *i2cp;
+  /**
+   * @brief   Pending requests.
+   */
+  i2cq_request_t        *head;
+  /**
+   * @brief   Idle worker thread.
+   */
+  thread_reference_t    worker;
+  /**
+   * @brief   Worker has to return.
+   */
+  bool                  stop;
+  /**
+   * @brief   Bus acquisitions and transactions done by worker.
+   */
+  uint32_t              runs;
+  uint32_t              transactions;
+};
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Checks whether the request is completed.
+ */
+#define i2cqIsDone(rp)                  ((rp)->state == I2CQ_REQ_DONE)
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void i2cqObjectInit(i2cq_t *qp, I2CDriver *i2cp);
+  void i2cqClientObjectInit(i2cq_client_t *cp, i2cq_t *qp, uint8_t prio,
+                            sysinterval_t deadline);
+  void i2cqRequestObjectInit(i2cq_request_t *rp, i2cq_client_t *cp,
+                             i2caddr_t addr,
+                             const uint8_t *txbuf, size_t txbytes,
+                             uint8_t *rxbuf, size_t rxbytes);
+  void i2cqSubmitI(i2cq_request_t *rp);
+  void i2cqSubmit(i2cq_request_t *rp);
+  msg_t i2cqTransmit(i2cq_request_t *rp);
+  msg_t i2cqMasterTransmitTimeout(i2cq_client_t *cp, i2caddr_t addr,
+                                  const uint8_t *txbuf, size_t txbytes,
+                                  uint8_t *rxbuf, size_t rxbytes,
+                                  sysinterval_t timeout);
+  bool i2cqProcess(i2cq_t *qp);
+  void i2cqServe(i2cq_t *qp);
+  void i2cqStop(i2cq_t *qp);
+  void i2cqGetStatsI(const i2cq_client_t *cp, i2cq_stats_t *stats);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HAL_USE_I2C */
+
+#endif /* I2CQ_H_ */
+
+/** @} */
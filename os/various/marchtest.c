@@ -0,0 +1,251 @@
+/*
+    ChibiOS/RT - Copyright (C) 2026 agent
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    marchtest.c
+ * @brief   Non destructive incremental March C- memory test.
+ * @details Unlike @p memtest_run() this test can run on memory in use.
+ *          Every @p marchtestStep() call saves one window of the region,
+ *          runs March C- over it and restores the content, all inside
+ *          a critical section. The step time is bounded by window size,
+ *          so the test can be called periodically from a low priority
+ *          thread while the application runs.
+ *
+ *          March C- elements, each run with 0x00000000 and 0x55555555
+ *          data backgrounds:
+ *          - up/down (w0)
+ *          - up      (r0, w1)
+ *          - up      (r1, w0)
+ *          - down    (r0, w1)
+ *          - down    (r1, w0)
+ *          - up/down (r0)
+ *          .
+ * @note    DMA transfers into the tested region are not stopped by the
+ *          critical section and must not run concurrently.
+ *
+ * @addtogroup marchtest
+ * @{
+ */
+
+#include "hal.h"
+#include "marchtest.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/**
+ * @brief   Reads one word of the tested region.
+ * @note    Can be redefined in hal.h, host tests use it to inject faults.
+ */
+#if !defined(MARCHTEST_READ) || defined(__DOXYGEN__)
+#define MARCHTEST_READ(p)           (*(p))
+#endif
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/**
+ * @brief   First detected fault.
+ */
+typedef struct {
+  volatile uint32_t *addr;
+  uint32_t          got;
+  uint32_t          expect;
+} fault_t;
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Data backgrounds.
+ */
+static const uint32_t backgrounds[] = {0x00000000, 0x55555555};
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Read and compare single word.
+ *
+ * @return              The operation status.
+ * @retval true         word contains expected value.
+ * @retval false        fault detected and stored in @p f.
+ */
+static inline bool check(volatile uint32_t *p, uint32_t expect, fault_t *f) {
+  uint32_t got = MARCHTEST_READ(p);
+
+  if (got != expect) {
+    f->addr   = p;
+    f->got    = got;
+    f->expect = expect;
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief   March C- over the memory block with single data background.
+ *
+ * @param[in] mem       start of the block
+ * @param[in] n         number of words
+ * @param[in] d0        data background
+ * @param[out] f        first detected fault
+ *
+ * @return              The operation status.
+ * @retval true         no faults.
+ * @retval false        fault detected.
+ */
+static bool march_c_minus(volatile uint32_t *mem, size_t n, uint32_t d0,
+                          fault_t *f) {
+  const uint32_t d1 = ~d0;
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    mem[i] = d0;
+
+  for (i = 0; i < n; i++) {
+    if (!check(&mem[i], d0, f))
+      return false;
+    mem[i] = d1;
+  }
+
+  for (i = 0; i < n; i++) {
+    if (!check(&mem[i], d1, f))
+      return false;
+    mem[i] = d0;
+  }
+
+  for (i = n; i-- > 0; ) {
+    if (!check(&mem[i], d0, f))
+      return false;
+    mem[i] = d1;
+  }
+
+  for (i = n; i-- > 0; ) {
+    if (!check(&mem[i], d1, f))
+      return false;
+    mem[i] = d0;
+  }
+
+  for (i = 0; i < n; i++) {
+    if (!check(&mem[i], d0, f))
+      return false;
+  }
+
+  return true;
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes an @p marchtest_t structure.
+ *
+ * @param[out] mtp      pointer to the @p marchtest_t object
+ * @param[in] start     start of the tested region, must be word aligned
+ * @param[in] size      size of the tested region in bytes
+ * @param[in] save      buffer of @p window words outside of the region
+ * @param[in] window    number of words tested per step
+ * @param[in] errcb     fault callback or @p NULL
+ *
+ * @init
+ */
+void marchtestObjectInit(marchtest_t *mtp, void *start, size_t size,
+                         uint32_t *save, size_t window,
+                         marchtestecb_t errcb) {
+  const uint8_t *s = start;
+
+  osalDbgCheck((mtp != NULL) && (start != NULL) && (save != NULL));
+  osalDbgCheck((window > 0) && (size >= sizeof(uint32_t)));
+  osalDbgCheck(((uintptr_t)start & (sizeof(uint32_t) - 1)) == 0);
+  osalDbgAssert(((const uint8_t *)save >= s + size) ||
+                ((const uint8_t *)(save + window) <= s),
+                "save buffer inside tested region");
+
+  mtp->start  = start;
+  mtp->words  = size / sizeof(uint32_t);
+  mtp->save   = save;
+  mtp->window = window;
+  mtp->errcb  = errcb;
+  mtp->pos    = 0;
+  mtp->passes = 0;
+  mtp->faults = 0;
+}
+
+/**
+ * @brief   Tests the next window of the region.
+ * @details Saves the window, runs March C- over it with all data
+ *          backgrounds and restores the content, all in single critical
+ *          section. Windows are tested in order, after the last one the
+ *          test wraps to the region start and @p passes is incremented.
+ *
+ * @param[in] mtp       pointer to the @p marchtest_t object
+ *
+ * @return              The operation status.
+ * @retval true         the window is OK.
+ * @retval false        fault detected.
+ *
+ * @api
+ */
+bool marchtestStep(marchtest_t *mtp) {
+  volatile uint32_t *mem;
+  fault_t fault;
+  size_t n, i, b;
+  bool ok = true;
+
+  osalDbgCheck(mtp != NULL);
+
+  mem = mtp->start + mtp->pos;
+  n = mtp->words - mtp->pos;
+  if (n > mtp->window)
+    n = mtp->window;
+
+  osalSysLock();
+  for (i = 0; i < n; i++)
+    mtp->save[i] = mem[i];
+
+  for (b = 0; ok && (b < sizeof(backgrounds) / sizeof(backgrounds[0])); b++)
+    ok = march_c_minus(mem, n, backgrounds[b], &fault);
+
+  for (i = 0; i < n; i++)
+    mem[i] = mtp->save[i];
+  osalSysUnlock();
+
+  mtp->pos += n;
+  if (mtp->pos >= mtp->words) {
+    mtp->pos = 0;
+    mtp->passes++;
+  }
+
+  if (!ok) {
+    mtp->faults++;
+    if (NULL != mtp->errcb)
+      mtp->errcb(mtp, fault.addr, fault.got, fault.expect);
+  }
+
+  return ok;
+}
+
+/** @} */
@@ -0,0 +1,126 @@
+/*
+    ChibiOS/RT - Copyright (C) 2026 agent
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    marchtest.h
+ * @brief   Non destructive incremental March C- memory test.
+ *
+ * @addtogroup marchtest
+ * @{
+ */
+
+#ifndef MARCHTEST_H_
+#define MARCHTEST_H_
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+typedef struct marchtest_t marchtest_t;
+
+/**
+ * @brief   Fault callback.
+ * @note    Called outside of critical section after the window has been
+ *          restored.
+ *
+ * @param[in] mtp       pointer to the @p marchtest_t object
+ * @param[in] addr      address of the faulty word
+ * @param[in] got       read value
+ * @param[in] expect    expected value
+ */
+typedef void (*marchtestecb_t)(marchtest_t *mtp, volatile uint32_t *addr,
+                               uint32_t got, uint32_t expect);
+
+/**
+ * @brief   Incremental memory test object.
+ */
+struct marchtest_t {
+  /**
+   * @brief   Start of tested region, must be word aligned.
+   */
+  volatile uint32_t   *start;
+  /**
+   * @brief   Size of tested region in words.
+   */
+  size_t              words;
+  /**
+   * @brief   Buffer holding the window content during the test step.
+   * @note    Must be located outside of tested region.
+   */
+  uint32_t            *save;
+  /**
+   * @brief   Size of window in words, bounds the critical section length.
+   */
+  size_t              window;
+  /**
+   * @brief   Fault callback or @p NULL.
+   */
+  marchtestecb_t      errcb;
+  /**
+   * @brief   Offset of the next window in words.
+   */
+  size_t              pos;
+  /**
+   * @brief   Number of completed passes over the whole region.
+   */
+  uint32_t            passes;
+  /**
+   * @brief   Number of detected faults.
+   */
+  uint32_t            faults;
+};
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Coverage of the current pass in words.
+ *
+ * @param[in] mtp       pointer to the @p marchtest_t object
+ */
+#define marchtestGetCoverage(mtp)   ((mtp)->pos)
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void marchtestObjectInit(marchtest_t *mtp, void *start, size_t size,
+                           uint32_t *save, size_t window,
+                           marchtestecb_t errcb);
+  bool marchtestStep(marchtest_t *mtp);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MARCHTEST_H_ */
+
+/** @} */
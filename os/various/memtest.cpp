@@ -16,220 +16,323 @@
 
 #include <cstdint>
 #include <cstddef>
-#include <cstdlib>
 #include <cstring>
+#include <type_traits>
 
 #include "memtest.h"
 
-static unsigned int prng_seed = 42;
+static uint32_t prng_seed = 42;
 
 /*
- *
+ * Number of elements written and checked per unrolled loop iteration.
+ */
+#define MEMTEST_UNROLL    8
+
+/*
+ * Optional read hook taking address and width, host tests use it to
+ * inject faults seen by a single read.
  */
+#if defined(MEMTEST_READ_HOOK)
+extern "C" uint64_t MEMTEST_READ_HOOK(const volatile void *p, size_t width);
+#endif
+
 template <typename T>
-class Generator {
-public:
-  Generator(void) : pattern(0) {;}
-  virtual T get(void) = 0;
-  virtual testtype get_type(void) = 0;
-  virtual void init(T seed) {
-    pattern = seed;
-  }
-protected:
-  T pattern;
-};
+static inline T memtest_read(volatile T *p) {
+#if defined(MEMTEST_READ_HOOK)
+  return static_cast<T>(MEMTEST_READ_HOOK(p, sizeof(T)));
+#else
+  return *p;
+#endif
+}
 
 /*
- *
+ * Generators are plain classes without virtual methods. Test routines
+ * are templated by generator type, so get() calls are inlined into
+ * the memory loops.
  */
 template <typename T>
-class GeneratorWalkingOne : public Generator<T> {
+class GeneratorWalkingOne {
+public:
+  void init(T seed) {
+    pattern = seed;
+  }
+
   T get(void) {
-    T ret = this->pattern;
+    T ret = pattern;
 
-    this->pattern <<= 1;
-    if (0 == this->pattern)
-      this->pattern = 1;
+    pattern <<= 1;
+    if (0 == pattern)
+      pattern = 1;
 
     return ret;
   }
-
-  testtype get_type(void) {
-    return MEMTEST_WALKING_ONE;
-  }
+private:
+  T pattern;
 };
 
 /*
  *
  */
 template <typename T>
-class GeneratorWalkingZero : public Generator<T> {
+class GeneratorWalkingZero {
+public:
+  void init(T seed) {
+    pattern = seed;
+  }
+
   T get(void) {
-    T ret = ~this->pattern;
+    T ret = ~pattern;
 
-    this->pattern <<= 1;
-    if (0 == this->pattern)
-      this->pattern = 1;
+    pattern <<= 1;
+    if (0 == pattern)
+      pattern = 1;
 
     return ret;
   }
-
-  testtype get_type(void) {
-    return MEMTEST_WALKING_ZERO;
-  }
+private:
+  T pattern;
 };
 
 /*
  *
  */
 template <typename T>
-class GeneratorOwnAddress : public Generator<T> {
-  T get(void) {
-    T ret = this->pattern;
-    this->pattern++;
-    return ret;
+class GeneratorOwnAddress {
+public:
+  void init(T seed) {
+    pattern = seed;
   }
 
-  testtype get_type(void) {
-    return MEMTEST_OWN_ADDRESS;
+  T get(void) {
+    T ret = pattern;
+    pattern++;
+    return ret;
   }
+private:
+  T pattern;
 };
 
 /*
  *
  */
 template <typename T>
-class GeneratorMovingInv : public Generator<T> {
-  T get(void) {
-    T ret = this->pattern;
-    this->pattern = ~this->pattern;
-    return ret;
+class GeneratorMovingInv {
+public:
+  void init(T seed) {
+    pattern = seed;
   }
 
-  testtype get_type(void) {
-    if ((this->pattern == 0) || ((this->pattern & 0xFF) == 0xFF))
-      return MEMTEST_MOVING_INVERSION_ZERO;
-    else
-      return MEMTEST_MOVING_INVERSION_55AA;
+  T get(void) {
+    T ret = pattern;
+    pattern = ~pattern;
+    return ret;
   }
+private:
+  T pattern;
 };
 
 /*
- *
+ * Pairs of xorshift random value and its inversion. 64-bit state is
+ * used for 64-bit data, 32-bit state otherwise.
  */
 template <typename T>
-class GeneratorMovingInvRand : public Generator<T> {
+class GeneratorMovingInvRand {
 public:
-  GeneratorMovingInvRand(void) : step(0), prev(0){;}
   void init(T seed) {
-    srand(seed);
-    step = 0;
+    state = static_cast<state_t>(seed) | 1; // state must be nonzero
     prev = 0;
+    step = 0;
   }
 
   T get(void) {
     T ret;
 
-    if ((step & 1) == 0) {
-      ret  = 0;
-      ret |= rand();
-      // for uint64_t we need to call rand() twice
-      if (8 == sizeof(T)) {
-        // multiplication used instead of 32 bit shift for warning avoidance
-        ret *= 0x100000000;
-        ret |= rand();
-      }
+    if (0 == step) {
+      ret = static_cast<T>(next());
       prev = ret;
     }
     else {
       ret = ~prev;
     }
-    step++;
+    step ^= 1;
 
     return ret;
   }
+private:
+  typedef typename std::conditional<(sizeof(T) > 4), uint64_t, uint32_t>::type state_t;
 
-  testtype get_type(void) {
-    return MEMTEST_MOVING_INVERSION_RAND;
+  uint32_t xorshift(uint32_t x) {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return x;
   }
 
-private:
-  size_t step;
+  uint64_t xorshift(uint64_t x) {
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return x;
+  }
+
+  state_t next(void) {
+    state = xorshift(state);
+    return state;
+  }
+
+  state_t state;
   T prev;
+  uint8_t step;
 };
 
 /*
  *
  */
 template <typename T>
-static void memtest_sequential(memtest_t *testp, Generator<T> &generator, T seed) {
+static constexpr size_t width_index(void) {
+  return (1 == sizeof(T)) ? 0 : (2 == sizeof(T)) ? 1 : (4 == sizeof(T)) ? 2 : 3;
+}
+
+/*
+ *
+ */
+static size_t type_index(testtype type) {
+  size_t i = 0;
+
+  while ((type >>= 1) != 0)
+    i++;
+
+  return i;
+}
+
+/*
+ *
+ */
+static uint32_t bytes_per_second(size_t bytes, uint32_t ticks, uint32_t freq) {
+  if (0 == ticks)
+    return 0;
+
+  return static_cast<uint32_t>((static_cast<uint64_t>(bytes) * freq) / ticks);
+}
+
+/*
+ *
+ */
+static uint32_t clock_now(const memtest_t *testp) {
+  if (nullptr == testp->clock)
+    return 0;
+
+  return testp->clock();
+}
+
+/*
+ *
+ */
+template <typename T, typename G>
+static bool memtest_sequential(memtest_t *testp, testtype type, T seed) {
   const size_t steps = testp->size / sizeof(T);
-  size_t i;
-  T *mem = static_cast<T *>(testp->start);
-  T got;
-  T expect;
+  const size_t blocks = steps / MEMTEST_UNROLL;
+  volatile T *mem = static_cast<volatile T *>(testp->start);
+  memtest_stat_t *stat = &testp->stat[type_index(type)][width_index<T>()];
+  G generator;
+  size_t i, k;
+  uint32_t t0, t1, t2;
 
   /* fill ram */
+  t0 = clock_now(testp);
   generator.init(seed);
-  for (i=0; i<steps; i++)
+  for (i=0; i<blocks*MEMTEST_UNROLL; i+=MEMTEST_UNROLL) {
+    for (k=0; k<MEMTEST_UNROLL; k++)
+      mem[i + k] = generator.get();
+  }
+  for (; i<steps; i++)
     mem[i] = generator.get();
+  t1 = clock_now(testp);
 
-  /* read back and compare */
+  /* read back and compare, whole block is checked at once and the failing
+     element is searched only when mismatch detected. Memory is read once,
+     a transient fault would not show up on a second read */
   generator.init(seed);
-  for (i=0; i<steps; i++) {
-    got = mem[i];
-    expect = generator.get();
-    if ((got != expect) && (nullptr != testp->errcb)) {
-      testp->errcb(testp, generator.get_type(), i, sizeof(T), got, expect);
-      return;
+  for (i=0; i<steps; ) {
+    const size_t n = ((steps - i) >= MEMTEST_UNROLL) ? MEMTEST_UNROLL : 1;
+    G saved = generator;
+    T got[MEMTEST_UNROLL];
+    T diff = 0;
+
+    for (k=0; k<n; k++) {
+      got[k] = memtest_read(&mem[i + k]);
+      diff |= got[k] ^ generator.get();
     }
+
+    if (0 != diff) {
+      for (k=0; k<n; k++) {
+        T expect = saved.get();
+        if (got[k] != expect) {
+          if (nullptr != testp->errcb)
+            testp->errcb(testp, type, i + k, sizeof(T), got[k], expect);
+          break;
+        }
+      }
+      return false;
+    }
+    i += n;
   }
+  t2 = clock_now(testp);
+
+  stat->write_time += t1 - t0;
+  stat->read_time  += t2 - t1;
+  stat->bytes      += steps * sizeof(T);
+  stat->write_speed = bytes_per_second(stat->bytes, stat->write_time,
+                                       testp->clock_freq);
+  stat->read_speed  = bytes_per_second(stat->bytes, stat->read_time,
+                                       testp->clock_freq);
+  return true;
 }
 
 template <typename T>
 static void walking_one(memtest_t *testp) {
-  GeneratorWalkingOne<T> generator;
-  memtest_sequential<T>(testp, generator, 1);
+  memtest_sequential<T, GeneratorWalkingOne<T>>(testp, MEMTEST_WALKING_ONE, 1);
 }
 
 template <typename T>
 static void walking_zero(memtest_t *testp) {
-  GeneratorWalkingZero<T> generator;
-  memtest_sequential<T>(testp, generator, 1);
+  memtest_sequential<T, GeneratorWalkingZero<T>>(testp, MEMTEST_WALKING_ZERO, 1);
 }
 
 template <typename T>
 static void own_address(memtest_t *testp) {
-  GeneratorOwnAddress<T> generator;
-  memtest_sequential<T>(testp, generator, 0);
+  memtest_sequential<T, GeneratorOwnAddress<T>>(testp, MEMTEST_OWN_ADDRESS, 0);
 }
 
 template <typename T>
 static void moving_inversion_zero(memtest_t *testp) {
-  GeneratorMovingInv<T> generator;
   T seed;
   seed = 0;
-  memtest_sequential<T>(testp, generator, seed);
-  seed = ~seed;
-  memtest_sequential<T>(testp, generator, seed);
+  if (memtest_sequential<T, GeneratorMovingInv<T>>(testp,
+                          MEMTEST_MOVING_INVERSION_ZERO, seed)) {
+    seed = ~seed;
+    memtest_sequential<T, GeneratorMovingInv<T>>(testp,
+                          MEMTEST_MOVING_INVERSION_ZERO, seed);
+  }
 }
 
 template <typename T>
 static void moving_inversion_55aa(memtest_t *testp) {
-  GeneratorMovingInv<T> generator;
   T seed;
   memset(&seed, 0x55, sizeof(seed));
-  memtest_sequential<T>(testp, generator, seed);
-  seed = ~seed;
-  memtest_sequential<T>(testp, generator, seed);
+  if (memtest_sequential<T, GeneratorMovingInv<T>>(testp,
+                          MEMTEST_MOVING_INVERSION_55AA, seed)) {
+    seed = ~seed;
+    memtest_sequential<T, GeneratorMovingInv<T>>(testp,
+                          MEMTEST_MOVING_INVERSION_55AA, seed);
+  }
 }
 
 template <typename T>
 static void moving_inversion_rand(memtest_t *testp) {
-  GeneratorMovingInvRand<T> generator;
-  T mask = -1;
   prng_seed++;
-  memtest_sequential<T>(testp, generator, prng_seed & mask);
+  memtest_sequential<T, GeneratorMovingInvRand<T>>(testp,
+                        MEMTEST_MOVING_INVERSION_RAND, static_cast<T>(prng_seed));
 }
 
 /*
@@ -259,6 +362,8 @@ static void memtest_wrapper(memtest_t *testp,
  */
 void memtest_run(memtest_t *testp, uint32_t testmask) {
 
+  memset(testp->stat, 0, sizeof(testp->stat));
+
   if (testmask & MEMTEST_WALKING_ONE) {
     memtest_wrapper(testp,
         walking_one<uint8_t>,
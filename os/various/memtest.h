@@ -45,6 +45,12 @@
 #define MEMTEST_WIDTH_32  (1 << 2)
 #define MEMTEST_WIDTH_64  (1 << 3)
 
+/*
+ * Number of test types and data widths, dimensions of statistics table
+ */
+#define MEMTEST_TYPES_NUM   6
+#define MEMTEST_WIDTHS_NUM  4
+
 typedef struct memtest_t memtest_t;
 typedef uint32_t testtype;
 
@@ -54,6 +60,38 @@ typedef uint32_t testtype;
 typedef void (*memtestecb_t)(memtest_t *testp, testtype type, size_t index,
                            size_t current_width, uint32_t got, uint32_t expect);
 
+/*
+ * Time source call back. Must return free running counter value
+ * incrementing with clock_freq frequency (i.e. DWT cycle counter).
+ */
+typedef uint32_t (*memtestclk_t)(void);
+
+/*
+ * Statistics of single test type with single data width.
+ */
+typedef struct {
+  /*
+   * Time spent on filling memory in clock ticks.
+   */
+  uint32_t      write_time;
+  /*
+   * Time spent on reading back and checking memory in clock ticks.
+   */
+  uint32_t      read_time;
+  /*
+   * Amount of bytes written (same amount is read back).
+   */
+  size_t        bytes;
+  /*
+   * Achieved write bandwidth in bytes per second.
+   */
+  uint32_t      write_speed;
+  /*
+   * Achieved read bandwidth in bytes per second.
+   */
+  uint32_t      read_speed;
+} memtest_stat_t;
+
 /*
  *
  */
@@ -74,6 +112,19 @@ struct memtest_t {
    * Error callback pointer. Set to NULL if unused.
    */
   memtestecb_t  errcb;
+  /*
+   * Time source callback pointer. Set to NULL if statistics unneeded.
+   */
+  memtestclk_t  clock;
+  /*
+   * Frequency of time source in Hz.
+   */
+  uint32_t      clock_freq;
+  /*
+   * Statistics of the last memtest_run() indexed by test type bit
+   * number and data width (8, 16, 32, 64).
+   */
+  memtest_stat_t stat[MEMTEST_TYPES_NUM][MEMTEST_WIDTHS_NUM];
 };
 
 /*
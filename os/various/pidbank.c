@@ -0,0 +1,186 @@
+/**********************************************************************************************
+* PID controller bank.
+* Evaluates many PID loops in a single pass over structure-of-arrays storage,
+* in float, Q15 and Q31 arithmetic.
+*
+* This Library is licensed under the MIT License
+**********************************************************************************************/
+
+#include "pidbank.h"
+
+static inline int32_t clamp32(int32_t v, int32_t lo, int32_t hi)
+{
+    if(v > hi) return hi;
+    if(v < lo) return lo;
+    return v;
+}
+
+static inline int64_t clamp64(int64_t v, int64_t lo, int64_t hi)
+{
+    if(v > hi) return hi;
+    if(v < lo) return lo;
+    return v;
+}
+
+/* Gains() *************************************************************************
+*   Same scaling as pid_setTunings(): the integral and derivative gains are
+*   folded with the sample time so the banks don't need to know about time.
+**********************************************************************************/
+void pidbank_gains(float Kp, float Ki, float Kd, float sampleTimeSec,
+                   float* kp, float* ki, float* kd)
+{
+    *kp = Kp;
+    *ki = Ki * sampleTimeSec;
+    *kd = Kd / sampleTimeSec;
+}
+
+/* Initialize() ********************************************************************
+*   Does all the things that need to happen to ensure a bumpless transfer
+*   from manual to automatic mode, for every loop of the bank.
+**********************************************************************************/
+void pidbank_f32_initialize(pidbank_f32_t* b)
+{
+    for(size_t i = 0; i < b->n; i++)
+    {
+        float sum = b->output[i];
+        if(sum > b->outMax[i]) sum = b->outMax[i];
+        else if(sum < b->outMin[i]) sum = b->outMin[i];
+        b->outputSum[i] = sum;
+        b->lastInput[i] = b->input[i];
+        b->dFiltered[i] = 0;
+    }
+}
+
+bool pidbank_q15_initialize(pidbank_q15_t* b)
+{
+    if(b->shift > PIDBANK_Q15_SHIFT_MAX) return false;
+
+    for(size_t i = 0; i < b->n; i++)
+    {
+        b->outputSum[i] = clamp32(b->output[i], b->outMin[i], b->outMax[i]);
+        b->lastInput[i] = b->input[i];
+        b->dFiltered[i] = 0;
+    }
+    return true;
+}
+
+bool pidbank_q31_initialize(pidbank_q31_t* b)
+{
+    if(b->shift > PIDBANK_Q31_SHIFT_MAX) return false;
+
+    for(size_t i = 0; i < b->n; i++)
+    {
+        b->outputSum[i] = clamp32(b->output[i], b->outMin[i], b->outMax[i]);
+        b->lastInput[i] = b->input[i];
+        b->dFiltered[i] = 0;
+    }
+    return true;
+}
+
+/* Compute() ***********************************************************************
+*   One pass over all the loops: proportional on error, integral clamped to
+*   the output limits (anti-windup), derivative on measurement through a first
+*   order low pass filter: dFiltered += alpha * (dInput - dFiltered).
+**********************************************************************************/
+void pidbank_f32_compute(pidbank_f32_t* b)
+{
+    const size_t n = b->n;
+
+    for(size_t i = 0; i < n; i++)
+    {
+        float input = b->input[i];
+        float error = b->setPoint[i] - input;
+        float dInput = input - b->lastInput[i];
+        float outMin = b->outMin[i];
+        float outMax = b->outMax[i];
+
+        float sum = b->outputSum[i] + b->ki[i] * error;
+        if(sum > outMax) sum = outMax;
+        else if(sum < outMin) sum = outMin;
+
+        float dFiltered = b->dFiltered[i];
+        dFiltered += b->alpha[i] * (dInput - dFiltered);
+
+        float output = b->kp[i] * error + sum - b->kd[i] * dFiltered;
+        if(output > outMax) output = outMax;
+        else if(output < outMin) output = outMin;
+
+        b->output[i] = output;
+        b->outputSum[i] = sum;
+        b->dFiltered[i] = dFiltered;
+        b->lastInput[i] = input;
+    }
+}
+
+/*
+ * With shift <= PIDBANK_Q15_SHIFT_MAX every product is below 2^31 and the
+ * sum of the three terms below 2^30, so no intermediate saturation is needed.
+ */
+bool pidbank_q15_compute(pidbank_q15_t* b)
+{
+    if(b->shift > PIDBANK_Q15_SHIFT_MAX) return false;
+
+    const size_t n = b->n;
+    const unsigned sd = 15U - b->shift;
+
+    for(size_t i = 0; i < n; i++)
+    {
+        int32_t input = b->input[i];
+        int32_t error = (int32_t)b->setPoint[i] - input;
+        int32_t dInput = input - b->lastInput[i];
+        int32_t outMin = b->outMin[i];
+        int32_t outMax = b->outMax[i];
+
+        int32_t sum = b->outputSum[i] + ((b->ki[i] * error) >> sd);
+        sum = clamp32(sum, outMin, outMax);
+
+        /* Difference is up to 18 bits, halved to keep the product in 32 bits. */
+        int32_t dFiltered = b->dFiltered[i];
+        dFiltered += (((dInput - dFiltered) >> 1) * b->alpha[i]) >> 14;
+
+        int32_t output = ((b->kp[i] * error) >> sd) + sum
+                       - ((b->kd[i] * dFiltered) >> sd);
+
+        b->output[i] = (int16_t)clamp32(output, outMin, outMax);
+        b->outputSum[i] = sum;
+        b->dFiltered[i] = dFiltered;
+        b->lastInput[i] = (int16_t)input;
+    }
+    return true;
+}
+
+/*
+ * Error and input delta are saturated to the Q31 range so that the
+ * 64 bit products cannot overflow for shift <= PIDBANK_Q31_SHIFT_MAX.
+ */
+bool pidbank_q31_compute(pidbank_q31_t* b)
+{
+    if(b->shift > PIDBANK_Q31_SHIFT_MAX) return false;
+
+    const size_t n = b->n;
+    const unsigned sd = 31U - b->shift;
+
+    for(size_t i = 0; i < n; i++)
+    {
+        int32_t input = b->input[i];
+        int64_t error = clamp64((int64_t)b->setPoint[i] - input, INT32_MIN, INT32_MAX);
+        int64_t dInput = clamp64((int64_t)input - b->lastInput[i], INT32_MIN, INT32_MAX);
+        int32_t outMin = b->outMin[i];
+        int32_t outMax = b->outMax[i];
+
+        int64_t sum = (int64_t)b->outputSum[i] + ((b->ki[i] * error) >> sd);
+        sum = clamp64(sum, outMin, outMax);
+
+        int64_t dFiltered = b->dFiltered[i];
+        dFiltered += (((dInput - dFiltered) >> 1) * b->alpha[i]) >> 30;
+
+        int64_t output = ((b->kp[i] * error) >> sd) + sum
+                       - ((b->kd[i] * dFiltered) >> sd);
+
+        b->output[i] = (int32_t)clamp64(output, outMin, outMax);
+        b->outputSum[i] = (int32_t)sum;
+        b->dFiltered[i] = (int32_t)dFiltered;
+        b->lastInput[i] = input;
+    }
+    return true;
+}
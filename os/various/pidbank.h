@@ -0,0 +1,115 @@
+/**********************************************************************************************
+* PID controller bank.
+* Evaluates many PID loops in a single pass over structure-of-arrays storage,
+* in float, Q15 and Q31 arithmetic. Based on the pid.c algorithm (derivative
+* on measurement, integral clamped to output limits) with an additional
+* first order low pass filter on the derivative term.
+*
+* This Library is licensed under the MIT License
+**********************************************************************************************/
+
+#ifndef PIDBANK_h
+#define PIDBANK_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#define PIDBANK_Q15_SHIFT_MAX 12       // * largest shift keeping the Q15 products in 32 bits
+#define PIDBANK_Q31_SHIFT_MAX 28       // * largest shift keeping the Q31 products in 64 bits
+
+/*
+ * Float bank. ki and kd are per sample gains, see pidbank_gains().
+ * Every pointer refers to an array of n elements.
+ */
+typedef struct {
+    size_t n;                  // * number of loops
+
+    const float *kp;           // * gains
+    const float *ki;
+    const float *kd;
+    const float *alpha;        // * derivative filter coefficient 0..1, 1 = no filtering
+    const float *outMin;       // * output limits, also used for anti-windup
+    const float *outMax;
+
+    const float *setPoint;     // * inputs
+    const float *input;
+    float *output;             // * results
+
+    float *outputSum;          // * state
+    float *lastInput;
+    float *dFiltered;
+} pidbank_f32_t;
+
+/*
+ * Q15 bank. Signals are Q15, gains are Q15 scaled by 2^shift so that
+ * gains up to 2^shift are possible. alpha is Q15, 32767 = no filtering.
+ * All products fit in 32 bits, so this is the variant to use on cores
+ * without a fast 64 bit multiply.
+ */
+typedef struct {
+    size_t n;
+    uint8_t shift;             // * common gain scale, 0..PIDBANK_Q15_SHIFT_MAX
+
+    const int16_t *kp;
+    const int16_t *ki;
+    const int16_t *kd;
+    const int16_t *alpha;
+    const int16_t *outMin;
+    const int16_t *outMax;
+
+    const int16_t *setPoint;
+    const int16_t *input;
+    int16_t *output;
+
+    int32_t *outputSum;
+    int16_t *lastInput;
+    int32_t *dFiltered;
+} pidbank_q15_t;
+
+/*
+ * Q31 bank. Signals are Q31, gains are Q31 scaled by 2^shift.
+ * alpha is Q31, 0x7FFFFFFF = no filtering. Products are 64 bits wide.
+ */
+typedef struct {
+    size_t n;
+    uint8_t shift;             // * common gain scale, 0..PIDBANK_Q31_SHIFT_MAX
+
+    const int32_t *kp;
+    const int32_t *ki;
+    const int32_t *kd;
+    const int32_t *alpha;
+    const int32_t *outMin;
+    const int32_t *outMax;
+
+    const int32_t *setPoint;
+    const int32_t *input;
+    int32_t *output;
+
+    int32_t *outputSum;
+    int32_t *lastInput;
+    int32_t *dFiltered;
+} pidbank_q31_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void pidbank_gains(float Kp, float Ki, float Kd, float sampleTimeSec,  // * converts user gains into per sample
+                   float* kp, float* ki, float* kd);                   //   gains used by the banks
+
+void pidbank_f32_initialize(pidbank_f32_t* b);  // * bumpless start from current inputs and outputs
+bool pidbank_q15_initialize(pidbank_q15_t* b);  // * the fixed point banks return false, leaving the
+bool pidbank_q31_initialize(pidbank_q31_t* b);  //   state untouched, when shift is out of range
+
+void pidbank_f32_compute(pidbank_f32_t* b);     // * evaluates all loops of the bank, does not use any
+bool pidbank_q15_compute(pidbank_q15_t* b);     //   OS service so it can be called from a GPT callback
+bool pidbank_q31_compute(pidbank_q31_t* b);     //   running at the control rate. The fixed point banks
+                                                //   compute nothing and return false when shift is out
+                                                //   of range
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -113,6 +113,11 @@ void tribufSwapFrontI(tribuf_t *handler) {
   front = handler->orphan;
   handler->orphan = handler->front;
   handler->front = front;
+
+#if (TRIBUF_USE_WAIT == FALSE)
+  /* The new front buffer has been taken, signal consumed.*/
+  handler->ready = false;
+#endif
 }
 
 /**
@@ -0,0 +1,158 @@
+/*
+    ChibiOS - Copyright (C) 2026 agent
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    osal_host.c
+ * @brief   Minimal OSAL replacement for building modules on a host PC.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+#include "osal_host.h"
+
+struct osal_host_thread {
+  msg_t msg;
+};
+
+static pthread_mutex_t sys_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* Single condition for everything waiting under the system lock, woken
+   threads recheck their own condition.*/
+static pthread_cond_t sys_cond = PTHREAD_COND_INITIALIZER;
+
+static __thread struct osal_host_thread self;
+
+#if OSAL_HOST_VIRTUAL_TIME
+static uint32_t virtual_time;
+#endif
+
+void osalHostHalt(const char *file, int line, const char *reason) {
+
+  fprintf(stderr, "%s:%d: halted: %s\n", file, line, reason);
+  abort();
+}
+
+void osalHostLock(void) {
+
+  pthread_mutex_lock(&sys_lock);
+}
+
+void osalHostUnlock(void) {
+
+  pthread_mutex_unlock(&sys_lock);
+}
+
+systime_t osalHostGetTime(void) {
+#if OSAL_HOST_VIRTUAL_TIME
+  return __atomic_load_n(&virtual_time, __ATOMIC_RELAXED);
+#else
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (systime_t)((uint64_t)ts.tv_sec * 1000000U +
+                     (uint64_t)ts.tv_nsec / 1000U);
+#endif
+}
+
+void osalHostSleep(systime_t time) {
+#if OSAL_HOST_VIRTUAL_TIME
+  osalHostAdvanceTime(time);
+  sched_yield();
+#else
+  struct timespec ts;
+
+  ts.tv_sec  = time / 1000000U;
+  ts.tv_nsec = (long)(time % 1000000U) * 1000L;
+  nanosleep(&ts, NULL);
+#endif
+}
+
+/*
+ * Only virtual clock can be advanced, host clock runs on its own.
+ */
+void osalHostAdvanceTime(systime_t time) {
+#if OSAL_HOST_VIRTUAL_TIME
+  __atomic_fetch_add(&virtual_time, time, __ATOMIC_RELAXED);
+#else
+  (void)time;
+#endif
+}
+
+/*
+ * Waits for osalHostBroadcastI() from other thread, system lock must be
+ * taken and it is taken again on return.
+ */
+void osalHostWaitS(void) {
+
+  pthread_cond_wait(&sys_cond, &sys_lock);
+}
+
+void osalHostBroadcastI(void) {
+
+  pthread_cond_broadcast(&sys_cond);
+}
+
+msg_t osalThreadSuspendS(thread_reference_t *trp) {
+
+  *trp = &self;
+  while (NULL != *trp)
+    osalHostWaitS();
+  return self.msg;
+}
+
+/*
+ * The timeout is checked on system time every host millisecond, so it
+ * expires on virtual time advanced by other threads as well.
+ */
+msg_t osalThreadSuspendTimeoutS(thread_reference_t *trp,
+                                sysinterval_t timeout) {
+  systime_t start = osalHostGetTime();
+  struct timespec ts;
+
+  if (timeout == TIME_INFINITE)
+    return osalThreadSuspendS(trp);
+
+  *trp = &self;
+  while (NULL != *trp) {
+    if ((systime_t)(osalHostGetTime() - start) >= timeout) {
+      *trp = NULL;
+      return MSG_TIMEOUT;
+    }
+    clock_gettime(CLOCK_REALTIME, &ts);
+    ts.tv_nsec += 1000000L;
+    if (ts.tv_nsec >= 1000000000L) {
+      ts.tv_sec++;
+      ts.tv_nsec -= 1000000000L;
+    }
+    pthread_cond_timedwait(&sys_cond, &sys_lock, &ts);
+  }
+  return self.msg;
+}
+
+void osalThreadResumeI(thread_reference_t *trp, msg_t msg) {
+
+  if (NULL != *trp) {
+    (*trp)->msg = msg;
+    *trp = NULL;
+    osalHostBroadcastI();
+  }
+}
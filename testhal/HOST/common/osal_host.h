@@ -0,0 +1,147 @@
+/*
+    ChibiOS - Copyright (C) 2026 agent
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    osal_host.h
+ * @brief   Minimal OSAL replacement for building modules on a host PC.
+ * @details Provides just enough of the OSAL API for portable modules from
+ *          os/various and os/hal/src to be compiled and exercised by native
+ *          test programs. The system lock is a single global mutex so
+ *          I-class functions are serialized like on a target.
+ */
+
+#ifndef OSAL_HOST_H_
+#define OSAL_HOST_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+#if !defined(FALSE) || defined(__DOXYGEN__)
+#define FALSE                           0
+#endif
+
+#if !defined(TRUE) || defined(__DOXYGEN__)
+#define TRUE                            1
+#endif
+
+#define HAL_SUCCESS                     false
+#define HAL_FAILED                      true
+
+#define MSG_OK                          (msg_t)0
+#define MSG_TIMEOUT                     (msg_t)-1
+#define MSG_RESET                       (msg_t)-2
+
+#define TIME_IMMEDIATE                  ((systime_t)0)
+#define TIME_INFINITE                   ((systime_t)-1)
+
+/**
+ * @brief   Host system tick frequency, one tick per microsecond.
+ */
+#define OSAL_ST_FREQUENCY               1000000U
+
+/**
+ * @brief   System time is simulated instead of read from host clock.
+ * @details Sleeping just advances the time, peripheral emulators advance
+ *          it by duration of every operation. Simulated protocols with
+ *          long timeouts run at full host speed this way.
+ */
+#if !defined(OSAL_HOST_VIRTUAL_TIME) || defined(__DOXYGEN__)
+#define OSAL_HOST_VIRTUAL_TIME          FALSE
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+typedef int32_t msg_t;
+typedef uint32_t systime_t;
+typedef int32_t cnt_t;
+typedef uint32_t eventflags_t;
+typedef systime_t sysinterval_t;
+
+/**
+ * @brief   Reference to a suspended thread.
+ */
+typedef struct osal_host_thread *thread_reference_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+#define osalDbgCheck(c) do {                                                \
+  if (!(c))                                                                 \
+    osalHostHalt(__FILE__, __LINE__, #c);                                   \
+} while (false)
+
+#define osalDbgAssert(c, remark) do {                                       \
+  if (!(c))                                                                 \
+    osalHostHalt(__FILE__, __LINE__, remark);                               \
+} while (false)
+
+#define osalSysHalt(reason)     osalHostHalt(__FILE__, __LINE__, reason)
+
+#define osalDbgCheckClassI()
+#define osalDbgCheckClassS()
+
+#define osalSysLock()           osalHostLock()
+#define osalSysUnlock()         osalHostUnlock()
+#define osalSysLockFromISR()    osalHostLock()
+#define osalSysUnlockFromISR()  osalHostUnlock()
+#define osalOsRescheduleS()
+#define osalThreadResumeS(trp, msg) osalThreadResumeI(trp, msg)
+
+#define OSAL_US2ST(usec)        ((systime_t)(usec))
+#define OSAL_MS2ST(msec)        ((systime_t)(msec) * 1000U)
+#define OSAL_S2ST(sec)          ((systime_t)(sec) * 1000000U)
+#define OSAL_US2I(usec)         OSAL_US2ST(usec)
+#define OSAL_MS2I(msec)         OSAL_MS2ST(msec)
+#define TIME_MS2I(msec)         OSAL_MS2ST(msec)
+
+#define osalOsGetSystemTimeX()  osalHostGetTime()
+#define osalThreadSleepMicroseconds(usec) osalHostSleep(OSAL_US2ST(usec))
+#define osalThreadSleepMilliseconds(msec) osalHostSleep(OSAL_MS2ST(msec))
+#define osalThreadSleep(time)   osalHostSleep(time)
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void osalHostHalt(const char *file, int line, const char *reason);
+  void osalHostLock(void);
+  void osalHostUnlock(void);
+  systime_t osalHostGetTime(void);
+  void osalHostSleep(systime_t time);
+  void osalHostAdvanceTime(systime_t time);
+  void osalHostWaitS(void);
+  void osalHostBroadcastI(void);
+  msg_t osalThreadSuspendS(thread_reference_t *trp);
+  msg_t osalThreadSuspendTimeoutS(thread_reference_t *trp,
+                                  sysinterval_t timeout);
+  void osalThreadResumeI(thread_reference_t *trp, msg_t msg);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OSAL_HOST_H_ */
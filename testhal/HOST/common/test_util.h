@@ -0,0 +1,119 @@
+/*
+    ChibiOS - Copyright (C) 2026 agent
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    test_util.h
+ * @brief   Harness shared by the host test suites.
+ * @details Checks count failures and print them to stderr, measurements
+ *          are printed to stdout as one JSON object per line. Every suite
+ *          is a single translation unit, so everything here is static.
+ */
+
+#ifndef TEST_UTIL_H_
+#define TEST_UTIL_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+
+/**
+ * @brief   Checks a property, counts and prints the failure.
+ */
+#define CHECK(c) do {                                                       \
+  if (!(c)) {                                                               \
+    fprintf(stderr, "%s:%d: check failed: %s\n",                            \
+            __FILE__, __LINE__, #c);                                        \
+    test_failures++;                                                        \
+  }                                                                         \
+} while (false)
+
+/**
+ * @brief   Number of failed checks.
+ */
+static unsigned test_failures = 0;
+
+/**
+ * @brief   JSON members appended to every report, starting with a comma.
+ * @note    Set by the suite to tell the build variants apart.
+ */
+static const char *test_report_extra = "";
+
+/**
+ * @brief   Random generator state, fixed seed gives reproducible runs.
+ */
+static uint32_t test_seed32 = 12345;
+static uint64_t test_seed64 = 0x123456789ULL;
+
+/**
+ * @brief   Prints one measurement.
+ */
+static inline void test_report(const char *suite, const char *name,
+                               const char *metric, double value,
+                               const char *unit) {
+
+  printf("{\"suite\":\"%s\",\"case\":\"%s\",\"metric\":\"%s\","
+         "\"value\":%.6f,\"unit\":\"%s\"%s}\n",
+         suite, name, metric, value, unit, test_report_extra);
+}
+
+/**
+ * @brief   Host monotonic time in seconds, for host side benchmarks.
+ */
+static inline double test_seconds(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief   xorshift32 pseudo random numbers.
+ */
+static inline uint32_t test_random32(void) {
+
+  test_seed32 ^= test_seed32 << 13;
+  test_seed32 ^= test_seed32 >> 17;
+  test_seed32 ^= test_seed32 << 5;
+  return test_seed32;
+}
+
+/**
+ * @brief   xorshift64 pseudo random numbers.
+ */
+static inline uint64_t test_random64(void) {
+
+  test_seed64 ^= test_seed64 << 13;
+  test_seed64 ^= test_seed64 >> 7;
+  test_seed64 ^= test_seed64 << 17;
+  return test_seed64;
+}
+
+/**
+ * @brief   Prints the failure summary.
+ *
+ * @return              Process exit status.
+ */
+static inline int test_summary(void) {
+
+  if (test_failures != 0) {
+    fprintf(stderr, "%u check(s) failed\n", test_failures);
+    return 1;
+  }
+  return 0;
+}
+
+#endif /* TEST_UTIL_H_ */
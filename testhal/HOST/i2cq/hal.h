@@ -0,0 +1,108 @@
+/*
+    ChibiOS - Copyright (C) 2026 agent
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal.h
+ * @brief   Host replacement of HAL header for I2C queue tests.
+ * @details I2C driver is emulated in @p hal_host.c on top of the simulated
+ *          bus.
+ */
+
+#ifndef HAL_H_
+#define HAL_H_
+
+#include <pthread.h>
+
+#include "osal_host.h"
+#include "i2csim.h"
+
+/*
+ * Drivers settings.
+ */
+#define HAL_USE_I2C                     TRUE
+#define I2C_USE_MUTUAL_EXCLUSION        TRUE
+
+/*
+ * Architecture, needed by bswap.h.
+ */
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define ARCH_LITTLE_ENDIAN
+#endif
+
+/*
+ * I2C subset.
+ */
+#define I2C_NO_ERROR                    0x00U
+#define I2C_BUS_ERROR                   0x01U
+#define I2C_ARBITRATION_LOST            0x02U
+#define I2C_ACK_FAILURE                 0x04U
+#define I2C_OVERRUN                     0x08U
+#define I2C_PEC_ERROR                   0x10U
+#define I2C_TIMEOUT                     0x20U
+#define I2C_SMB_ALERT                   0x40U
+
+typedef enum {
+  I2C_UNINIT = 0,
+  I2C_STOP = 1,
+  I2C_READY = 2,
+  I2C_ACTIVE_TX = 3,
+  I2C_ACTIVE_RX = 4,
+  I2C_LOCKED = 5
+} i2cstate_t;
+
+typedef uint16_t i2caddr_t;
+typedef uint32_t i2cflags_t;
+
+typedef struct {
+  uint32_t                  clock_speed;
+} I2CConfig;
+
+typedef struct {
+  i2cstate_t                state;
+  const I2CConfig           *config;
+  i2cflags_t                errors;
+  /* Emulation.*/
+  i2csim_bus_t              *bus;
+  pthread_mutex_t           mutex;
+  uint32_t                  starts;
+  uint32_t                  acquisitions;
+} I2CDriver;
+
+#define i2cGetErrors(i2cp)              ((i2cp)->errors)
+
+#define i2cMasterReceive(i2cp, addr, rxbuf, rxbytes)                        \
+  (i2cMasterReceiveTimeout(i2cp, addr, rxbuf, rxbytes, TIME_INFINITE))
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void i2cObjectInit(I2CDriver *i2cp, i2csim_bus_t *bus);
+  void i2cStart(I2CDriver *i2cp, const I2CConfig *config);
+  void i2cStop(I2CDriver *i2cp);
+  msg_t i2cMasterTransmitTimeout(I2CDriver *i2cp, i2caddr_t addr,
+                                 const uint8_t *txbuf, size_t txbytes,
+                                 uint8_t *rxbuf, size_t rxbytes,
+                                 sysinterval_t timeout);
+  msg_t i2cMasterReceiveTimeout(I2CDriver *i2cp, i2caddr_t addr,
+                                uint8_t *rxbuf, size_t rxbytes,
+                                sysinterval_t timeout);
+  void i2cAcquireBus(I2CDriver *i2cp);
+  void i2cReleaseBus(I2CDriver *i2cp);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HAL_H_ */
@@ -0,0 +1,128 @@
+/*
+    ChibiOS - Copyright (C) 2026 agent
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_host.c
+ * @brief   I2C driver emulated on top of simulated bus.
+ * @details Transactions are synchronous like on a target, the calling
+ *          thread sleeps for the wire time of the transaction. Stuck
+ *          target makes the transaction last for its whole timeout and
+ *          leaves the driver locked, as the real driver does.
+ */
+
+#include "hal.h"
+
+/*===========================================================================*/
+/* Local functions.                                                          */
+/*===========================================================================*/
+
+static msg_t transfer(I2CDriver *i2cp, i2caddr_t addr,
+                      const uint8_t *txbuf, size_t txbytes,
+                      uint8_t *rxbuf, size_t rxbytes,
+                      sysinterval_t timeout) {
+  i2csim_bus_t *bus = i2cp->bus;
+  int res;
+
+  osalDbgAssert(I2C_READY == i2cp->state, "not ready");
+  i2cp->state = (txbytes > 0U) ? I2C_ACTIVE_TX : I2C_ACTIVE_RX;
+  i2cp->errors = I2C_NO_ERROR;
+
+  /* Transactions of a bus never overlap when it is locked properly.*/
+  if (__atomic_exchange_n(&bus->active, true, __ATOMIC_ACQ_REL))
+    __atomic_fetch_add(&bus->overlaps, 1U, __ATOMIC_RELAXED);
+
+  res = i2csimTransfer(bus, (uint8_t)addr, txbuf, txbytes, rxbuf, rxbytes);
+  if (I2CSIM_STUCK == res) {
+    osalDbgAssert(TIME_INFINITE != timeout, "bus hangs forever");
+    bus->bus_time += timeout;
+    osalThreadSleep(timeout);
+    __atomic_store_n(&bus->active, false, __ATOMIC_RELEASE);
+    i2cp->errors = I2C_TIMEOUT;
+    i2cp->state = I2C_LOCKED;
+    return MSG_TIMEOUT;
+  }
+
+  bus->bus_time += i2csimDuration(bus, txbytes, rxbytes);
+  osalThreadSleep(i2csimDuration(bus, txbytes, rxbytes));
+  __atomic_store_n(&bus->active, false, __ATOMIC_RELEASE);
+  i2cp->state = I2C_READY;
+  if (I2CSIM_NACK == res) {
+    i2cp->errors = I2C_ACK_FAILURE;
+    return MSG_RESET;
+  }
+  return MSG_OK;
+}
+
+/*===========================================================================*/
+/* Exported functions.                                                       */
+/*===========================================================================*/
+
+void i2cObjectInit(I2CDriver *i2cp, i2csim_bus_t *bus) {
+
+  i2cp->state = I2C_STOP;
+  i2cp->config = NULL;
+  i2cp->errors = I2C_NO_ERROR;
+  i2cp->bus = bus;
+  i2cp->starts = 0;
+  i2cp->acquisitions = 0;
+  pthread_mutex_init(&i2cp->mutex, NULL);
+}
+
+void i2cStart(I2CDriver *i2cp, const I2CConfig *config) {
+
+  osalDbgCheck((NULL != i2cp) && (NULL != config));
+
+  i2cp->config = config;
+  i2cp->bus->clock = config->clock_speed;
+  i2cp->state = I2C_READY;
+  i2cp->starts++;
+}
+
+void i2cStop(I2CDriver *i2cp) {
+
+  i2cp->state = I2C_STOP;
+}
+
+msg_t i2cMasterTransmitTimeout(I2CDriver *i2cp, i2caddr_t addr,
+                               const uint8_t *txbuf, size_t txbytes,
+                               uint8_t *rxbuf, size_t rxbytes,
+                               sysinterval_t timeout) {
+
+  osalDbgCheck((NULL != i2cp) && (txbytes > 0U) && (NULL != txbuf) &&
+               ((0U == rxbytes) || (NULL != rxbuf)));
+
+  return transfer(i2cp, addr, txbuf, txbytes, rxbuf, rxbytes, timeout);
+}
+
+msg_t i2cMasterReceiveTimeout(I2CDriver *i2cp, i2caddr_t addr,
+                              uint8_t *rxbuf, size_t rxbytes,
+                              sysinterval_t timeout) {
+
+  osalDbgCheck((NULL != i2cp) && (rxbytes > 0U) && (NULL != rxbuf));
+
+  return transfer(i2cp, addr, NULL, 0, rxbuf, rxbytes, timeout);
+}
+
+void i2cAcquireBus(I2CDriver *i2cp) {
+
+  pthread_mutex_lock(&i2cp->mutex);
+  i2cp->acquisitions++;
+}
+
+void i2cReleaseBus(I2CDriver *i2cp) {
+
+  pthread_mutex_unlock(&i2cp->mutex);
+}
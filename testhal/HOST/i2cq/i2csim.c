@@ -0,0 +1,156 @@
+/*
+    ChibiOS - Copyright (C) 2026 agent
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    i2csim.c
+ * @brief   Simulated I2C bus with register file and 24xx EEPROM targets.
+ * @details Write part of a transaction sets the target address pointer
+ *          (and stores data bytes), read part returns memory from the
+ *          pointer on. Time is counted as 9 clocks per byte plus one byte
+ *          for start and stop conditions.
+ */
+
+#include "i2csim.h"
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+static i2csim_target_t *find(i2csim_bus_t *bus, uint8_t addr) {
+  size_t i;
+
+  for (i = 0; i < bus->count; i++) {
+    if (bus->targets[i].addr == addr)
+      return &bus->targets[i];
+  }
+  return NULL;
+}
+
+static size_t mem_size(const i2csim_target_t *tp) {
+
+  return (I2CSIM_REGS == tp->model) ? 256U : I2CSIM_MEM_SIZE;
+}
+
+static void store(i2csim_target_t *tp, const uint8_t *txbuf, size_t txbytes) {
+  size_t i, hdr = (I2CSIM_REGS == tp->model) ? 1U : 2U;
+
+  if (txbytes < hdr)
+    return;
+  if (1U == hdr)
+    tp->ptr = txbuf[0];
+  else
+    tp->ptr = (uint16_t)(((txbuf[0] << 8) | txbuf[1]) % I2CSIM_MEM_SIZE);
+
+  for (i = hdr; i < txbytes; i++) {
+    if (I2CSIM_REGS == tp->model) {
+      tp->mem[tp->ptr] = txbuf[i];
+      tp->ptr = (tp->ptr + 1U) % 256U;
+    }
+    else {
+      /* Page write wraps to the page start.*/
+      uint16_t page = (uint16_t)(tp->ptr - tp->ptr % tp->pagesize);
+
+      tp->mem[tp->ptr] = txbuf[i];
+      tp->ptr = (uint16_t)(page + (tp->ptr + 1U - page) % tp->pagesize);
+    }
+  }
+  if ((I2CSIM_EEPROM == tp->model) && (txbytes > hdr))
+    tp->busy_until = osalOsGetSystemTimeX() + tp->write_time;
+}
+
+static void load(i2csim_target_t *tp, uint8_t *rxbuf, size_t rxbytes) {
+  size_t i;
+
+  for (i = 0; i < rxbytes; i++) {
+    rxbuf[i] = tp->mem[tp->ptr];
+    tp->ptr = (uint16_t)((tp->ptr + 1U) % mem_size(tp));
+  }
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a target, memory is filled with its offsets.
+ */
+void i2csimTargetInit(i2csim_target_t *tp, uint8_t addr,
+                      i2csim_model_t model) {
+  size_t i;
+
+  memset(tp, 0, sizeof(*tp));
+  tp->addr = addr;
+  tp->model = model;
+  tp->pagesize = 32;
+  tp->write_time = OSAL_MS2I(5);
+  for (i = 0; i < I2CSIM_MEM_SIZE; i++)
+    tp->mem[i] = (uint8_t)i;
+}
+
+void i2csimBusInit(i2csim_bus_t *bus, i2csim_target_t *targets,
+                   size_t count, uint32_t clock) {
+
+  memset(bus, 0, sizeof(*bus));
+  bus->targets = targets;
+  bus->count = count;
+  bus->clock = clock;
+}
+
+/**
+ * @brief   Wire time of a complete transaction.
+ */
+sysinterval_t i2csimDuration(const i2csim_bus_t *bus,
+                             size_t txbytes, size_t rxbytes) {
+  uint64_t bytes = 1U;                  /* start and stop conditions */
+
+  if (txbytes > 0U)
+    bytes += 1U + txbytes;
+  if (rxbytes > 0U)
+    bytes += 1U + rxbytes;
+  return (sysinterval_t)((bytes * 9U * OSAL_ST_FREQUENCY + bus->clock - 1U) /
+                         bus->clock);
+}
+
+/**
+ * @brief   Performs a transaction, write part first.
+ *
+ * @return              One of @p I2CSIM_OK, @p I2CSIM_NACK or
+ *                      @p I2CSIM_STUCK.
+ */
+int i2csimTransfer(i2csim_bus_t *bus, uint8_t addr,
+                   const uint8_t *txbuf, size_t txbytes,
+                   uint8_t *rxbuf, size_t rxbytes) {
+  i2csim_target_t *tp = find(bus, addr);
+
+  bus->transactions++;
+  if (NULL == tp)
+    return I2CSIM_NACK;
+  if (tp->stuck)
+    return I2CSIM_STUCK;
+  tp->transactions++;
+  if ((I2CSIM_EEPROM == tp->model) &&
+      ((int32_t)(osalOsGetSystemTimeX() - tp->busy_until) < 0)) {
+    /* Write cycle in progress.*/
+    tp->nacks++;
+    return I2CSIM_NACK;
+  }
+
+  if (txbytes > 0U)
+    store(tp, txbuf, txbytes);
+  if (rxbytes > 0U)
+    load(tp, rxbuf, rxbytes);
+  return I2CSIM_OK;
+}
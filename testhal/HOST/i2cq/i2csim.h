@@ -0,0 +1,143 @@
+/*
+    ChibiOS - Copyright (C) 2026 agent
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    i2csim.h
+ * @brief   Simulated I2C bus with register file and 24xx EEPROM targets.
+ * @details Bus is simulated on transaction level. Emulated I2C driver
+ *          passes every transaction to @p i2csimTransfer() which returns
+ *          its outcome and the time it takes on the wire.
+ */
+
+#ifndef I2CSIM_H_
+#define I2CSIM_H_
+
+#include "osal.h"
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Size of the target memory.
+ */
+#define I2CSIM_MEM_SIZE             4096U
+
+/**
+ * @brief   Transaction outcomes.
+ */
+#define I2CSIM_OK                   0   /**< Completed.                     */
+#define I2CSIM_NACK                 1   /**< Address or data not ACKed.     */
+#define I2CSIM_STUCK                2   /**< SCL held low, never ends.      */
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Target models.
+ */
+typedef enum {
+  I2CSIM_REGS = 0,              /**< 256 registers, 1 byte auto-increment
+                                     pointer.                            */
+  I2CSIM_EEPROM = 1             /**< 24xx EEPROM, 2 bytes address, page
+                                     wrap, NACK during write cycle.      */
+} i2csim_model_t;
+
+/**
+ * @brief   Simulated target.
+ */
+typedef struct {
+  /**
+   * @brief   Address and model.
+   */
+  uint8_t         addr;
+  i2csim_model_t  model;
+  /**
+   * @brief   Target holds SCL low. May be changed on the fly.
+   */
+  bool            stuck;
+  /**
+   * @brief   EEPROM page size and write cycle time.
+   */
+  size_t          pagesize;
+  sysinterval_t   write_time;
+  /**
+   * @brief   End of the write cycle in progress.
+   */
+  systime_t       busy_until;
+  /**
+   * @brief   Memory and its address pointer.
+   */
+  uint16_t        ptr;
+  uint8_t         mem[I2CSIM_MEM_SIZE];
+  /**
+   * @brief   Statistics.
+   */
+  uint32_t        transactions;
+  uint32_t        nacks;
+} i2csim_target_t;
+
+/**
+ * @brief   Simulated bus.
+ */
+typedef struct {
+  /**
+   * @brief   Targets connected to bus.
+   */
+  i2csim_target_t *targets;
+  size_t          count;
+  /**
+   * @brief   SCL frequency in Hz.
+   */
+  uint32_t        clock;
+  /**
+   * @brief   Transaction on wire, set by emulated driver.
+   */
+  bool            active;
+  /**
+   * @brief   Statistics, overlapping transactions mean a broken lock.
+   */
+  uint32_t        transactions;
+  uint32_t        overlaps;
+  uint64_t        bus_time;
+} i2csim_bus_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void i2csimTargetInit(i2csim_target_t *tp, uint8_t addr,
+                        i2csim_model_t model);
+  void i2csimBusInit(i2csim_bus_t *bus, i2csim_target_t *targets,
+                     size_t count, uint32_t clock);
+  sysinterval_t i2csimDuration(const i2csim_bus_t *bus,
+                               size_t txbytes, size_t rxbytes);
+  int i2csimTransfer(i2csim_bus_t *bus, uint8_t addr,
+                     const uint8_t *txbuf, size_t txbytes,
+                     uint8_t *rxbuf, size_t rxbytes);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* I2CSIM_H_ */
@@ -0,0 +1,481 @@
+/*
+    ChibiOS - Copyright (C) 2026 agent
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/*
+ * I2C transaction queue tests against simulated bus.
+ *
+ * Queue code runs unmodified, only the I2C driver underneath is emulated.
+ * Bus time is simulated, so reported latencies are the ones expected on
+ * real bus. Results are printed as one JSON object per line, failures go
+ * to stderr.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+#include "hal.h"
+#include "i2cq.h"
+#include "i2c_helpers.h"
+#include "test_util.h"
+
+/*
+ ******************************************************************************
+ * DEFINES
+ ******************************************************************************
+ */
+
+#define BUS_CLOCK           400000U
+
+#define ADDR_IMU            0x6AU
+#define ADDR_SENSOR         0x40U
+#define ADDR_EEPROM         0x50U
+#define ADDR_ABSENT         0x77U
+
+#define CLIENTS             3
+#define ITERATIONS          200
+
+#define POOL                8
+#define BUF_SIZE            40
+/*
+ ******************************************************************************
+ * TYPES
+ ******************************************************************************
+ */
+
+/*
+ * Periodic traffic of one client in latency benchmark.
+ */
+typedef struct {
+  const char        *name;
+  i2cq_client_t     client;
+  i2cq_request_t    pool[POOL];
+  uint8_t           buf[POOL][BUF_SIZE];
+  uint8_t           addr;
+  size_t            txbytes;
+  size_t            rxbytes;
+  /* Requests per arrival and period, zero period means next arrival is
+     scheduled by completion.*/
+  unsigned          burst;
+  sysinterval_t     period;
+  sysinterval_t     gap;
+  systime_t         next;
+  bool              waiting;
+  uint32_t          overflows;
+} stream_t;
+
+/*
+ ******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************
+ */
+
+static const I2CConfig i2ccfg = {BUS_CLOCK};
+
+static i2csim_target_t targets[4];
+static i2csim_bus_t sim;
+static I2CDriver i2cd;
+static i2cq_t queue;
+
+static unsigned order[8];
+static unsigned order_count;
+
+/*
+ ******************************************************************************
+ * LOCAL FUNCTIONS
+ ******************************************************************************
+ */
+
+static void bus_open(void) {
+
+  i2csimTargetInit(&targets[0], ADDR_IMU, I2CSIM_REGS);
+  i2csimTargetInit(&targets[1], ADDR_SENSOR, I2CSIM_REGS);
+  i2csimTargetInit(&targets[2], ADDR_SENSOR + 1U, I2CSIM_REGS);
+  i2csimTargetInit(&targets[3], ADDR_EEPROM, I2CSIM_EEPROM);
+  i2csimBusInit(&sim, targets, 4, BUS_CLOCK);
+  i2cObjectInit(&i2cd, &sim);
+  i2cStart(&i2cd, &i2ccfg);
+  i2cqObjectInit(&queue, &i2cd);
+}
+
+static void *worker_thread(void *arg) {
+
+  i2cqServe(arg);
+  return NULL;
+}
+
+/*
+ * Direct queue calls, write then read back of own register window.
+ */
+static void *client_thread(void *arg) {
+  i2cq_client_t *cp = arg;
+  uint8_t base = (uint8_t)(cp->prio * 16U);
+  uint8_t addr = (uint8_t)(ADDR_IMU);
+  unsigned i;
+
+  for (i = 0; i < ITERATIONS; i++) {
+    uint8_t tx[5] = {(uint8_t)(base + i % 8U), (uint8_t)i, (uint8_t)(i >> 8),
+                     cp->prio, 0xA5};
+    uint8_t rx[4];
+
+    if (MSG_OK != i2cqMasterTransmitTimeout(cp, addr, tx, 5, NULL, 0,
+                                            OSAL_MS2I(10)))
+      return cp;
+    if (MSG_OK != i2cqMasterTransmitTimeout(cp, addr, tx, 1, rx, 4,
+                                            OSAL_MS2I(10)))
+      return cp;
+    if (0 != memcmp(&tx[1], rx, 4))
+      return cp;
+  }
+  return NULL;
+}
+
+/*
+ * Same traffic through the driver helpers of devices_lib.
+ */
+static void *helper_thread(void *arg) {
+  I2CHelper helper = {&i2cd, ADDR_SENSOR, arg};
+  unsigned i;
+
+  for (i = 0; i < ITERATIONS; i++) {
+    uint8_t tx[3] = {(uint8_t)(i % 200U), (uint8_t)i, 0x5A};
+    uint8_t rx[2];
+
+    if (MSG_OK != _i2c_send(&helper, tx, 3))
+      return arg;
+    if (MSG_OK != _i2c_send(&helper, tx, 1))
+      return arg;
+    if (MSG_OK != _i2c_receive(&helper, rx, 2))
+      return arg;
+    if (0 != memcmp(&tx[1], rx, 2))
+      return arg;
+  }
+  return NULL;
+}
+
+static void record_order(i2cq_request_t *rp) {
+
+  order[order_count++] = (unsigned)(uintptr_t)rp->arg;
+}
+
+static void eeprom_done(i2cq_request_t *rp) {
+  stream_t *sp = rp->arg;
+
+  sp->next = osalOsGetSystemTimeX() + sp->gap;
+  sp->waiting = false;
+}
+
+static void stream_init(stream_t *sp, const char *name, uint8_t addr,
+                        size_t txbytes, size_t rxbytes, unsigned burst,
+                        sysinterval_t period, uint8_t prio,
+                        sysinterval_t deadline) {
+
+  memset(sp, 0, sizeof(*sp));
+  sp->name = name;
+  sp->addr = addr;
+  sp->txbytes = txbytes;
+  sp->rxbytes = rxbytes;
+  sp->burst = burst;
+  sp->period = period;
+  sp->gap = OSAL_MS2I(5);
+  sp->next = osalOsGetSystemTimeX();
+  i2cqClientObjectInit(&sp->client, &queue, prio, deadline);
+}
+
+/*
+ * Queues arrivals due until now, every request accounted from its arrival
+ * time, as if it had been submitted while the bus was busy.
+ */
+static void stream_arrivals(stream_t *sp, systime_t now) {
+
+  while (!sp->waiting && ((int32_t)(now - sp->next) >= 0)) {
+    systime_t arrival = sp->next;
+    unsigned n;
+
+    for (n = 0; n < sp->burst; n++) {
+      i2cq_request_t *rp = NULL;
+      size_t i;
+
+      for (i = 0; i < POOL; i++) {
+        if ((I2CQ_REQ_IDLE == sp->pool[i].state) ||
+            (I2CQ_REQ_DONE == sp->pool[i].state)) {
+          rp = &sp->pool[i];
+          break;
+        }
+      }
+      if (NULL == rp) {
+        sp->overflows++;
+        continue;
+      }
+      memset(sp->buf[i], (int)n, sp->txbytes);
+      i2cqRequestObjectInit(rp, &sp->client, sp->addr,
+                            sp->buf[i], sp->txbytes,
+                            sp->rxbytes > 0U ? sp->buf[i] : NULL,
+                            sp->rxbytes);
+      if (0U == sp->period) {
+        rp->cb = eeprom_done;
+        rp->arg = sp;
+      }
+      osalSysLock();
+      i2cqSubmitI(rp);
+      rp->submitted = arrival;
+      osalSysUnlock();
+    }
+
+    if (0U == sp->period)
+      sp->waiting = true;
+    else
+      sp->next += sp->period;
+  }
+}
+
+/*
+ * IMU, sensor bursts and EEPROM logging sharing one bus for 2 s.
+ */
+static void latency_run(bool prio, stream_t *imu, uint64_t *busy) {
+  stream_t streams[3];
+  systime_t start, end, now;
+  uint64_t bus0;
+  size_t i;
+
+  bus_open();
+  stream_init(&streams[0], "imu", ADDR_IMU, 1, 12, 1, OSAL_MS2I(1),
+              prio ? 3 : 0, prio ? OSAL_MS2I(2) : I2CQ_NO_DEADLINE);
+  stream_init(&streams[1], "sensors", ADDR_SENSOR, 1, 4, 8, OSAL_MS2I(20),
+              prio ? 1 : 0, prio ? OSAL_MS2I(20) : I2CQ_NO_DEADLINE);
+  stream_init(&streams[2], "eeprom", ADDR_EEPROM, 34, 0, 1, 0,
+              0, I2CQ_NO_DEADLINE);
+
+  start = osalOsGetSystemTimeX();
+  end = start + OSAL_S2ST(2);
+  bus0 = sim.bus_time;
+  while ((int32_t)((now = osalOsGetSystemTimeX()) - end) < 0) {
+    systime_t next = end;
+
+    for (i = 0; i < 3; i++)
+      stream_arrivals(&streams[i], now);
+    if (i2cqProcess(&queue))
+      continue;
+
+    /* Bus idle, time jumps to the next arrival.*/
+    for (i = 0; i < 3; i++) {
+      if (!streams[i].waiting && ((int32_t)(streams[i].next - next) < 0))
+        next = streams[i].next;
+    }
+    osalHostAdvanceTime(next - now);
+  }
+  while (i2cqProcess(&queue))
+    ;
+
+  for (i = 0; i < 3; i++) {
+    const i2cq_stats_t *st = &streams[i].client.stats;
+    const char *suite = prio ? "i2cq_prio" : "i2cq_fifo";
+
+    CHECK(0 == streams[i].overflows);
+    CHECK(0 == st->errors);
+    CHECK(st->requests > 0);
+    test_report(suite, streams[i].name, "requests", st->requests, "count");
+    test_report(suite, streams[i].name, "latency_mean",
+                (double)st->latency_sum / st->requests, "us");
+    test_report(suite, streams[i].name, "latency_max", st->latency_max, "us");
+    test_report(suite, streams[i].name, "missed", st->missed, "count");
+  }
+  *imu = streams[0];
+  *busy = sim.bus_time - bus0;
+  CHECK(0 == sim.overlaps);
+}
+
+/*
+ ******************************************************************************
+ * SUITES
+ ******************************************************************************
+ */
+
+static void threads_suite(void) {
+  static i2cq_client_t clients[CLIENTS + 1];
+  pthread_t worker, t[CLIENTS + 1];
+  size_t i;
+
+  bus_open();
+  for (i = 0; i <= CLIENTS; i++)
+    i2cqClientObjectInit(&clients[i], &queue, (uint8_t)i, I2CQ_NO_DEADLINE);
+
+  pthread_create(&worker, NULL, worker_thread, &queue);
+  for (i = 0; i < CLIENTS; i++)
+    pthread_create(&t[i], NULL, client_thread, &clients[i]);
+  pthread_create(&t[CLIENTS], NULL, helper_thread, &clients[CLIENTS]);
+  for (i = 0; i <= CLIENTS; i++) {
+    void *ret;
+
+    pthread_join(t[i], &ret);
+    CHECK(NULL == ret);
+  }
+  i2cqStop(&queue);
+  pthread_join(worker, NULL);
+
+  for (i = 0; i < CLIENTS; i++)
+    CHECK(2 * ITERATIONS == clients[i].stats.requests);
+  CHECK(3 * ITERATIONS == clients[CLIENTS].stats.requests);
+  CHECK((2 * CLIENTS + 3) * ITERATIONS == queue.transactions);
+  CHECK(queue.transactions == sim.transactions);
+  CHECK(queue.runs <= queue.transactions);
+  CHECK(0 == sim.overlaps);
+  CHECK(NULL == queue.head);
+  test_report("i2cq", "threads", "transactions", queue.transactions, "count");
+  test_report("i2cq", "threads", "bus_acquisitions", queue.runs, "count");
+}
+
+static void order_suite(void) {
+  i2cq_client_t lo, mid, hi;
+  i2cq_request_t req[5];
+  uint8_t reg = 0;
+  uint8_t rx[5][2];
+  static const unsigned expected[5] = {3, 2, 1, 0, 4};
+  size_t i;
+
+  bus_open();
+  i2cqClientObjectInit(&lo, &queue, 0, I2CQ_NO_DEADLINE);
+  i2cqClientObjectInit(&mid, &queue, 1, I2CQ_NO_DEADLINE);
+  i2cqClientObjectInit(&hi, &queue, 2, OSAL_MS2I(10));
+
+  /* Priority first, then deadline, then arrival.*/
+  i2cqRequestObjectInit(&req[0], &lo, ADDR_IMU, &reg, 1, rx[0], 2);
+  i2cqRequestObjectInit(&req[1], &mid, ADDR_IMU, &reg, 1, rx[1], 2);
+  i2cqRequestObjectInit(&req[2], &hi, ADDR_IMU, &reg, 1, rx[2], 2);
+  i2cqRequestObjectInit(&req[3], &hi, ADDR_IMU, &reg, 1, rx[3], 2);
+  req[3].deadline = OSAL_MS2I(2);
+  i2cqRequestObjectInit(&req[4], &lo, ADDR_IMU, &reg, 1, rx[4], 2);
+
+  order_count = 0;
+  for (i = 0; i < 5; i++) {
+    req[i].cb = record_order;
+    req[i].arg = (void *)(uintptr_t)i;
+    i2cqSubmit(&req[i]);
+    CHECK(I2CQ_REQ_QUEUED == req[i].state);
+  }
+  while (i2cqProcess(&queue))
+    ;
+
+  CHECK(5 == order_count);
+  for (i = 0; i < 5; i++) {
+    CHECK(expected[i] == order[i]);
+    CHECK(i2cqIsDone(&req[i]));
+    CHECK(MSG_OK == req[i].status);
+  }
+  CHECK(2 == lo.stats.requests);
+  CHECK(2 == hi.stats.requests);
+  CHECK(0 == queue.runs);
+}
+
+static void errors_suite(void) {
+  i2cq_client_t c;
+  i2cq_request_t req;
+  uint8_t tx[6] = {0x00, 30, 1, 2, 3, 4};
+  uint8_t rx[32];
+  uint32_t before;
+
+  bus_open();
+  i2cqClientObjectInit(&c, &queue, 0, I2CQ_NO_DEADLINE);
+
+  /* absent target NACKs its address */
+  i2cqRequestObjectInit(&req, &c, ADDR_ABSENT, tx, 1, rx, 1);
+  i2cqSubmit(&req);
+  CHECK(i2cqProcess(&queue));
+  CHECK(MSG_RESET == req.status);
+  CHECK(I2C_ACK_FAILURE == req.errors);
+  CHECK(1 == c.stats.errors);
+
+  /* stuck target times out, driver is restarted for the next request */
+  targets[0].stuck = true;
+  i2cqRequestObjectInit(&req, &c, ADDR_IMU, tx, 1, rx, 1);
+  req.timeout = OSAL_MS2I(1);
+  i2cqSubmit(&req);
+  CHECK(i2cqProcess(&queue));
+  CHECK(MSG_TIMEOUT == req.status);
+  CHECK(2 == i2cd.starts);
+  CHECK(I2C_READY == i2cd.state);
+  CHECK(req.client->stats.latency_max >= OSAL_MS2I(1));
+  targets[0].stuck = false;
+  i2cqSubmit(&req);
+  CHECK(i2cqProcess(&queue));
+  CHECK(MSG_OK == req.status);
+  CHECK(2 == c.stats.errors);
+
+  /* EEPROM write wraps within page, then NACKs during write cycle */
+  i2cqRequestObjectInit(&req, &c, ADDR_EEPROM, tx, 6, NULL, 0);
+  i2cqSubmit(&req);
+  CHECK(i2cqProcess(&queue));
+  CHECK(MSG_OK == req.status);
+  tx[1] = 0;
+  i2cqRequestObjectInit(&req, &c, ADDR_EEPROM, tx, 2, rx, 32);
+  i2cqSubmit(&req);
+  CHECK(i2cqProcess(&queue));
+  CHECK(MSG_RESET == req.status);
+  osalHostAdvanceTime(OSAL_MS2I(5));
+  i2cqSubmit(&req);
+  CHECK(i2cqProcess(&queue));
+  CHECK(MSG_OK == req.status);
+  CHECK((3 == rx[0]) && (4 == rx[1]) && (2 == rx[2]));
+  CHECK((1 == rx[30]) && (2 == rx[31]));
+
+  /* request not started before its deadline never reaches the bus */
+  before = targets[0].transactions;
+  i2cqRequestObjectInit(&req, &c, ADDR_IMU, tx, 1, rx, 1);
+  req.deadline = OSAL_US2I(100);
+  i2cqSubmit(&req);
+  osalHostAdvanceTime(OSAL_US2I(200));
+  CHECK(i2cqProcess(&queue));
+  CHECK(MSG_TIMEOUT == req.status);
+  CHECK(1 == c.stats.missed);
+  CHECK(before == targets[0].transactions);
+  CHECK(!i2cqProcess(&queue));
+}
+
+static void latency_suite(void) {
+  stream_t prio, fifo;
+  uint64_t busy;
+  sysinterval_t imu_wire, eeprom_wire;
+
+  latency_run(true, &prio, &busy);
+  imu_wire = i2csimDuration(&sim, 1, 12);
+  eeprom_wire = i2csimDuration(&sim, 34, 0);
+  test_report("i2cq_prio", "bus", "utilization",
+              busy * 100.0 / OSAL_S2ST(2), "%");
+  latency_run(false, &fifo, &busy);
+  test_report("i2cq_fifo", "bus", "utilization",
+              busy * 100.0 / OSAL_S2ST(2), "%");
+
+  /* High priority waits for one transaction in flight at most.*/
+  CHECK(prio.client.stats.latency_max <= eeprom_wire + imu_wire);
+  CHECK(0 == prio.client.stats.missed);
+  CHECK(prio.client.stats.latency_max < fifo.client.stats.latency_max);
+}
+
+/*
+ ******************************************************************************
+ * EXPORTED FUNCTIONS
+ ******************************************************************************
+ */
+
+int main(void) {
+
+  order_suite();
+  errors_suite();
+  threads_suite();
+  latency_suite();
+
+  return test_summary();
+}
@@ -0,0 +1,29 @@
+/*
+    ChibiOS - Copyright (C) 2026 agent
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    ch.h
+ * @brief   Host replacement of RT header, see @p osal_host.h.
+ */
+
+#ifndef CH_H_
+#define CH_H_
+
+#include "osal_host.h"
+
+#define chDbgAssert(c, remark)          osalDbgAssert(c, remark)
+
+#endif /* CH_H_ */
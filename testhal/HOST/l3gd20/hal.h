@@ -0,0 +1,58 @@
+/*
+    ChibiOS - Copyright (C) 2026 agent
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal.h
+ * @brief   Host replacement of HAL header for L3GD20 streaming tests.
+ * @details SPI driver is emulated in @p hal_host.c on top of the simulated
+ *          device.
+ */
+
+#ifndef HAL_H_
+#define HAL_H_
+
+#include "osal_host.h"
+#include "l3gd20sim.h"
+
+/*
+ * Drivers settings.
+ */
+#define HAL_USE_SPI                     TRUE
+
+/*
+ * SPI subset.
+ */
+typedef struct {
+  /* Emulation.*/
+  l3gd20sim_t               *dev;
+  uint32_t                  bytes;
+} SPIDriver;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void spiObjectInit(SPIDriver *spip, l3gd20sim_t *dev);
+  void spiSelect(SPIDriver *spip);
+  void spiUnselect(SPIDriver *spip);
+  void spiExchange(SPIDriver *spip, size_t n,
+                   const void *txbuf, void *rxbuf);
+  void spiSend(SPIDriver *spip, size_t n, const void *txbuf);
+  void spiReceive(SPIDriver *spip, size_t n, void *rxbuf);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HAL_H_ */
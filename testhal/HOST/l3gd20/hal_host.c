@@ -0,0 +1,69 @@
+/*
+    ChibiOS - Copyright (C) 2026 agent
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_host.c
+ * @brief   SPI driver emulated on top of simulated device.
+ * @details Every byte is clocked through @p l3gd20simTransfer(), idle
+ *          transmit level is 0xFF like on a target.
+ */
+
+#include "hal.h"
+
+/*===========================================================================*/
+/* Exported functions.                                                       */
+/*===========================================================================*/
+
+void spiObjectInit(SPIDriver *spip, l3gd20sim_t *dev) {
+
+  spip->dev = dev;
+  spip->bytes = 0;
+}
+
+void spiSelect(SPIDriver *spip) {
+
+  l3gd20simSelect(spip->dev);
+}
+
+void spiUnselect(SPIDriver *spip) {
+
+  l3gd20simUnselect(spip->dev);
+}
+
+void spiExchange(SPIDriver *spip, size_t n,
+                 const void *txbuf, void *rxbuf) {
+  const uint8_t *tp = txbuf;
+  uint8_t *rp = rxbuf;
+  size_t i;
+
+  for (i = 0; i < n; i++) {
+    uint8_t rx = l3gd20simTransfer(spip->dev, (tp != NULL) ? tp[i] : 0xFF);
+
+    if (rp != NULL)
+      rp[i] = rx;
+  }
+  spip->bytes += n;
+}
+
+void spiSend(SPIDriver *spip, size_t n, const void *txbuf) {
+
+  spiExchange(spip, n, txbuf, NULL);
+}
+
+void spiReceive(SPIDriver *spip, size_t n, void *rxbuf) {
+
+  spiExchange(spip, n, NULL, rxbuf);
+}
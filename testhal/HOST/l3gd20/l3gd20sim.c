@@ -0,0 +1,182 @@
+/*
+    ChibiOS - Copyright (C) 2026 agent
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    l3gd20sim.c
+ * @brief   Simulated L3GD20 gyroscope with output FIFO.
+ * @details Only the FIFO related behaviour is modelled. In stream mode
+ *          the oldest sample is overwritten when the FIFO is full,
+ *          output registers then read the oldest stored sample and
+ *          auto-increment address rolls back from OUT_Z_H to OUT_X_L,
+ *          reading OUT_Z_H pops the sample.
+ */
+
+#include "hal.h"
+#include "l3gd20.h"
+
+/*===========================================================================*/
+/* Local functions.                                                          */
+/*===========================================================================*/
+
+static bool fifo_enabled(const l3gd20sim_t *dev) {
+
+  return (dev->regs[L3GD20_AD_CTRL_REG5] & L3GD20_CTRL_REG5_FIFO_EN) != 0U;
+}
+
+static size_t watermark(const l3gd20sim_t *dev) {
+
+  return dev->regs[L3GD20_AD_FIFO_CTRL_REG] & L3GD20_FIFO_CTRL_WTM;
+}
+
+static uint8_t fifo_src(const l3gd20sim_t *dev) {
+  uint8_t src = (uint8_t)(dev->level & L3GD20_FIFO_SRC_FSS);
+
+  if (dev->level == 0U)
+    src |= L3GD20_FIFO_SRC_EMPTY;
+  if (dev->overrun)
+    src |= L3GD20_FIFO_SRC_OVRN;
+  if (dev->level >= watermark(dev))
+    src |= L3GD20_FIFO_SRC_WTM;
+  return src;
+}
+
+static void fifo_pop(l3gd20sim_t *dev) {
+
+  if (dev->level > 0U) {
+    dev->level--;
+    memmove(dev->fifo[0], dev->fifo[1], dev->level * sizeof(dev->fifo[0]));
+    dev->overrun = false;
+  }
+}
+
+static uint8_t read_reg(l3gd20sim_t *dev, uint8_t addr) {
+
+  if ((addr >= L3GD20_AD_OUT_X_L) && (addr <= L3GD20_AD_OUT_Z_H) &&
+      fifo_enabled(dev)) {
+    unsigned i = addr - L3GD20_AD_OUT_X_L;
+    uint16_t v;
+
+    if (dev->level == 0U)
+      return 0;
+    v = (uint16_t)dev->fifo[0][i / 2U];
+    return (uint8_t)((i & 1U) ? (v >> 8) : v);
+  }
+  if (addr == L3GD20_AD_FIFO_SRC_REG)
+    return fifo_src(dev);
+  if (addr == L3GD20_AD_WHO_AM_I)
+    return 0xD4;
+  return dev->regs[addr];
+}
+
+static void write_reg(l3gd20sim_t *dev, uint8_t addr, uint8_t value) {
+
+  dev->regs[addr] = value;
+
+  /* Going through bypass mode resets the FIFO.*/
+  if ((addr == L3GD20_AD_FIFO_CTRL_REG) &&
+      ((value & (L3GD20_FIFO_CTRL_FM_FIFO | L3GD20_FIFO_CTRL_FM_STREAM)) ==
+       L3GD20_FIFO_CTRL_FM_BYPASS)) {
+    dev->level = 0;
+    dev->overrun = false;
+  }
+}
+
+/*===========================================================================*/
+/* Exported functions.                                                       */
+/*===========================================================================*/
+
+void l3gd20simInit(l3gd20sim_t *dev) {
+
+  memset(dev, 0, sizeof(*dev));
+}
+
+/*
+ * Returns true on watermark rising edge when it is routed to INT2, the
+ * test then calls the interrupt handler.
+ */
+bool l3gd20simProduce(l3gd20sim_t *dev) {
+  bool before = dev->level >= watermark(dev);
+  uint32_t index = dev->produced++;
+
+  if (!fifo_enabled(dev))
+    return false;
+
+  if (dev->level == L3GD20SIM_FIFO_DEPTH) {
+    memmove(dev->fifo[0], dev->fifo[1],
+            (L3GD20SIM_FIFO_DEPTH - 1U) * sizeof(dev->fifo[0]));
+    dev->level--;
+    dev->overrun = true;
+    dev->lost++;
+  }
+  dev->fifo[dev->level][0] = (int16_t)index;
+  dev->fifo[dev->level][1] = (int16_t)(index >> 16);
+  dev->fifo[dev->level][2] = (int16_t)~index;
+  dev->level++;
+
+  return !before && (dev->level >= watermark(dev)) &&
+         ((dev->regs[L3GD20_AD_CTRL_REG3] & L3GD20_CTRL_REG3_I2_WTM) != 0U);
+}
+
+void l3gd20simSelect(l3gd20sim_t *dev) {
+
+  osalDbgAssert(!dev->selected, "already selected");
+  dev->selected = true;
+  dev->command = true;
+  dev->transactions++;
+}
+
+void l3gd20simUnselect(l3gd20sim_t *dev) {
+
+  dev->selected = false;
+}
+
+uint8_t l3gd20simTransfer(l3gd20sim_t *dev, uint8_t tx) {
+  uint8_t rx = 0xFF;
+
+  osalDbgAssert(dev->selected, "not selected");
+
+  if (dev->command) {
+    dev->command = false;
+    dev->read = (tx & L3GD20_RW) != 0U;
+    dev->increment = (tx & L3GD20_MS) != 0U;
+    dev->addr = tx & 0x3FU;
+
+    /* Samples completed while the burst is clocked out.*/
+    if (dev->read && (dev->addr == L3GD20_AD_OUT_X_L)) {
+      while (dev->during_burst > 0U) {
+        dev->during_burst--;
+        (void)l3gd20simProduce(dev);
+      }
+    }
+    return rx;
+  }
+
+  if (dev->read)
+    rx = read_reg(dev, dev->addr);
+  else
+    write_reg(dev, dev->addr, tx);
+
+  if (dev->increment) {
+    if ((dev->addr == L3GD20_AD_OUT_Z_H) && fifo_enabled(dev)) {
+      fifo_pop(dev);
+      dev->addr = L3GD20_AD_OUT_X_L;
+    }
+    else {
+      dev->addr = (dev->addr + 1U) & 0x3FU;
+    }
+  }
+  return rx;
+}
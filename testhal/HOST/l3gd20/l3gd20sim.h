@@ -0,0 +1,108 @@
+/*
+    ChibiOS - Copyright (C) 2026 agent
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    l3gd20sim.h
+ * @brief   Simulated L3GD20 gyroscope with output FIFO.
+ * @details Device is simulated on SPI byte level. Emulated SPI driver
+ *          passes every byte to @p l3gd20simTransfer(). Samples enter
+ *          the FIFO only when the test produces them, sample value
+ *          carries its running index so lost samples can be told.
+ */
+
+#ifndef L3GD20SIM_H_
+#define L3GD20SIM_H_
+
+#include "osal.h"
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   FIFO depth in samples.
+ */
+#define L3GD20SIM_FIFO_DEPTH        32U
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Simulated device.
+ */
+typedef struct {
+  /**
+   * @brief   Register file.
+   */
+  uint8_t         regs[0x40];
+  /**
+   * @brief   FIFO content, the oldest sample first.
+   */
+  int16_t         fifo[L3GD20SIM_FIFO_DEPTH][3];
+  size_t          level;
+  bool            overrun;
+  /**
+   * @brief   Running index of the next produced sample.
+   */
+  uint32_t        produced;
+  /**
+   * @brief   Samples produced when the next FIFO burst starts, models
+   *          samples arriving while the FIFO is being read.
+   */
+  size_t          during_burst;
+  /**
+   * @brief   Transaction state.
+   */
+  bool            selected;
+  bool            command;
+  bool            read;
+  bool            increment;
+  uint8_t         addr;
+  /**
+   * @brief   Statistics.
+   */
+  uint32_t        transactions;
+  uint32_t        lost;
+} l3gd20sim_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Running index carried by sample axes.
+ */
+#define l3gd20simIndex(axis)                                                \
+  ((uint32_t)(uint16_t)(axis)[0] | ((uint32_t)(uint16_t)(axis)[1] << 16))
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void l3gd20simInit(l3gd20sim_t *dev);
+  bool l3gd20simProduce(l3gd20sim_t *dev);
+  void l3gd20simSelect(l3gd20sim_t *dev);
+  void l3gd20simUnselect(l3gd20sim_t *dev);
+  uint8_t l3gd20simTransfer(l3gd20sim_t *dev, uint8_t tx);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* L3GD20SIM_H_ */
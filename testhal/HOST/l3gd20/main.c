@@ -0,0 +1,430 @@
+/*
+    ChibiOS - Copyright (C) 2026 agent
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/*
+ * L3GD20 FIFO streaming tests against simulated device.
+ *
+ * Streaming code of l3gd20.c runs unmodified on top of emulated SPI
+ * driver. Sample period of the simulated device differs from the nominal
+ * one, every sample carries its running index, so the timestamps given
+ * by the driver are compared with the true sample times. Results are
+ * printed as one JSON object per line, failures go to stderr.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "hal.h"
+#include "l3gd20.h"
+#include "test_util.h"
+
+/*
+ ******************************************************************************
+ * DEFINES
+ ******************************************************************************
+ */
+
+#define RING_SIZE           64U
+
+/* Timestamps in microseconds, the counter wraps during the tests.*/
+#define NOMINAL_PERIOD      1000U
+#define TRUE_PERIOD         1040U
+#define START_TIME          0xFFFF0000U
+
+/* Interrupt latency jitter during steady streaming.*/
+#define MAX_LATENCY         30U
+
+/*
+ ******************************************************************************
+ * TYPES
+ ******************************************************************************
+ */
+
+typedef struct {
+  l3gd20sim_t           dev;
+  SPIDriver             spid;
+  L3GD20_StreamConfig   cfg;
+  L3GD20_Stream         stream;
+  L3GD20_Sample         ring[RING_SIZE];
+  /* Time of the newest sample and delay of the consumer after it.*/
+  uint32_t              now;
+  /* Interrupt emulation.*/
+  uint32_t              latency;
+  bool                  masked;
+  bool                  edge;
+  /* Consumer side.*/
+  uint32_t              next_index;
+  int32_t               max_error;
+} fixture_t;
+
+/*
+ ******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************
+ */
+
+static fixture_t fx;
+
+/*
+ ******************************************************************************
+ * LOCAL FUNCTIONS
+ ******************************************************************************
+ */
+
+static uint32_t true_time(uint32_t index) {
+
+  return START_TIME + index * TRUE_PERIOD;
+}
+
+static uint32_t stream_clock(void) {
+
+  return fx.now;
+}
+
+static void interrupt(uint32_t timestamp) {
+
+  osalSysLock();
+  l3gd20StreamInterruptI(&fx.stream, timestamp);
+  osalSysUnlock();
+}
+
+static void stream_open(size_t size, uint8_t watermark) {
+
+  l3gd20simInit(&fx.dev);
+  spiObjectInit(&fx.spid, &fx.dev);
+  fx.cfg.fullscale = L3GD20_FS_250DPS;
+  fx.cfg.outputdatarate = L3GD20_ODR_760Hz_Fc_30;
+  fx.cfg.axesenabling = L3GD20_AE_XYZ;
+  fx.cfg.watermark = watermark;
+  fx.cfg.period = NOMINAL_PERIOD;
+  fx.cfg.clock = stream_clock;
+  l3gd20StreamObjectInit(&fx.stream, &fx.spid, fx.ring, size);
+  l3gd20StreamStart(&fx.stream, &fx.cfg);
+  fx.latency = 0;
+  fx.masked = false;
+  fx.edge = false;
+  fx.next_index = 0;
+  fx.max_error = 0;
+}
+
+/*
+ * Device produces samples, watermark edge interrupts at the time of the
+ * sample raising it. Masked interrupt is served on unmasking.
+ */
+static void produce(size_t n) {
+
+  while (n-- > 0U) {
+    fx.now = true_time(fx.dev.produced);
+    if (l3gd20simProduce(&fx.dev))
+      fx.edge = true;
+    if (fx.edge && !fx.masked) {
+      fx.edge = false;
+      interrupt(true_time(fx.dev.produced - 1U) + fx.latency);
+    }
+  }
+}
+
+static void unmask(void) {
+
+  fx.masked = false;
+  if (fx.edge) {
+    fx.edge = false;
+    interrupt(true_time(fx.dev.produced - 1U) + fx.latency);
+  }
+}
+
+static int32_t sample_error(const L3GD20_Sample *smp) {
+
+  return (int32_t)(smp->timestamp - true_time(l3gd20simIndex(smp->axis)));
+}
+
+/*
+ * Takes all samples from ring, they must be the next ones in sequence
+ * unless a gap is expected.
+ */
+static size_t consume(uint32_t gap) {
+  L3GD20_Sample smp;
+  size_t n = 0;
+
+  while (l3gd20StreamGet(&fx.stream, &smp)) {
+    int32_t err = sample_error(&smp);
+
+    CHECK(l3gd20simIndex(smp.axis) == fx.next_index + gap);
+    CHECK(smp.axis[2] == (int16_t)~l3gd20simIndex(smp.axis));
+    fx.next_index = l3gd20simIndex(smp.axis) + 1U;
+    gap = 0;
+    if (abs(err) > fx.max_error)
+      fx.max_error = abs(err);
+    n++;
+  }
+  return n;
+}
+
+/*
+ * Steady streaming with jittered interrupt latency.
+ */
+static void cycles(unsigned count, bool jitter) {
+
+  while (count-- > 0U) {
+    fx.latency = jitter ? test_random32() % (MAX_LATENCY + 1U) : 0U;
+    produce(fx.cfg.watermark);
+    CHECK(MSG_OK == l3gd20StreamDrain(&fx.stream, TIME_IMMEDIATE));
+    consume(0);
+  }
+  fx.latency = 0;
+}
+
+/*
+ ******************************************************************************
+ * TEST SUITES
+ ******************************************************************************
+ */
+
+/*
+ * First drain has no measured period, samples are spread back from the
+ * watermark sample using the nominal one.
+ */
+static void anchor_suite(void) {
+  L3GD20_Sample smp;
+  uint32_t i;
+
+  stream_open(RING_SIZE, 8);
+
+  CHECK(MSG_TIMEOUT == l3gd20StreamDrain(&fx.stream, TIME_IMMEDIATE));
+  CHECK(0 == l3gd20StreamAvailable(&fx.stream));
+
+  produce(8);
+  CHECK(1 == fx.stream.interrupts);
+  CHECK(MSG_OK == l3gd20StreamDrain(&fx.stream, TIME_IMMEDIATE));
+  CHECK(8 == l3gd20StreamAvailable(&fx.stream));
+  CHECK(1 == fx.stream.bursts);
+  CHECK(0 == fx.dev.level);
+
+  for (i = 0; i < 8; i++) {
+    CHECK(l3gd20StreamGet(&fx.stream, &smp));
+    CHECK(i == l3gd20simIndex(smp.axis));
+    CHECK(smp.timestamp == true_time(7) - (7 - i) * NOMINAL_PERIOD);
+  }
+  CHECK(!l3gd20StreamGet(&fx.stream, &smp));
+  CHECK(fx.stream.period == NOMINAL_PERIOD << 8);
+}
+
+/*
+ * Period converges to the true one, interrupts served far too late are
+ * not taken as period measurement.
+ */
+static void period_suite(void) {
+  uint32_t period;
+
+  stream_open(RING_SIZE, 8);
+  cycles(1, false);
+
+  cycles(200, true);
+  CHECK(abs((int32_t)(fx.stream.period >> 8) - (int32_t)TRUE_PERIOD) <= 2);
+  test_report("l3gd20", "period_lock", "period",
+              fx.stream.period / 256.0, "us");
+
+  fx.max_error = 0;
+  cycles(100, true);
+  CHECK(fx.max_error <= (int32_t)MAX_LATENCY + 8);
+  test_report("l3gd20", "period_lock", "timestamp_error_max",
+              fx.max_error, "us");
+
+  /* Interrupt served 3 ms late, both measurements around it are off by
+     more than a quarter.*/
+  period = fx.stream.period;
+  fx.latency = 3000;
+  produce(8);
+  fx.latency = 0;
+  CHECK(MSG_OK == l3gd20StreamDrain(&fx.stream, TIME_IMMEDIATE));
+  consume(0);
+  CHECK(fx.stream.period == period);
+  cycles(1, false);
+  CHECK(fx.stream.period == period);
+
+  fx.max_error = 0;
+  cycles(1, false);
+  CHECK(fx.max_error <= 8);
+  CHECK(0 == fx.stream.overruns);
+  CHECK(0 == fx.stream.dropped);
+}
+
+/*
+ * FIFO overruns, the newest sample is timed by the clock read with
+ * FIFO_SRC within its period and the period is measured neither across
+ * the gap nor from that anchor. Either the interrupt is masked or it
+ * comes on time and the consumer is late, then the interrupt timestamp
+ * belongs to an overwritten sample.
+ */
+static void overrun_run(bool masked, uint32_t delay) {
+  L3GD20_Sample smp;
+  uint32_t period, newest;
+  int32_t err, worst = 0;
+  size_t n;
+
+  stream_open(RING_SIZE, 8);
+  cycles(50, false);
+  period = fx.stream.period;
+
+  fx.masked = masked;
+  produce(45);
+  CHECK(13 == fx.dev.lost);
+  if (masked) {
+    CHECK(MSG_TIMEOUT == l3gd20StreamDrain(&fx.stream, TIME_IMMEDIATE));
+    unmask();
+  }
+  newest = fx.dev.produced - 1U;
+  fx.now += delay;
+  CHECK(MSG_OK == l3gd20StreamDrain(&fx.stream, TIME_IMMEDIATE));
+  CHECK(1 == fx.stream.overruns);
+  CHECK(L3GD20_FIFO_DEPTH == l3gd20StreamAvailable(&fx.stream));
+  CHECK(fx.stream.period == period);
+
+  /* Oldest remaining sample follows the gap, the newest one is within
+     half a period.*/
+  n = 0;
+  while (l3gd20StreamGet(&fx.stream, &smp)) {
+    uint32_t index = l3gd20simIndex(smp.axis);
+
+    CHECK(index == fx.next_index + 13U + n);
+    err = abs(sample_error(&smp));
+    if (index == newest)
+      CHECK(err <= (int32_t)TRUE_PERIOD / 2 + 1);
+    worst = (err > worst) ? err : worst;
+    n++;
+  }
+  CHECK(L3GD20_FIFO_DEPTH == n);
+  CHECK(worst <= (int32_t)TRUE_PERIOD / 2 + 32);
+  test_report("l3gd20", masked ? "overrun_masked" : "overrun_late",
+              "timestamp_error_max", worst, "us");
+  fx.next_index = newest + 1U;
+
+  /* Streaming goes on, the period is not measured from the overrun
+     anchor.*/
+  fx.max_error = 0;
+  cycles(1, false);
+  CHECK(fx.stream.period == period);
+  cycles(10, false);
+  CHECK(fx.max_error <= 8);
+  CHECK(1 == fx.stream.overruns);
+  CHECK(abs((int32_t)(fx.stream.period >> 8) - (int32_t)TRUE_PERIOD) <= 2);
+}
+
+static void overrun_suite(void) {
+
+  overrun_run(true, 0);
+  overrun_run(false, TRUE_PERIOD - 40U);
+}
+
+/*
+ * Samples arriving during the burst keep the watermark level, there is
+ * no new edge so the drain has to read the FIFO again.
+ */
+static void reread_suite(void) {
+  uint32_t interrupts, bursts, transactions;
+
+  stream_open(RING_SIZE, 8);
+  cycles(50, false);
+  interrupts = fx.stream.interrupts;
+  bursts = fx.stream.bursts;
+  transactions = fx.dev.transactions;
+
+  fx.dev.during_burst = 10;
+  produce(8);
+  CHECK(MSG_OK == l3gd20StreamDrain(&fx.stream, TIME_IMMEDIATE));
+  CHECK(fx.stream.interrupts == interrupts + 1U);
+  CHECK(fx.stream.bursts == bursts + 2U);
+  CHECK(fx.dev.transactions == transactions + 5U);
+  CHECK(18 == l3gd20StreamAvailable(&fx.stream));
+  CHECK(0 == fx.dev.level);
+
+  fx.max_error = 0;
+  CHECK(18 == consume(0));
+  CHECK(fx.max_error <= 8);
+
+  /* Watermark reached but not kept, the edge comes as usual.*/
+  fx.dev.during_burst = 3;
+  cycles(1, false);
+  CHECK(3 == fx.dev.level);
+  CHECK(fx.stream.bursts == bursts + 3U);
+  produce(5);
+  CHECK(MSG_OK == l3gd20StreamDrain(&fx.stream, TIME_IMMEDIATE));
+  CHECK(8 == consume(0));
+  CHECK(fx.max_error <= 8);
+}
+
+/*
+ * Ring indexes run far past the ring size with watermark not dividing
+ * it, full ring drops the newest samples and keeps their time slots.
+ */
+static void ring_suite(void) {
+  L3GD20_Sample smp;
+  uint32_t prev;
+  unsigned i;
+
+  stream_open(16, 6);
+
+  prev = START_TIME - NOMINAL_PERIOD;
+  for (i = 0; i < 100; i++) {
+    produce(6);
+    CHECK(MSG_OK == l3gd20StreamDrain(&fx.stream, TIME_IMMEDIATE));
+    while (l3gd20StreamGet(&fx.stream, &smp)) {
+      CHECK(l3gd20simIndex(smp.axis) == fx.next_index);
+      CHECK((int32_t)(smp.timestamp - prev) > 0);
+      prev = smp.timestamp;
+      fx.next_index++;
+    }
+  }
+  CHECK(600 == fx.stream.head);
+  CHECK(fx.stream.head == fx.stream.tail);
+  /* timestamps went through the counter wrap*/
+  CHECK(prev < START_TIME);
+
+  /* 24 samples into 16 slots.*/
+  for (i = 0; i < 4; i++) {
+    produce(6);
+    CHECK(MSG_OK == l3gd20StreamDrain(&fx.stream, TIME_IMMEDIATE));
+  }
+  CHECK(16 == l3gd20StreamAvailable(&fx.stream));
+  CHECK(8 == fx.stream.dropped);
+
+  fx.max_error = 0;
+  CHECK(16 == consume(0));
+  CHECK(0 == l3gd20StreamAvailable(&fx.stream));
+
+  produce(6);
+  CHECK(MSG_OK == l3gd20StreamDrain(&fx.stream, TIME_IMMEDIATE));
+  CHECK(6 == consume(8));
+  CHECK(fx.max_error <= 8);
+  CHECK(8 == fx.stream.dropped);
+}
+
+/*
+ ******************************************************************************
+ * EXPORTED FUNCTIONS
+ ******************************************************************************
+ */
+
+int main(void) {
+
+  anchor_suite();
+  period_suite();
+  overrun_suite();
+  reread_suite();
+  ring_suite();
+
+  return test_summary();
+}
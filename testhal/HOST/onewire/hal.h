@@ -0,0 +1,159 @@
+/*
+    ChibiOS - Copyright (C) 2026 agent
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal.h
+ * @brief   Host replacement of HAL header for 1-wire driver tests.
+ * @details PAL, PWM and UART drivers are emulated in @p hal_host.c on top
+ *          of the simulated bus. Port identifier of PAL is the pointer to
+ *          the simulated bus.
+ */
+
+#ifndef HAL_H_
+#define HAL_H_
+
+#include "osal_host.h"
+#include "owsim.h"
+
+/*
+ * Drivers settings.
+ */
+#define HAL_USE_PAL                     TRUE
+#define HAL_USE_PWM                     TRUE
+#define HAL_USE_UART                    TRUE
+#define HAL_USE_ONEWIRE                 TRUE
+#define ONEWIRE_USE_STRONG_PULLUP       FALSE
+#define ONEWIRE_USE_SEARCH_ROM          TRUE
+#define ONEWIRE_MAX_BUSES               2
+/* ONEWIRE_USE_UART comes from the Makefile.*/
+
+/*
+ * PAL subset.
+ */
+typedef owsim_bus_t *ioportid_t;
+typedef uint32_t ioportmask_t;
+typedef uint32_t iomode_t;
+typedef uint32_t ioline_t;
+
+#define PAL_LOW                         0U
+#define PAL_HIGH                        1U
+#define PAL_MODE_OUTPUT_OPENDRAIN       0U
+
+#define palReadPad(port, pad)           ((void)(pad), (ioline_t)(port)->level)
+#define palSetPadMode(port, pad, mode)  ((void)(port), (void)(pad), (void)(mode))
+
+/*
+ * PWM subset.
+ */
+#define PWM_CHANNELS                    4
+
+typedef enum {
+  PWM_UNINIT = 0,
+  PWM_STOP = 1,
+  PWM_READY = 2
+} pwmstate_t;
+
+typedef struct PWMDriver PWMDriver;
+typedef void (*pwmcallback_t)(PWMDriver *pwmp);
+typedef uint32_t pwmmode_t;
+typedef uint32_t pwmcnt_t;
+
+#define PWM_OUTPUT_DISABLED             0x00U
+#define PWM_OUTPUT_ACTIVE_HIGH          0x01U
+#define PWM_OUTPUT_ACTIVE_LOW           0x02U
+
+typedef struct {
+  pwmmode_t                 mode;
+  pwmcallback_t             callback;
+} PWMChannelConfig;
+
+typedef struct {
+  uint32_t                  frequency;
+  pwmcnt_t                  period;
+  pwmcallback_t             callback;
+  PWMChannelConfig          channels[PWM_CHANNELS];
+} PWMConfig;
+
+struct PWMDriver {
+  pwmstate_t                state;
+  const PWMConfig           *config;
+  /* Emulation.*/
+  owsim_bus_t               *bus;
+  pwmcnt_t                  width[PWM_CHANNELS];
+  uint32_t                  enabled;
+  uint32_t                  notify;
+  bool                      periodic;
+  bool                      running;
+  bool                      thread;
+  uint32_t                  generation;
+};
+
+/*
+ * UART subset.
+ */
+typedef enum {
+  UART_UNINIT = 0,
+  UART_STOP = 1,
+  UART_READY = 2
+} uartstate_t;
+
+typedef struct UARTDriver UARTDriver;
+typedef void (*uartcb_t)(UARTDriver *uartp);
+typedef void (*uartccb_t)(UARTDriver *uartp, uint16_t c);
+typedef void (*uartecb_t)(UARTDriver *uartp, uint32_t e);
+
+typedef struct {
+  uartcb_t                  txend1_cb;
+  uartcb_t                  txend2_cb;
+  uartcb_t                  rxend_cb;
+  uartccb_t                 rxchar_cb;
+  uartecb_t                 rxerr_cb;
+  uint32_t                  speed;
+} UARTConfig;
+
+struct UARTDriver {
+  uartstate_t               state;
+  const UARTConfig          *config;
+  /* Emulation.*/
+  owsim_bus_t               *bus;
+  const uint8_t             *txbuf;
+  uint8_t                   *rxbuf;
+  size_t                    n;
+  bool                      running;
+  bool                      thread;
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void pwmStart(PWMDriver *pwmp, const PWMConfig *config);
+  void pwmStop(PWMDriver *pwmp);
+  void pwmEnableChannelI(PWMDriver *pwmp, size_t channel, pwmcnt_t width);
+  void pwmDisableChannelI(PWMDriver *pwmp, size_t channel);
+  void pwmEnableChannelNotificationI(PWMDriver *pwmp, size_t channel);
+  void pwmEnablePeriodicNotificationI(PWMDriver *pwmp);
+  void pwmDisablePeriodicNotification(PWMDriver *pwmp);
+  void uartStart(UARTDriver *uartp, const UARTConfig *config);
+  void uartStop(UARTDriver *uartp);
+  void uartStartSendI(UARTDriver *uartp, size_t n, const void *txbuf);
+  void uartStartReceiveI(UARTDriver *uartp, size_t n, void *rxbuf);
+#ifdef __cplusplus
+}
+#endif
+
+#include "hal_onewire.h"
+
+#endif /* HAL_H_ */
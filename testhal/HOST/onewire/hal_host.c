@@ -0,0 +1,295 @@
+/*
+    ChibiOS - Copyright (C) 2026 agent
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_host.c
+ * @brief   PWM and UART drivers emulated on top of simulated 1-wire bus.
+ * @details Every started driver gets its own thread playing the role of
+ *          the timer (or UART) interrupt. Callbacks are called without
+ *          system lock held, like ISRs lock it themselves on a target.
+ *          Emulated timer runs only while some notification is pending,
+ *          so the time stands still while the woken thread reconfigures
+ *          the peripheral, as it does for a thread much faster than a
+ *          single time slot.
+ */
+
+#include <pthread.h>
+
+#include "hal.h"
+
+/*===========================================================================*/
+/* Local definitions.                                                        */
+/*===========================================================================*/
+
+/**
+ * @brief   Longest low pulse still treated as time slot, in microseconds.
+ */
+#define SLOT_MAX_US             120U
+
+/**
+ * @brief   Master sample point, pulse shorter than it means released bus.
+ */
+#define SAMPLE_US               15U
+
+/*===========================================================================*/
+/* Local functions.                                                          */
+/*===========================================================================*/
+
+static void start_thread(void *(*fn)(void *), void *arg) {
+  pthread_t t;
+
+  if (0 != pthread_create(&t, NULL, fn, arg))
+    osalSysHalt("thread creation failed");
+  pthread_detach(t);
+}
+
+static uint32_t ticks_to_us(const PWMConfig *cfg, uint32_t ticks) {
+
+  return (uint32_t)(((uint64_t)ticks * 1000000U) / cfg->frequency);
+}
+
+/*
+ * Calls callback without system lock.
+ *
+ * @return              false if the driver was restarted meanwhile.
+ */
+static bool pwm_call(PWMDriver *pwmp, pwmcallback_t cb, uint32_t generation) {
+
+  osalSysUnlock();
+  cb(pwmp);
+  osalSysLock();
+  return generation == pwmp->generation;
+}
+
+/*
+ * Single timer period: output pulse, channel callbacks in compare order,
+ * overflow callback.
+ */
+static void pwm_period(PWMDriver *pwmp) {
+  const PWMConfig *cfg = pwmp->config;
+  owsim_bus_t *bus = pwmp->bus;
+  uint32_t generation = pwmp->generation;
+  uint32_t period = ticks_to_us(cfg, cfg->period);
+  uint32_t enabled = pwmp->enabled;
+  uint32_t done = 0;
+  size_t ch;
+
+  bus->level = !bus->shorted;
+  for (ch = 0; ch < PWM_CHANNELS; ch++) {
+    if ((pwmp->enabled & (1U << ch)) &&
+        (PWM_OUTPUT_DISABLED != cfg->channels[ch].mode)) {
+      uint32_t width = ticks_to_us(cfg, pwmp->width[ch]);
+
+      if (width > SLOT_MAX_US)
+        bus->level = owsimReset(bus);
+      else
+        bus->level = owsimSlot(bus, width < SAMPLE_US);
+      break;
+    }
+  }
+  bus->bus_time += period;
+  osalHostAdvanceTime(period);
+
+  while (true) {
+    size_t next = PWM_CHANNELS;
+
+    for (ch = 0; ch < PWM_CHANNELS; ch++) {
+      if ((pwmp->notify & pwmp->enabled & ~done & (1U << ch)) &&
+          ((PWM_CHANNELS == next) || (pwmp->width[ch] < pwmp->width[next])))
+        next = ch;
+    }
+    if (PWM_CHANNELS == next)
+      break;
+    done |= 1U << next;
+    if (!pwm_call(pwmp, cfg->channels[next].callback, generation))
+      return;
+  }
+  bus->level = !bus->shorted;
+
+  if (pwmp->periodic && (NULL != cfg->callback)) {
+    if (!pwm_call(pwmp, cfg->callback, generation))
+      return;
+  }
+
+  /* Overflow notifications alone keep timer running until the period
+     without any output, it is the one used to signal end of transfer.*/
+  if ((0 == pwmp->notify) &&
+      (!pwmp->periodic || ((0 == enabled) && (0 == pwmp->enabled))))
+    pwmp->running = false;
+}
+
+static void *pwm_thread(void *arg) {
+  PWMDriver *pwmp = arg;
+
+  osalSysLock();
+  while (true) {
+    while (!pwmp->running)
+      osalHostWaitS();
+    pwm_period(pwmp);
+  }
+  return NULL;
+}
+
+/*
+ * Every byte is a time slot at high rate and a reset pulse at low rate.
+ */
+static void uart_transfer(UARTDriver *uartp) {
+  owsim_bus_t *bus = uartp->bus;
+  uint32_t speed = uartp->config->speed;
+  uint32_t byte_us = (10U * 1000000U) / speed;
+  size_t i;
+
+  for (i = 0; i < uartp->n; i++) {
+    uint8_t tx = uartp->txbuf[i];
+    uint8_t rx;
+
+    if (speed < ONEWIRE_UART_SLOT_SPEED) {
+      if (owsimReset(bus))
+        rx = tx;
+      else
+        rx = bus->shorted ? 0x00 : (tx & 0x7F);
+    }
+    else {
+      if (owsimSlot(bus, 0xFF == tx))
+        rx = tx;
+      else
+        rx = tx & 0xFE;
+    }
+    uartp->rxbuf[i] = rx;
+    bus->bus_time += byte_us;
+    osalHostAdvanceTime(byte_us);
+  }
+}
+
+static void *uart_thread(void *arg) {
+  UARTDriver *uartp = arg;
+
+  osalSysLock();
+  while (true) {
+    while (!uartp->running)
+      osalHostWaitS();
+    uart_transfer(uartp);
+    uartp->running = false;
+    if (NULL != uartp->config->rxend_cb) {
+      osalSysUnlock();
+      uartp->config->rxend_cb(uartp);
+      osalSysLock();
+    }
+  }
+  return NULL;
+}
+
+/*===========================================================================*/
+/* Exported functions.                                                       */
+/*===========================================================================*/
+
+void pwmStart(PWMDriver *pwmp, const PWMConfig *config) {
+
+  osalSysLock();
+  pwmp->config = config;
+  pwmp->state = PWM_READY;
+  pwmp->enabled = 0;
+  pwmp->notify = 0;
+  pwmp->periodic = false;
+  pwmp->running = false;
+  pwmp->generation++;
+  if (!pwmp->thread) {
+    pwmp->thread = true;
+    start_thread(pwm_thread, pwmp);
+  }
+  osalSysUnlock();
+}
+
+void pwmStop(PWMDriver *pwmp) {
+
+  osalSysLock();
+  pwmp->state = PWM_STOP;
+  pwmp->enabled = 0;
+  pwmp->notify = 0;
+  pwmp->periodic = false;
+  pwmp->running = false;
+  pwmp->generation++;
+  pwmp->bus->level = !pwmp->bus->shorted;
+  osalSysUnlock();
+}
+
+void pwmEnableChannelI(PWMDriver *pwmp, size_t channel, pwmcnt_t width) {
+
+  pwmp->width[channel] = width;
+  pwmp->enabled |= 1U << channel;
+}
+
+void pwmDisableChannelI(PWMDriver *pwmp, size_t channel) {
+
+  pwmp->enabled &= ~(1U << channel);
+  pwmp->notify &= ~(1U << channel);
+}
+
+void pwmEnableChannelNotificationI(PWMDriver *pwmp, size_t channel) {
+
+  pwmp->notify |= 1U << channel;
+  pwmp->running = true;
+  osalHostBroadcastI();
+}
+
+void pwmEnablePeriodicNotificationI(PWMDriver *pwmp) {
+
+  pwmp->periodic = true;
+  pwmp->running = true;
+  osalHostBroadcastI();
+}
+
+void pwmDisablePeriodicNotification(PWMDriver *pwmp) {
+
+  osalSysLock();
+  pwmp->periodic = false;
+  osalSysUnlock();
+}
+
+void uartStart(UARTDriver *uartp, const UARTConfig *config) {
+
+  osalSysLock();
+  uartp->config = config;
+  uartp->state = UART_READY;
+  uartp->running = false;
+  if (!uartp->thread) {
+    uartp->thread = true;
+    start_thread(uart_thread, uartp);
+  }
+  osalSysUnlock();
+}
+
+void uartStop(UARTDriver *uartp) {
+
+  osalSysLock();
+  uartp->state = UART_STOP;
+  osalSysUnlock();
+}
+
+void uartStartSendI(UARTDriver *uartp, size_t n, const void *txbuf) {
+
+  osalDbgAssert(UART_READY == uartp->state, "not ready");
+  uartp->txbuf = txbuf;
+  uartp->n = n;
+  uartp->running = true;
+  osalHostBroadcastI();
+}
+
+void uartStartReceiveI(UARTDriver *uartp, size_t n, void *rxbuf) {
+
+  (void)n;
+  uartp->rxbuf = rxbuf;
+}
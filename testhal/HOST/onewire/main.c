@@ -0,0 +1,576 @@
+/*
+    ChibiOS - Copyright (C) 2026 agent
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/*
+ * 1-wire driver tests against simulated bus.
+ *
+ * Protocol logic of hal_onewire.c runs unmodified, only PAL, PWM and UART
+ * drivers underneath are emulated. Bus time is simulated, so reported
+ * times are the ones expected on real bus. Results are printed as one
+ * JSON object per line, failures go to stderr.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "hal.h"
+#include "ds18b20.h"
+#include "test_util.h"
+
+/*
+ ******************************************************************************
+ * DEFINES
+ ******************************************************************************
+ */
+
+#define MAX_DEVICES         256
+
+#if ONEWIRE_USE_UART
+#define BACKEND             "uart"
+#else
+#define BACKEND             "pwm"
+#endif
+
+/*
+ ******************************************************************************
+ * TYPES
+ ******************************************************************************
+ */
+
+typedef struct {
+  owsim_bus_t       sim;
+  owsim_device_t    dev[MAX_DEVICES];
+  onewireDriver     ow;
+  onewireConfig     cfg;
+#if ONEWIRE_USE_UART
+  UARTDriver        uartd;
+  UARTConfig        uartcfg;
+#else
+  PWMDriver         pwmd;
+  PWMConfig         pwmcfg;
+#endif
+  uint8_t           rom[MAX_DEVICES * 8];
+} testbus_t;
+
+/*
+ ******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************
+ */
+
+static testbus_t buses[ONEWIRE_MAX_BUSES];
+
+/*
+ ******************************************************************************
+ * LOCAL FUNCTIONS
+ ******************************************************************************
+ */
+
+static uint64_t next_serial(void) {
+
+  /* serials only have to be unique */
+  return test_random64() & 0xFFFFFFFFFFFFULL;
+}
+
+/*
+ * Devices get random serial, temperature and family.
+ */
+static void bus_open(testbus_t *b, size_t devices, bool mixed) {
+  size_t i;
+
+  for (i = 0; i < devices; i++) {
+    uint8_t family = (mixed && (0 == i % 5)) ? DS18B20_FAMILY_DS18S20 :
+                                               DS18B20_FAMILY_DS18B20;
+    int32_t t = (int32_t)(next_serial() % 180000) - 55000;
+    owsimDeviceInit(&b->dev[i], family, next_serial(), t);
+  }
+  owsimBusInit(&b->sim, b->dev, devices);
+
+  /* Emulated driver keeps its thread between openings, it must not be
+     cleared.*/
+  memset(&b->cfg, 0, sizeof(b->cfg));
+#if ONEWIRE_USE_UART
+  memset(&b->uartcfg, 0, sizeof(b->uartcfg));
+  b->uartd.state = UART_STOP;
+  b->uartd.bus = &b->sim;
+  b->cfg.uartd = &b->uartd;
+  b->cfg.uartcfg = &b->uartcfg;
+#else
+  memset(&b->pwmcfg, 0, sizeof(b->pwmcfg));
+  b->pwmd.state = PWM_STOP;
+  b->pwmd.bus = &b->sim;
+  b->cfg.pwmd = &b->pwmd;
+  b->cfg.pwmcfg = &b->pwmcfg;
+  b->cfg.pwmmode = PWM_OUTPUT_ACTIVE_LOW;
+  b->cfg.master_channel = 2;
+  b->cfg.sample_channel = 3;
+  b->cfg.port = &b->sim;
+  b->cfg.pad = 0;
+  b->cfg.pad_mode_active = PAL_MODE_OUTPUT_OPENDRAIN;
+#endif
+
+  onewireObjectInit(&b->ow);
+  onewireStart(&b->ow, &b->cfg);
+}
+
+static void bus_close(testbus_t *b) {
+
+  onewireStop(&b->ow);
+}
+
+/*
+ * Every device of the bus must be found exactly once.
+ */
+static bool roms_match(const testbus_t *b, size_t found) {
+  size_t i, j, hits = 0;
+
+  if (found != b->sim.devices)
+    return false;
+  for (i = 0; i < b->sim.devices; i++) {
+    for (j = 0; j < found; j++) {
+      if (0 == memcmp(b->dev[i].rom, &b->rom[j * 8], 8)) {
+        hits++;
+        break;
+      }
+    }
+  }
+  return hits == b->sim.devices;
+}
+
+/*
+ * Topology cache must hold present devices only, every one exactly once.
+ */
+static bool cache_matches(const testbus_t *b, const onewireTopology *tp) {
+  size_t i, j, present = 0;
+
+  for (i = 0; i < b->sim.devices; i++) {
+    size_t hits = 0;
+
+    if (!b->dev[i].present)
+      continue;
+    present++;
+    for (j = 0; j < tp->count; j++) {
+      if (0 == memcmp(b->dev[i].rom, &tp->roms[j * 8], 8))
+        hits++;
+    }
+    if (1 != hits)
+      return false;
+  }
+  return present == tp->count;
+}
+
+/*
+ * Starts conversion on all devices and waits its end.
+ */
+static void convert_all(testbus_t *b) {
+  uint8_t buf[2] = {ONEWIRE_CMD_SKIP_ROM, ONEWIRE_CMD_CONVERT_TEMP};
+
+  CHECK(true == onewireReset(&b->ow));
+  onewireWrite(&b->ow, buf, 2, 0);
+  osalThreadSleepMilliseconds(750);
+}
+
+/*
+ ******************************************************************************
+ * TEST SUITES
+ ******************************************************************************
+ */
+
+static void presence_suite(void) {
+  testbus_t *b = &buses[0];
+  uint8_t buf[8];
+
+  bus_open(b, 1, false);
+  CHECK(true == onewireReset(&b->ow));
+
+  /* read ROM from single device */
+  CHECK(true == onewireReset(&b->ow));
+  buf[0] = ONEWIRE_CMD_READ_ROM;
+  onewireWrite(&b->ow, buf, 1, 0);
+  onewireRead(&b->ow, buf, 8);
+  CHECK(0 == memcmp(buf, b->dev[0].rom, 8));
+  CHECK(buf[7] == onewireCRC(buf, 7));
+
+  b->dev[0].present = false;
+  CHECK(false == onewireReset(&b->ow));
+  CHECK(0 == onewireSearchRom(&b->ow, b->rom, 1));
+
+  b->dev[0].present = true;
+  b->sim.shorted = true;
+  b->sim.level = false;
+  CHECK(false == onewireReset(&b->ow));
+  b->sim.shorted = false;
+  b->sim.level = true;
+  CHECK(true == onewireReset(&b->ow));
+  bus_close(b);
+}
+
+static void search_suite(void) {
+  static const size_t counts[] = {1, 2, 8, 64, 256};
+  testbus_t *b = &buses[0];
+  size_t i, found;
+
+  for (i = 0; i < sizeof(counts) / sizeof(counts[0]); i++) {
+    char name[32];
+    uint64_t t0;
+    double h0;
+
+    bus_open(b, counts[i], false);
+    t0 = b->sim.bus_time;
+    h0 = test_seconds();
+    memset(b->rom, 0, sizeof(b->rom));
+    found = onewireSearchRom(&b->ow, b->rom, counts[i]);
+    CHECK(roms_match(b, found));
+    CHECK(b->sim.resets == counts[i]);
+
+    snprintf(name, sizeof(name), "search_%u", (unsigned)counts[i]);
+    test_report("onewire", name, "bus_time",
+                (b->sim.bus_time - t0) / 1000.0, "ms");
+    test_report("onewire", name, "host_time",
+                (test_seconds() - h0) * 1000.0, "ms");
+
+    /* short buffer must not overflow, total count is still returned */
+    if (counts[i] > 1) {
+      found = onewireSearchRom(&b->ow, b->rom, 1);
+      CHECK(found == counts[i]);
+    }
+    bus_close(b);
+  }
+}
+
+static void targeted_suite(void) {
+  static const uint8_t families[] = {DS18B20_FAMILY_DS18S20,
+                                     DS18B20_FAMILY_DS18B20};
+  testbus_t *b = &buses[0];
+  const size_t n = 64;
+  size_t i, j, found, resets;
+
+  /* every 5th device is DS18S20 */
+  bus_open(b, n, true);
+  for (i = 0; i < sizeof(families); i++) {
+    size_t expected = 0;
+
+    for (j = 0; j < n; j++)
+      expected += (families[i] == b->dev[j].rom[0]) ? 1 : 0;
+
+    resets = b->sim.resets;
+    memset(b->rom, 0, sizeof(b->rom));
+    found = onewireSearchFamily(&b->ow, families[i], b->rom, MAX_DEVICES);
+    CHECK(expected == found);
+    /* one iteration per device of the family, nothing else */
+    CHECK(expected == b->sim.resets - resets);
+    for (j = 0; j < found; j++)
+      CHECK(families[i] == b->rom[j * 8]);
+  }
+
+  /* absent family costs single iteration */
+  resets = b->sim.resets;
+  CHECK(0 == onewireSearchFamily(&b->ow, DS18B20_FAMILY_DS1822,
+                                 b->rom, MAX_DEVICES));
+  CHECK(1 == b->sim.resets - resets);
+
+  /* nobody is in alarm state before conversion */
+  CHECK(0 == onewireSearchAlarm(&b->ow, b->rom, MAX_DEVICES));
+
+  /* temperature between power-on alarm limits 70 and 75 is quiet */
+  for (i = 0; i < n; i++)
+    b->dev[i].temperature = ((i % 16) == 3) ? 90000 : 72000;
+  convert_all(b);
+  resets = b->sim.resets;
+  memset(b->rom, 0, sizeof(b->rom));
+  found = onewireSearchAlarm(&b->ow, b->rom, MAX_DEVICES);
+  CHECK(n / 16 == found);
+  CHECK(n / 16 == b->sim.resets - resets);
+  for (j = 0; j < found; j++) {
+    for (i = 0; i < n; i++) {
+      if (0 == memcmp(b->dev[i].rom, &b->rom[j * 8], 8))
+        break;
+    }
+    CHECK((i < n) && (3 == i % 16));
+  }
+
+  /* single device verification */
+  CHECK(true == onewireVerifyRom(&b->ow, b->dev[17].rom));
+  b->dev[17].present = false;
+  CHECK(false == onewireVerifyRom(&b->ow, b->dev[17].rom));
+  bus_close(b);
+}
+
+static void topology_suite(void) {
+  static uint8_t cache[MAX_DEVICES * 8];
+  static uint8_t order[MAX_DEVICES * 8];
+  testbus_t *b = &buses[0];
+  onewireTopology tp;
+  const size_t n = 128;
+  size_t i, kept, resets;
+  uint64_t t0;
+
+  /* the last 8 devices are plugged in later */
+  bus_open(b, n, false);
+  for (i = n - 8; i < n; i++)
+    b->dev[i].present = false;
+
+  /* empty cache is filled by full search */
+  onewireTopologyObjectInit(&tp, cache, MAX_DEVICES);
+  resets = b->sim.resets;
+  CHECK(n - 8 == onewireTopologyRefresh(&b->ow, &tp));
+  CHECK(n - 8 == tp.added);
+  CHECK(cache_matches(b, &tp));
+  CHECK(n - 8 == b->sim.resets - resets);
+
+  /* unchanged bus costs one iteration per known device */
+  resets = b->sim.resets;
+  t0 = b->sim.bus_time;
+  CHECK(0 == onewireTopologyRefresh(&b->ow, &tp));
+  CHECK(cache_matches(b, &tp));
+  CHECK(n - 8 == b->sim.resets - resets);
+  test_report("onewire", "refresh_unchanged", "bus_time",
+              (b->sim.bus_time - t0) / 1000.0, "ms");
+
+  /* hot plugged devices are appended, the rest keep their order */
+  memcpy(order, cache, tp.count * 8);
+  for (i = n - 8; i < n; i++)
+    b->dev[i].present = true;
+  resets = b->sim.resets;
+  t0 = b->sim.bus_time;
+  CHECK(8 == onewireTopologyRefresh(&b->ow, &tp));
+  CHECK((8 == tp.added) && (0 == tp.removed));
+  CHECK(cache_matches(b, &tp));
+  CHECK(0 == memcmp(order, cache, (n - 8) * 8));
+  CHECK(n == b->sim.resets - resets);
+  test_report("onewire", "refresh_plug_8", "bus_time",
+              (b->sim.bus_time - t0) / 1000.0, "ms");
+  test_report("onewire", "refresh_plug_8", "iterations",
+              b->sim.resets - resets, "");
+
+  /* removal and insertion at the same time */
+  b->dev[5].present = false;
+  b->dev[77].present = false;
+  b->dev[n - 1].present = false;
+  memcpy(order, cache, tp.count * 8);
+  CHECK(3 == onewireTopologyRefresh(&b->ow, &tp));
+  CHECK(cache_matches(b, &tp));
+  for (i = 0, kept = 0; i < n; i++) {
+    if (0 == memcmp(&order[i * 8], b->dev[5].rom, 8) ||
+        0 == memcmp(&order[i * 8], b->dev[77].rom, 8) ||
+        0 == memcmp(&order[i * 8], b->dev[n - 1].rom, 8))
+      continue;
+    CHECK(0 == memcmp(&order[i * 8], &cache[kept * 8], 8));
+    kept++;
+  }
+  b->dev[5].present = true;
+  b->dev[n - 2].present = false;
+  CHECK(2 == onewireTopologyRefresh(&b->ow, &tp));
+  CHECK((1 == tp.added) && (1 == tp.removed));
+  CHECK(cache_matches(b, &tp));
+
+  /* every device gone */
+  for (i = 0; i < n; i++)
+    b->dev[i].present = false;
+  CHECK(n - 3 == onewireTopologyRefresh(&b->ow, &tp));
+  CHECK(0 == tp.count);
+
+  /* new devices not fitting in cache are reported */
+  for (i = 0; i < n; i++)
+    b->dev[i].present = true;
+  onewireTopologyObjectInit(&tp, cache, 10);
+  CHECK(10 == onewireTopologyRefresh(&b->ow, &tp));
+  CHECK((10 == tp.count) && (true == tp.overflow));
+  bus_close(b);
+}
+
+/* Network index of simulated device, n when not found.*/
+static size_t net_index(ds18b20Net *netp, const owsim_device_t *dp) {
+  size_t i;
+
+  for (i = 0; i < netp->devices; i++) {
+    if (0 == memcmp(dp->rom, ds18b20GetRom(netp, i), 8))
+      break;
+  }
+  return i;
+}
+
+static void ds18b20_suite(void) {
+  static ds18b20dev_t dev[MAX_DEVICES];
+  testbus_t *b = &buses[0];
+  ds18b20Net net;
+  const size_t n = 40;
+  size_t i, j, ok, k1, k2, k5;
+  uint64_t t0;
+  systime_t s0;
+
+  bus_open(b, n, true);
+  ds18b20ObjectInit(&net, &b->ow, b->rom, dev, MAX_DEVICES);
+  CHECK(n == ds18b20Discover(&net));
+  CHECK(false == net.parasite);
+
+  /* power-on configuration was fetched */
+  for (i = 0; i < n; i++) {
+    CHECK(75 == dev[i].th);
+    CHECK(70 == dev[i].tl);
+  }
+
+  for (i = 0; i < n; i++)
+    ds18b20SetConfig(&net, i, 9 + i % 4, (int8_t)(40 + i), (int8_t)-i);
+
+  t0 = b->sim.bus_time;
+  s0 = osalOsGetSystemTimeX();
+  ok = ds18b20Sweep(&net);
+  CHECK(n == ok);
+  test_report("ds18b20", "sweep_40", "bus_time",
+              (b->sim.bus_time - t0) / 1000.0, "ms");
+  test_report("ds18b20", "sweep_40", "sleep_time",
+              (osalOsGetSystemTimeX() - s0) / 1000.0, "ms");
+
+  for (i = 0; i < n; i++) {
+    /* the device at index i must be found among simulated ones */
+    for (j = 0; j < n; j++) {
+      if (0 == memcmp(b->dev[j].rom, ds18b20GetRom(&net, i), 8))
+        break;
+    }
+    CHECK(j < n);
+    if (j == n)
+      continue;
+    CHECK(0 != (dev[i].flags & DS18B20_FLAG_VALID));
+    CHECK(owsimExpected(&b->dev[j]) == dev[i].temperature);
+    CHECK((int8_t)b->dev[j].sp[2] == dev[i].th);
+    CHECK((int8_t)b->dev[j].sp[3] == dev[i].tl);
+  }
+
+  /* transient CRC errors are retried, persistent ones are reported */
+  for (i = 0; i < 5; i++)
+    b->dev[i].corrupt_reads = 1;
+  b->dev[7].corrupt_reads = DS18B20_READ_ATTEMPTS;
+  net.crc_errors = 0;
+  net.reads = 0;
+  ok = ds18b20Sweep(&net);
+  CHECK(n - 1 == ok);
+  CHECK(5 + DS18B20_READ_ATTEMPTS == net.crc_errors);
+  CHECK(n + 5 + (DS18B20_READ_ATTEMPTS - 1) == net.reads);
+  for (i = 0; i < n; i++) {
+    if (0 == memcmp(b->dev[7].rom, ds18b20GetRom(&net, i), 8)) {
+      CHECK(0 == (dev[i].flags & DS18B20_FLAG_VALID));
+      CHECK(1 == dev[i].errors);
+    }
+  }
+
+  /* real 85 C readings are kept, a DS18S20 one is dropped once */
+  k1 = net_index(&net, &b->dev[1]);
+  k5 = net_index(&net, &b->dev[5]);
+  b->dev[1].temperature = 85000;
+  b->dev[5].temperature = 85000;
+  CHECK(n - 1 == ds18b20Sweep(&net));
+  CHECK(0 != (dev[k1].flags & DS18B20_FLAG_VALID));
+  CHECK(85000 == dev[k1].temperature);
+  CHECK(0 != (dev[k5].flags & DS18B20_FLAG_POWER_ON));
+  for (i = 0; i < 3; i++) {
+    CHECK(n == ds18b20Sweep(&net));
+    CHECK(85000 == dev[k1].temperature);
+    CHECK(85000 == dev[k5].temperature);
+  }
+  b->dev[1].temperature = 25000;
+  b->dev[5].temperature = 25000;
+
+  /* reset during conversion is told by the reverted configuration */
+  k2 = net_index(&net, &b->dev[2]);
+  b->dev[2].temperature = 20000;
+  CHECK(n == ds18b20Sweep(&net));
+  b->dev[2].reset_conversions = 1;
+  CHECK(n - 1 == ds18b20Sweep(&net));
+  CHECK(0 != (dev[k2].flags & DS18B20_FLAG_POWER_ON));
+  CHECK(20000 == dev[k2].temperature);
+  CHECK(n == ds18b20Sweep(&net));
+  CHECK((int8_t)b->dev[2].sp[2] == dev[k2].th);
+
+  /* and by COUNT REMAIN when the configuration matches the EEPROM */
+  ds18b20SetConfig(&net, k2, 12, 75, 70);
+  CHECK(n == ds18b20Sweep(&net));
+  b->dev[2].reset_conversions = 1;
+  CHECK(n - 1 == ds18b20Sweep(&net));
+  CHECK(0 != (dev[k2].flags & DS18B20_FLAG_POWER_ON));
+  CHECK(n == ds18b20Sweep(&net));
+  CHECK(20000 == dev[k2].temperature);
+
+  /* parasite powered device disables polling, sweep still succeeds */
+  b->dev[3].parasite = true;
+  CHECK(n == ds18b20Discover(&net));
+  CHECK(true == net.parasite);
+  CHECK(n == ds18b20Sweep(&net));
+  bus_close(b);
+}
+
+static void *parallel_worker(void *arg) {
+  testbus_t *b = arg;
+  unsigned i;
+
+  for (i = 0; i < 10; i++) {
+    size_t found;
+
+    memset(b->rom, 0, sizeof(b->rom));
+    found = onewireSearchRom(&b->ow, b->rom, MAX_DEVICES);
+    if (!roms_match(b, found))
+      return b;
+  }
+  return NULL;
+}
+
+static void parallel_suite(void) {
+  pthread_t t[ONEWIRE_MAX_BUSES];
+  size_t i;
+  double h0;
+
+  for (i = 0; i < ONEWIRE_MAX_BUSES; i++)
+    bus_open(&buses[i], 16 + i, false);
+
+  h0 = test_seconds();
+  for (i = 0; i < ONEWIRE_MAX_BUSES; i++)
+    pthread_create(&t[i], NULL, parallel_worker, &buses[i]);
+  for (i = 0; i < ONEWIRE_MAX_BUSES; i++) {
+    void *ret;
+
+    pthread_join(t[i], &ret);
+    CHECK(NULL == ret);
+  }
+  test_report("onewire", "parallel_search", "host_time",
+              (test_seconds() - h0) * 1000.0, "ms");
+
+  for (i = 0; i < ONEWIRE_MAX_BUSES; i++)
+    bus_close(&buses[i]);
+}
+
+/*
+ ******************************************************************************
+ * EXPORTED FUNCTIONS
+ ******************************************************************************
+ */
+
+int main(void) {
+
+  test_report_extra = ",\"backend\":\"" BACKEND "\"";
+
+  presence_suite();
+  search_suite();
+  targeted_suite();
+  topology_suite();
+  ds18b20_suite();
+  parallel_suite();
+
+  return test_summary();
+}
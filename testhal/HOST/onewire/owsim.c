@@ -0,0 +1,406 @@
+/*
+    ChibiOS - Copyright (C) 2026 agent
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    owsim.c
+ * @brief   Simulated 1-wire bus with DS18B20 compatible devices.
+ * @details Every device runs its own copy of the slave protocol state
+ *          machine. Slot is processed in two phases: first all devices
+ *          put their bits on the wired-AND bus, then all of them sample
+ *          the resulting level.
+ */
+
+#include "owsim.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+#define FAMILY_DS18S20          0x10
+
+enum {
+  ST_IDLE = 0,
+  ST_ROM_CMD,
+  ST_SEARCH,
+  ST_MATCH,
+  ST_FUNC_CMD,
+  ST_TX,
+  ST_RX,
+  ST_CONVERT,
+  ST_POWER
+};
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+static bool rom_bit(const owsim_device_t *dp, unsigned bit) {
+
+  return (dp->rom[bit / 8] >> (bit % 8)) & 1;
+}
+
+static bool is_s20(const owsim_device_t *dp) {
+
+  return FAMILY_DS18S20 == dp->rom[0];
+}
+
+static unsigned resolution(const owsim_device_t *dp) {
+
+  return is_s20(dp) ? 9 : 9 + ((dp->sp[4] >> 5) & 3);
+}
+
+static int32_t floor_div(int32_t a, int32_t b) {
+
+  return (a >= 0) ? a / b : -((-a + b - 1) / b);
+}
+
+/*
+ * Temperature register content for current temperature.
+ */
+static int16_t raw_temperature(const owsim_device_t *dp) {
+  int32_t raw;
+
+  if (is_s20(dp))
+    return (int16_t)floor_div(dp->temperature, 500);
+
+  raw = floor_div(dp->temperature * 16, 1000);
+  raw &= ~((1 << (12 - resolution(dp))) - 1);
+  return (int16_t)raw;
+}
+
+static void update_crc(owsim_device_t *dp) {
+
+  dp->sp[8] = owsimCRC(dp->sp, 8);
+}
+
+/*
+ * Scratchpad after power-on, EEPROM holds the factory configuration.
+ */
+static void power_on(owsim_device_t *dp) {
+
+  if (is_s20(dp)) {
+    static const uint8_t por[8] = {0xAA, 0x00, 0x4B, 0x46,
+                                   0xFF, 0xFF, 0x0C, 0x10};
+    memcpy(dp->sp, por, 8);
+  }
+  else {
+    static const uint8_t por[8] = {0x50, 0x05, 0x4B, 0x46,
+                                   0x7F, 0xFF, 0x0C, 0x10};
+    memcpy(dp->sp, por, 8);
+  }
+  update_crc(dp);
+}
+
+/*
+ * Conversion result appears in scratchpad when conversion time elapsed.
+ */
+static void update(owsim_device_t *dp, systime_t now) {
+  int16_t raw;
+  int8_t t;
+
+  if (!dp->converting || ((int32_t)(now - dp->busy_until) < 0))
+    return;
+
+  dp->converting = false;
+  if (dp->reset_conversions > 0) {
+    dp->reset_conversions--;
+    power_on(dp);
+    return;
+  }
+  raw = raw_temperature(dp);
+  dp->sp[0] = (uint8_t)raw;
+  dp->sp[1] = (uint8_t)(raw >> 8);
+  /* COUNT REMAIN of the DS18B20 follows the fraction.*/
+  if (!is_s20(dp))
+    dp->sp[6] = (uint8_t)(0x10 - (raw & 0x0F));
+  t = (int8_t)(is_s20(dp) ? raw >> 1 : raw >> 4);
+  dp->alarm = (t >= (int8_t)dp->sp[2]) || (t <= (int8_t)dp->sp[3]);
+  update_crc(dp);
+}
+
+static void start_tx(owsim_device_t *dp, const uint8_t *data,
+                     uint16_t len, uint8_t next) {
+  uint16_t i;
+
+  for (i = 0; i < len; i++)
+    dp->buf[i] = data[i];
+  dp->len = len;
+  dp->bit = 0;
+  dp->step = next;
+  dp->state = ST_TX;
+}
+
+static void rom_command(owsim_device_t *dp) {
+
+  dp->bit = 0;
+  dp->step = 0;
+  switch (dp->cmd) {
+  case 0xF0:
+    dp->state = ST_SEARCH;
+    break;
+  case 0xEC:
+    dp->state = dp->alarm ? ST_SEARCH : ST_IDLE;
+    break;
+  case 0x55:
+    dp->state = ST_MATCH;
+    break;
+  case 0xCC:
+    dp->state = ST_FUNC_CMD;
+    dp->cmd = 0;
+    break;
+  case 0x33:
+    start_tx(dp, dp->rom, 8, ST_FUNC_CMD);
+    break;
+  default:
+    dp->state = ST_IDLE;
+    break;
+  }
+}
+
+static void function_command(owsim_device_t *dp, systime_t now) {
+
+  dp->bit = 0;
+  switch (dp->cmd) {
+  case 0x44:
+    dp->busy_until = now + OSAL_MS2ST(750U >> (12 - resolution(dp)));
+    dp->converting = true;
+    dp->state = ST_CONVERT;
+    break;
+  case 0xBE:
+    start_tx(dp, dp->sp, 9, ST_IDLE);
+    if (dp->corrupt_reads > 0) {
+      dp->buf[0] ^= 0x10;
+      dp->corrupt_reads--;
+    }
+    break;
+  case 0x4E:
+    dp->len = is_s20(dp) ? 2 : 3;
+    dp->buf[0] = dp->buf[1] = dp->buf[2] = 0;
+    dp->state = ST_RX;
+    break;
+  case 0xB4:
+    dp->state = ST_POWER;
+    break;
+  default:
+    dp->state = ST_IDLE;
+    break;
+  }
+}
+
+/*
+ * Bit driven by device in current slot, true means released bus.
+ */
+static bool output(const owsim_device_t *dp) {
+
+  switch (dp->state) {
+  case ST_SEARCH:
+    if (0 == dp->step)
+      return rom_bit(dp, dp->bit);
+    if (1 == dp->step)
+      return !rom_bit(dp, dp->bit);
+    return true;
+  case ST_TX:
+    return (dp->buf[dp->bit / 8] >> (dp->bit % 8)) & 1;
+  case ST_CONVERT:
+    return !dp->converting;
+  case ST_POWER:
+    return !dp->parasite;
+  default:
+    return true;
+  }
+}
+
+static void input(owsim_device_t *dp, bool level, systime_t now) {
+
+  switch (dp->state) {
+  case ST_ROM_CMD:
+  case ST_FUNC_CMD:
+    dp->cmd |= (uint8_t)(level << dp->bit);
+    if (8 == ++dp->bit) {
+      if (ST_ROM_CMD == dp->state)
+        rom_command(dp);
+      else
+        function_command(dp, now);
+    }
+    break;
+  case ST_SEARCH:
+    if (dp->step < 2) {
+      dp->step++;
+      break;
+    }
+    if (level != rom_bit(dp, dp->bit)) {
+      dp->state = ST_IDLE;
+      break;
+    }
+    dp->step = 0;
+    if (64 == ++dp->bit) {
+      dp->state = ST_FUNC_CMD;
+      dp->bit = 0;
+      dp->cmd = 0;
+    }
+    break;
+  case ST_MATCH:
+    if (level != rom_bit(dp, dp->bit)) {
+      dp->state = ST_IDLE;
+      break;
+    }
+    if (64 == ++dp->bit) {
+      dp->state = ST_FUNC_CMD;
+      dp->bit = 0;
+      dp->cmd = 0;
+    }
+    break;
+  case ST_TX:
+    if (++dp->bit == dp->len * 8) {
+      dp->state = dp->step;
+      dp->bit = 0;
+      dp->cmd = 0;
+    }
+    break;
+  case ST_RX:
+    dp->buf[dp->bit / 8] |= (uint8_t)(level << (dp->bit % 8));
+    if (++dp->bit == dp->len * 8) {
+      dp->sp[2] = dp->buf[0];
+      dp->sp[3] = dp->buf[1];
+      if (!is_s20(dp))
+        dp->sp[4] = (dp->buf[2] & 0x60) | 0x1F;
+      update_crc(dp);
+      dp->state = ST_IDLE;
+    }
+    break;
+  default:
+    break;
+  }
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Bitwise 1-wire CRC, independent from driver's table.
+ */
+uint8_t owsimCRC(const uint8_t *buf, size_t len) {
+  uint8_t crc = 0;
+  size_t i;
+  unsigned b;
+
+  for (i = 0; i < len; i++) {
+    crc ^= buf[i];
+    for (b = 0; b < 8; b++)
+      crc = (crc & 1) ? (crc >> 1) ^ 0x8C : crc >> 1;
+  }
+  return crc;
+}
+
+/**
+ * @brief   Initializes device in power-on state.
+ *
+ * @param[out] dp           pointer to the @p owsim_device_t object
+ * @param[in] family        family code
+ * @param[in] serial        48 bit serial number
+ * @param[in] temperature   temperature in millicelsius
+ */
+void owsimDeviceInit(owsim_device_t *dp, uint8_t family,
+                     uint64_t serial, int32_t temperature) {
+  unsigned i;
+
+  memset(dp, 0, sizeof(*dp));
+  dp->rom[0] = family;
+  for (i = 1; i < 7; i++) {
+    dp->rom[i] = (uint8_t)serial;
+    serial >>= 8;
+  }
+  dp->rom[7] = owsimCRC(dp->rom, 7);
+  dp->temperature = temperature;
+  dp->present = true;
+  power_on(dp);
+}
+
+/**
+ * @brief   Temperature in millicelsius master is expected to read.
+ */
+int32_t owsimExpected(const owsim_device_t *dp) {
+  int32_t raw = raw_temperature(dp);
+
+  if (is_s20(dp))
+    return raw * 500;
+  return (raw * 625) / 10;
+}
+
+/**
+ * @brief   Initializes bus.
+ */
+void owsimBusInit(owsim_bus_t *bus, owsim_device_t *dev, size_t devices) {
+
+  memset(bus, 0, sizeof(*bus));
+  bus->dev = dev;
+  bus->devices = devices;
+  bus->level = true;
+}
+
+/**
+ * @brief   Reset pulse.
+ *
+ * @return              Bus level during presence sample, false means
+ *                      presence pulse (or shorted bus).
+ */
+bool owsimReset(owsim_bus_t *bus) {
+  size_t i;
+  bool level = !bus->shorted;
+
+  for (i = 0; i < bus->devices; i++) {
+    owsim_device_t *dp = &bus->dev[i];
+
+    dp->state = dp->present ? ST_ROM_CMD : ST_IDLE;
+    dp->bit = 0;
+    dp->cmd = 0;
+    if (dp->present)
+      level = false;
+  }
+  bus->resets++;
+  return level;
+}
+
+/**
+ * @brief   Time slot.
+ *
+ * @param[in] bus       pointer to the @p owsim_bus_t object
+ * @param[in] master    false when master holds bus low through sample point
+ *
+ * @return              Bus level at sample point.
+ */
+bool owsimSlot(owsim_bus_t *bus, bool master) {
+  systime_t now = osalOsGetSystemTimeX();
+  bool level = master && !bus->shorted;
+  size_t i;
+
+  for (i = 0; i < bus->devices; i++) {
+    owsim_device_t *dp = &bus->dev[i];
+
+    if (!dp->present)
+      continue;
+    update(dp, now);
+    if (!output(dp))
+      level = false;
+  }
+  for (i = 0; i < bus->devices; i++) {
+    if (bus->dev[i].present)
+      input(&bus->dev[i], level, now);
+  }
+  bus->slots++;
+  return level;
+}
@@ -0,0 +1,136 @@
+/*
+    ChibiOS - Copyright (C) 2026 agent
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    owsim.h
+ * @brief   Simulated 1-wire bus with DS18B20 compatible devices.
+ * @details Bus is simulated on time slot level. Emulated PWM (or UART)
+ *          driver calls @p owsimReset() or @p owsimSlot() for every pulse
+ *          generated by master and the returned level is seen by the
+ *          1-wire driver through @p palReadPad().
+ */
+
+#ifndef OWSIM_H_
+#define OWSIM_H_
+
+#include "osal.h"
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Simulated device.
+ */
+typedef struct {
+  /**
+   * @brief   ROM code, CRC byte is calculated by @p owsimDeviceInit().
+   */
+  uint8_t       rom[8];
+  /**
+   * @brief   Temperature in millicelsius sampled by next conversion.
+   */
+  int32_t       temperature;
+  /**
+   * @brief   Device connected to bus. May be changed on the fly.
+   */
+  bool          present;
+  /**
+   * @brief   Device is parasite powered.
+   */
+  bool          parasite;
+  /**
+   * @brief   Number of following scratchpad reads to be corrupted.
+   */
+  uint8_t       corrupt_reads;
+  /**
+   * @brief   Number of following conversions interrupted by power-on reset.
+   */
+  uint8_t       reset_conversions;
+  /**
+   * @brief   Scratchpad content, power-on value after init.
+   */
+  uint8_t       sp[9];
+  /**
+   * @brief   Conversion end time, valid when @p converting is set.
+   */
+  systime_t     busy_until;
+  bool          converting;
+  /**
+   * @brief   Alarm condition after last conversion.
+   */
+  bool          alarm;
+  /* Protocol state.*/
+  uint8_t       state;
+  uint8_t       step;
+  uint16_t      bit;
+  uint16_t      len;
+  uint8_t       cmd;
+  uint8_t       buf[9];
+} owsim_device_t;
+
+/**
+ * @brief   Simulated bus.
+ */
+typedef struct {
+  /**
+   * @brief   Devices connected to bus.
+   */
+  owsim_device_t  *dev;
+  size_t          devices;
+  /**
+   * @brief   Bus is shorted to ground.
+   */
+  bool            shorted;
+  /**
+   * @brief   Level seen by master at the moment, true is high.
+   */
+  bool            level;
+  /**
+   * @brief   Statistics.
+   */
+  uint32_t        resets;
+  uint32_t        slots;
+  uint64_t        bus_time;
+} owsim_bus_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  uint8_t owsimCRC(const uint8_t *buf, size_t len);
+  void owsimDeviceInit(owsim_device_t *dp, uint8_t family,
+                       uint64_t serial, int32_t temperature);
+  int32_t owsimExpected(const owsim_device_t *dp);
+  void owsimBusInit(owsim_bus_t *bus, owsim_device_t *dev, size_t devices);
+  bool owsimReset(owsim_bus_t *bus);
+  bool owsimSlot(owsim_bus_t *bus, bool master);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OWSIM_H_ */
@@ -0,0 +1,486 @@
+/*
+    ChibiOS - Copyright (C) 2026 agent
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/*
+ * Sensor conversion tests against simulated bus.
+ *
+ * Raw values are put in registers of simulated targets and read back by
+ * unmodified drivers through both float and fixed-point paths. Fixed-point
+ * results are compared with the float path and with exact (double)
+ * conversion. Results are printed as one JSON object per line, failures
+ * go to stderr.
+ *
+ * The measurement scheduler is run over fake sensors spread on two
+ * simulated buses, with conversion times, read lengths and start
+ * failures chosen so a sweep has to interleave the buses and batch
+ * sensors of one bus.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <math.h>
+
+#include "hal.h"
+#include "hdc1000.h"
+#include "tsl2591.h"
+#include "sensor_sched.h"
+#include "test_util.h"
+
+/*
+ ******************************************************************************
+ * DEFINES
+ ******************************************************************************
+ */
+
+#define ADDR_HDC1000        0x40U
+#define ADDR_TSL2591        TSL2591_I2CADDR_DEFAULT
+
+#define TSL_SAMPLES         4000
+
+/* Documented bounds, in result LSB.*/
+#define HDC_TEMP_BOUND      0.5
+#define HDC_HUM_BOUND       0.65
+#define TSL_REL_BOUND       5e-5
+#define TSL_ABS_BOUND       0.5
+
+#define SCHED_SENSORS       4
+#define SCHED_BUSES         2
+#define SCHED_SWEEPS        3
+
+/*
+ ******************************************************************************
+ * TYPES
+ ******************************************************************************
+ */
+
+/*
+ * Fake sensor, the I2C helper is deliberately not the first field.
+ */
+typedef struct {
+  unsigned int      time;       /* Conversion time, ms.                   */
+  msg_t             fail;       /* Status returned by start, MSG_OK.      */
+  size_t            rxbytes;    /* Bytes read back by read.               */
+  systime_t         ready;      /* Conversion end of the last start.      */
+  unsigned int      reads;
+  bool              unlocked;   /* Read without the bus held.             */
+  bool              early;      /* Read before the conversion end.        */
+  I2CHelper         i2c;
+} fake_sensor_t;
+
+/*
+ * Published reading, in publication order.
+ */
+typedef struct {
+  sensorSchedEntry  *ep;
+  msg_t             status;
+  unsigned int      order;      /* Read order, from the reading values.   */
+  uint32_t          batch;      /* Bus acquisitions done so far.          */
+} sched_event_t;
+
+/*
+ ******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************
+ */
+
+static const I2CConfig i2ccfg = {400000};
+
+static i2csim_target_t targets[2];
+static i2csim_bus_t sim;
+static I2CDriver i2cd;
+
+static i2csim_target_t sched_targets[SCHED_BUSES][SCHED_SENSORS];
+static i2csim_bus_t sched_sim[SCHED_BUSES];
+static I2CDriver sched_i2cd[SCHED_BUSES];
+static unsigned int sched_reads;
+static sched_event_t sched_events[SCHED_SENSORS];
+static size_t sched_count;
+
+/*
+ ******************************************************************************
+ * LOCAL FUNCTIONS
+ ******************************************************************************
+ */
+
+static void bus_open(void) {
+
+  i2csimTargetInit(&targets[0], ADDR_HDC1000, I2CSIM_REGS);
+  i2csimTargetInit(&targets[1], ADDR_TSL2591, I2CSIM_REGS);
+  i2csimBusInit(&sim, targets, 2, i2ccfg.clock_speed);
+  i2cObjectInit(&i2cd, &sim);
+  i2cStart(&i2cd, &i2ccfg);
+}
+
+static void hdc_load(uint16_t temp, uint16_t hum) {
+  i2csim_target_t *tp = &targets[0];
+
+  tp->mem[0] = (uint8_t)(temp >> 8);
+  tp->mem[1] = (uint8_t)temp;
+  tp->mem[2] = (uint8_t)(hum >> 8);
+  tp->mem[3] = (uint8_t)hum;
+  tp->ptr = 0;
+}
+
+static void tsl_load(uint16_t broadband, uint16_t ir) {
+  i2csim_target_t *tp = &targets[1];
+
+  tp->mem[0xB4] = (uint8_t)broadband;
+  tp->mem[0xB5] = (uint8_t)(broadband >> 8);
+  tp->mem[0xB6] = (uint8_t)ir;
+  tp->mem[0xB7] = (uint8_t)(ir >> 8);
+}
+
+static msg_t fake_start(void *drv) {
+  fake_sensor_t *fp = drv;
+  static const uint8_t cmd = 0;
+  msg_t msg;
+
+  if (MSG_OK != fp->fail)
+    return fp->fail;
+  msg = i2cMasterTransmitTimeout(fp->i2c.driver, fp->i2c.addr,
+                                 &cmd, 1, NULL, 0, TIME_INFINITE);
+  fp->ready = osalOsGetSystemTimeX() + OSAL_MS2I(fp->time);
+  return msg;
+}
+
+static unsigned int fake_time(void *drv) {
+
+  return ((fake_sensor_t *)drv)->time;
+}
+
+static msg_t fake_read(void *drv, float *values) {
+  fake_sensor_t *fp = drv;
+  uint8_t buf[64];
+
+  /* owner's trylock fails while the bus is held */
+  if (EBUSY != pthread_mutex_trylock(&fp->i2c.driver->mutex)) {
+    pthread_mutex_unlock(&fp->i2c.driver->mutex);
+    fp->unlocked = true;
+  }
+  if ((int32_t)(osalOsGetSystemTimeX() - fp->ready) < 0)
+    fp->early = true;
+  fp->reads++;
+  values[0] = (float)sched_reads++;
+  return i2cMasterReceiveTimeout(fp->i2c.driver, fp->i2c.addr,
+                                 buf, fp->rxbytes, TIME_INFINITE);
+}
+
+static const I2CHelper *fake_bus(void *drv) {
+
+  return &((fake_sensor_t *)drv)->i2c;
+}
+
+static const sensor_ops_t fake_ops = {
+  fake_start, fake_time, fake_read, fake_bus, 1
+};
+
+static void sched_publish(sensorSchedEntry *ep, void *arg) {
+  sensorSched *sp = arg;
+  sched_event_t *evp = &sched_events[sched_count++];
+
+  evp->ep = ep;
+  evp->status = sensorSchedGetReading(ep)->status;
+  evp->order = (unsigned int)sensorSchedGetReading(ep)->values[0];
+  evp->batch = sp->acquisitions;
+}
+
+/*
+ ******************************************************************************
+ * SUITES
+ ******************************************************************************
+ */
+
+/*
+ * Every raw code of both channels.
+ */
+static void hdc1000_suite(void) {
+  HDC1000_config cfg = {{&i2cd, ADDR_HDC1000}};
+  HDC1000_drv drv;
+  double temp_err = 0, hum_err = 0, temp_ferr = 0, hum_ferr = 0;
+  uint32_t raw;
+
+  bus_open();
+  HDC1000_init(&drv, &cfg);
+
+  for (raw = 0; raw <= 0xFFFF; raw++) {
+    uint16_t hraw = (uint16_t)(0xFFFF - raw);
+    float temperature, humidity;
+    int32_t mtemp = INT32_MIN;
+    uint16_t chum = 0xFFFF;
+    double exact;
+
+    hdc_load((uint16_t)raw, hraw);
+    drv.state = SENSOR_MEASURING;
+    CHECK(MSG_OK == HDC1000_readMeasure(&drv, &temperature, &humidity));
+    hdc_load((uint16_t)raw, hraw);
+    drv.state = SENSOR_MEASURING;
+    CHECK(MSG_OK == HDC1000_readMeasureFixed(&drv, &mtemp, &chum));
+
+    exact = raw * 165000.0 / 65536.0 - 40000.0;
+    temp_err = fmax(temp_err, fabs(mtemp - exact));
+    temp_ferr = fmax(temp_ferr, fabs(mtemp - temperature * 1000.0));
+    exact = hraw * 10000.0 / 65535.0;
+    hum_err = fmax(hum_err, fabs(chum - exact));
+    hum_ferr = fmax(hum_ferr, fabs(chum - humidity * 100.0));
+  }
+
+  /* float path carries its own rounding, a few units of 1e-3 LSB */
+  CHECK(temp_err <= HDC_TEMP_BOUND);
+  CHECK(temp_ferr <= HDC_TEMP_BOUND + 0.01);
+  CHECK(hum_err <= HDC_HUM_BOUND);
+  CHECK(hum_ferr <= HDC_HUM_BOUND + 0.01);
+  test_report("sensors", "hdc1000", "temperature_error_max",
+              temp_err, "m°C");
+  test_report("sensors", "hdc1000", "temperature_float_diff_max",
+              temp_ferr, "m°C");
+  test_report("sensors", "hdc1000", "humidity_error_max",
+              hum_err, "0.01%RH");
+  test_report("sensors", "hdc1000", "humidity_float_diff_max",
+              hum_ferr, "0.01%RH");
+
+  /* NULL outputs are skipped */
+  hdc_load(0x8000, 0x8000);
+  drv.state = SENSOR_MEASURING;
+  CHECK(MSG_OK == HDC1000_readMeasureFixed(&drv, NULL, NULL));
+}
+
+/*
+ * Random channel counts for every gain and integration time.
+ */
+static void tsl2591_suite(void) {
+  static const unsigned again[4] = {1, 25, 415, 10000};
+  TSL2591_config cfg = {{&i2cd, ADDR_TSL2591}};
+  TSL2591_drv drv;
+  double rel_err = 0;
+  uint32_t lux_diff = 0;
+  unsigned g, t, i;
+
+  bus_open();
+  TSL2591_init(&drv, &cfg);
+
+  for (g = 0; g < 4; g++) {
+    for (t = 0; t < 6; t++) {
+      double cpl = (100.0 * (t + 1) * again[g]) / 408.0;
+
+      drv.gain = (TSL2591_gain_t)(g << 4);
+      drv.integration_time = (TSL2591_integration_time_t)t;
+
+      for (i = 0; i < TSL_SAMPLES; i++) {
+        uint16_t broadband = (uint16_t)(test_random32() % 0xFFFF);
+        /* float path is undefined for negative lux, IR stays below */
+        uint16_t ir = (uint16_t)(test_random32() %
+                                 (broadband * 6U / 10U + 1U));
+        unsigned int lux = 0;
+        uint32_t mlux = 0;
+        double exact, err;
+
+        tsl_load(broadband, ir);
+        CHECK(MSG_OK == TSL2591_readIlluminance(&drv, &lux));
+        CHECK(MSG_OK == TSL2591_readIlluminanceFixed(&drv, &mlux));
+
+        exact = fmax(broadband - 1.64 * ir, 0.59 * broadband - 0.86 * ir) /
+                cpl * 1000.0;
+        err = fabs(mlux - exact);
+        CHECK(err <= TSL_ABS_BOUND + TSL_REL_BOUND * exact);
+        if (exact > 1e6)
+          rel_err = fmax(rel_err, err / exact);
+        /* float path truncates to whole lux */
+        if (mlux / 1000U > lux)
+          lux_diff = (mlux / 1000U - lux > lux_diff) ? mlux / 1000U - lux
+                                                      : lux_diff;
+        else
+          lux_diff = (lux - mlux / 1000U > lux_diff) ? lux - mlux / 1000U
+                                                      : lux_diff;
+      }
+    }
+  }
+  CHECK(lux_diff <= 1);
+  test_report("sensors", "tsl2591", "relative_error_max", rel_err, "ratio");
+  test_report("sensors", "tsl2591", "float_diff_max", lux_diff, "lux");
+
+  /* saturated channel and negative equation result */
+  drv.gain = TSL2591_GAIN_1X;
+  drv.integration_time = TSL2591_INTEGRATIONTIME_100MS;
+  {
+    uint32_t mlux = 0;
+
+    tsl_load(0xFFFF, 10);
+    CHECK(MSG_OK == TSL2591_readIlluminanceFixed(&drv, &mlux));
+    CHECK(0xFFFFFFFF == mlux);
+    tsl_load(100, 100);
+    CHECK(MSG_OK == TSL2591_readIlluminanceFixed(&drv, &mlux));
+    CHECK(0 == mlux);
+    tsl_load(0xFFFE, 0);
+    CHECK(MSG_OK == TSL2591_readIlluminanceFixed(&drv, &mlux));
+    CHECK(mlux == (uint32_t)(0xFFFE * 4080.0 + 0.5));
+  }
+}
+
+/*
+ * Sweeps over fake sensors on a fast and a slow bus. The slow bus sensor
+ * is due first and its long read lets both sensors of the fast bus become
+ * due, in the reverse of their registration order, before the fast bus
+ * is visited again.
+ */
+static void sched_suite(void) {
+  static const I2CConfig cfg[SCHED_BUSES] = {{400000}, {100000}};
+  /* bus, conversion ms, start status, read length */
+  static const struct {
+    unsigned int bus, time;
+    msg_t fail;
+    size_t rxbytes;
+  } setup[SCHED_SENSORS] = {
+    {0, 6, MSG_OK,      1},
+    {0, 1, MSG_TIMEOUT, 1},
+    {1, 4, MSG_OK,      32},
+    {0, 5, MSG_OK,      1}
+  };
+  fake_sensor_t sensors[SCHED_SENSORS];
+  sensorSchedEntry entries[SCHED_SENSORS];
+  sensorSchedListener listener;
+  sensorSched sched;
+  HDC1000_config hdc_cfg = {{&i2cd, ADDR_HDC1000}};
+  HDC1000_drv hdc;
+  unsigned int longest = 0, sum = 0, sweep, b, i;
+  double duration_max = 0;
+
+  for (b = 0; b < SCHED_BUSES; b++) {
+    for (i = 0; i < SCHED_SENSORS; i++)
+      i2csimTargetInit(&sched_targets[b][i], (uint8_t)(0x10U + i),
+                       I2CSIM_REGS);
+    i2csimBusInit(&sched_sim[b], sched_targets[b], SCHED_SENSORS,
+                  cfg[b].clock_speed);
+    i2cObjectInit(&sched_i2cd[b], &sched_sim[b]);
+    i2cStart(&sched_i2cd[b], &cfg[b]);
+  }
+
+  sensorSchedObjectInit(&sched);
+  sensorSchedSubscribe(&sched, &listener, sched_publish, &sched);
+  for (i = 0; i < SCHED_SENSORS; i++) {
+    fake_sensor_t *fp = &sensors[i];
+
+    fp->time = setup[i].time;
+    fp->fail = setup[i].fail;
+    fp->rxbytes = setup[i].rxbytes;
+    fp->ready = 0;
+    fp->reads = 0;
+    fp->unlocked = false;
+    fp->early = false;
+    fp->i2c.driver = &sched_i2cd[setup[i].bus];
+    fp->i2c.addr = (i2caddr_t)(0x10U + i);
+    sensorSchedAdd(&sched, &entries[i], &fake_ops, fp);
+    if (MSG_OK == fp->fail) {
+      longest = (fp->time > longest) ? fp->time : longest;
+      sum += fp->time;
+    }
+  }
+
+  for (sweep = 0; sweep < SCHED_SWEEPS; sweep++) {
+    uint32_t acquisitions = sched.acquisitions;
+    uint32_t batches = 0, batch = 0;
+    fake_sensor_t *read[SCHED_SENSORS - 1] = {NULL};
+    uint64_t bus_time = 0, wire_time = 0;
+    size_t n;
+
+    for (b = 0; b < SCHED_BUSES; b++) {
+      sched_i2cd[b].acquisitions = 0;
+      bus_time += sched_sim[b].bus_time;
+    }
+    sched_reads = 0;
+    sched_count = 0;
+
+    n = sensorSchedSweep(&sched);
+    CHECK(SCHED_SENSORS - 1 == n);
+    CHECK(SCHED_SENSORS == sched_count);
+
+    /* the longest conversion plus wire time, not the sum */
+    for (b = 0; b < SCHED_BUSES; b++)
+      wire_time += sched_sim[b].bus_time;
+    wire_time -= bus_time;
+    CHECK(sched.duration >= OSAL_MS2I(longest));
+    CHECK(sched.duration <= OSAL_MS2I(longest) + wire_time);
+    CHECK(sched.duration < OSAL_MS2I(sum));
+    duration_max = fmax(duration_max, sched.duration / 1000.0);
+
+    /* every acquisition is seen by the driver, start phase takes one per
+       bus, then every further acquisition publishes one batch */
+    CHECK(sched.acquisitions - acquisitions ==
+          sched_i2cd[0].acquisitions + sched_i2cd[1].acquisitions);
+    for (i = 0; i < sched_count; i++) {
+      sched_event_t *evp = &sched_events[i];
+
+      if ((MSG_OK == evp->status) && (evp->batch != batch)) {
+        batch = evp->batch;
+        batches++;
+      }
+    }
+    CHECK(sched.acquisitions - acquisitions == SCHED_BUSES + batches);
+    /* both fast bus sensors are read under a single acquisition */
+    CHECK(2 == batches);
+
+    /* the failed start is published first, with its status, never read */
+    CHECK(&entries[1] == sched_events[0].ep);
+    CHECK(MSG_TIMEOUT == sched_events[0].status);
+    CHECK(0 == sensors[1].reads);
+
+    /* read in deadline order: slow bus, then fast bus reversed */
+    for (i = 1; i < sched_count; i++) {
+      CHECK(MSG_OK == sched_events[i].status);
+      if (sched_events[i].order < SCHED_SENSORS - 1)
+        read[sched_events[i].order] = sched_events[i].ep->drv;
+    }
+    for (i = 1; i < SCHED_SENSORS - 1; i++)
+      CHECK((int32_t)(read[i]->ready - read[i - 1]->ready) >= 0);
+    CHECK(&sensors[2] == read[0]);
+    CHECK(&sensors[3] == read[1]);
+    CHECK(&sensors[0] == read[2]);
+  }
+
+  for (i = 0; i < SCHED_SENSORS; i++) {
+    CHECK(!sensors[i].unlocked);
+    CHECK(!sensors[i].early);
+  }
+  for (b = 0; b < SCHED_BUSES; b++)
+    CHECK(0 == sched_sim[b].overlaps);
+  CHECK(SCHED_SWEEPS == sched.sweeps);
+  CHECK(SCHED_SWEEPS == sched.errors);
+
+  /* drivers expose their helper whatever their layout */
+  HDC1000_init(&hdc, &hdc_cfg);
+  CHECK(&hdc_cfg.i2c == HDC1000_ops.bus(&hdc));
+
+  test_report("sensors", "sched", "sweep_duration_max", duration_max, "ms");
+  test_report("sensors", "sched", "longest_conversion", longest, "ms");
+  test_report("sensors", "sched", "sum_of_conversions", sum, "ms");
+  test_report("sensors", "sched", "acquisitions_per_sweep",
+              (double)sched.acquisitions / SCHED_SWEEPS, "count");
+}
+
+/*
+ ******************************************************************************
+ * EXPORTED FUNCTIONS
+ ******************************************************************************
+ */
+
+int main(void) {
+
+  hdc1000_suite();
+  tsl2591_suite();
+  sched_suite();
+
+  return test_summary();
+}
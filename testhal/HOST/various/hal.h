@@ -0,0 +1,92 @@
+/*
+    ChibiOS - Copyright (C) 2026 agent
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal.h
+ * @brief   Host replacement of HAL header for os/various test suite.
+ */
+
+#ifndef HAL_H_
+#define HAL_H_
+
+#include "osal_host.h"
+
+/*
+ * CRC driver settings, software driver only.
+ */
+#define HAL_USE_CRC                     TRUE
+#define CRC_USE_DMA                     FALSE
+#define CRC_USE_MUTUAL_EXCLUSION        FALSE
+#define STM32_CRC_USE_CRC1              FALSE
+#define CRCSW_USE_CRC1                  TRUE
+#define CRCSW_CRC32_TABLE               TRUE
+#define CRCSW_CRC16_TABLE               TRUE
+#define CRCSW_PROGRAMMABLE              TRUE
+/* CRCSW_SLICE_BUDGET comes from the Makefile.*/
+
+/*
+ * March C- reads go through the test suite, so it can inject faults.
+ */
+#define MARCHTEST_READ(p)               marchtest_host_read(p)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  uint32_t marchtest_host_read(volatile uint32_t *p);
+#ifdef __cplusplus
+}
+#endif
+
+/*
+ * Subset of hal_ioblock.h needed by the RAM disk.
+ */
+typedef enum {
+  BLK_UNINIT = 0,
+  BLK_STOP = 1,
+  BLK_ACTIVE = 2,
+  BLK_CONNECTING = 3,
+  BLK_DISCONNECTING = 4,
+  BLK_READY = 5,
+  BLK_READING = 6,
+  BLK_WRITING = 7,
+  BLK_SYNCING = 8
+} blkstate_t;
+
+typedef struct {
+  uint32_t      blk_size;
+  uint32_t      blk_num;
+} BlockDeviceInfo;
+
+struct BaseBlockDeviceVMT {
+  size_t instance_offset;
+  bool (*is_inserted)(void *instance);
+  bool (*is_protected)(void *instance);
+  bool (*connect)(void *instance);
+  bool (*disconnect)(void *instance);
+  bool (*read)(void *instance, uint32_t startblk,
+               uint8_t *buffer, uint32_t n);
+  bool (*write)(void *instance, uint32_t startblk,
+                const uint8_t *buffer, uint32_t n);
+  bool (*sync)(void *instance);
+  bool (*get_info)(void *instance, BlockDeviceInfo *bdip);
+};
+
+#define _base_block_device_data                                             \
+  blkstate_t state;
+
+#include "hal_crc.h"
+
+#endif /* HAL_H_ */
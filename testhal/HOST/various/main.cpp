@@ -0,0 +1,857 @@
+/*
+    ChibiOS - Copyright (C) 2026 agent
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/*
+ * Host property tests and micro benchmarks for os/various modules.
+ *
+ * Every measurement is printed as one JSON object per line, so results
+ * can be collected and compared between builds. Property failures are
+ * printed to stderr and make the program exit with non zero status.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <atomic>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HOST_HAS_TSC        1
+#endif
+
+#include "hal.h"
+#include "bitmap.h"
+#include "blkalloc.h"
+#include "tribuf.h"
+#include "ramdisk.h"
+#include "memtest.h"
+#include "marchtest.h"
+#include "pidbank.h"
+#include "test_util.h"
+
+/*
+ ******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************
+ */
+
+static std::mt19937 rng(12345);
+
+/*
+ ******************************************************************************
+ ******************************************************************************
+ * LOCAL FUNCTIONS
+ ******************************************************************************
+ ******************************************************************************
+ */
+
+typedef std::chrono::steady_clock clk;
+
+static double seconds_since(clk::time_point start) {
+  return std::chrono::duration<double>(clk::now() - start).count();
+}
+
+static uint32_t rnd(uint32_t max) {
+  return std::uniform_int_distribution<uint32_t>(0, max)(rng);
+}
+
+/*
+ * CRC
+ */
+
+/* Reference bit serial CRC, independent of crcsw.c.*/
+static uint32_t ref_crc(const CRCConfig *c, const uint8_t *p, size_t n) {
+  const uint32_t top = 1UL << (c->poly_size - 1);
+  const uint32_t mask = top | (top - 1);
+  uint32_t crc = c->initial_val;
+
+  for (size_t i = 0; i < n; i++) {
+    for (int b = 0; b < 8; b++) {
+      unsigned bit = c->reflect_data ? (p[i] >> b) & 1 : (p[i] >> (7 - b)) & 1;
+      bool msb = ((crc & top) != 0) ^ (bit != 0);
+      crc = (crc << 1) & mask;
+      if (msb)
+        crc ^= c->poly;
+    }
+  }
+  if (c->reflect_remainder) {
+    uint32_t r = 0;
+    for (uint32_t b = 0; b < c->poly_size; b++)
+      r |= ((crc >> b) & 1) << (c->poly_size - 1 - b);
+    crc = r;
+  }
+  return (crc ^ c->final_val) & mask;
+}
+
+static uint32_t drv_crc(const CRCConfig *c, const uint8_t *p, size_t n) {
+  CRCD1.config = c;
+  crc_lld_reset(&CRCD1);
+  return crc_lld_calc(&CRCD1, n, p);
+}
+
+static void crc_suite(void) {
+  static uint32_t tables[3][256];
+  static CRCConfig configs[] = {
+    *CRCSW_CRC32_TABLE_CONFIG,
+    *CRCSW_CRC16_TABLE_CONFIG,
+    {8,  0x31,       0x00,       0x00,       true,  true,  NULL},
+    {16, 0x1021,     0xFFFF,     0x0000,     false, false, NULL},
+    {32, 0x1EDC6F41, 0xFFFFFFFF, 0xFFFFFFFF, true,  true,  NULL},
+  };
+  static const char *names[] = {
+    "crc32", "crc16", "crc8_maxim", "crc16_ccitt", "crc32c"
+  };
+  std::vector<uint8_t> buf(16384 + 8);
+
+  for (auto &b : buf)
+    b = (uint8_t)rnd(255);
+
+  /* Table driven variants of the programmable configurations.*/
+  std::vector<CRCConfig> tabled(configs, configs + 5);
+  for (int i = 2; i < 5; i++) {
+    crcswBuildTable(&tabled[i], tables[i - 2]);
+    tabled[i].table = tables[i - 2];
+  }
+
+  crcStart(&CRCD1, &configs[0]);
+
+  /* Properties: random offsets and lengths, split in two calls, combine.*/
+  for (int k = 0; k < 5; k++) {
+    for (int it = 0; it < 500; it++) {
+      size_t off = rnd(7);
+      size_t n = rnd(4096);
+      size_t split = rnd((uint32_t)n);
+      const uint8_t *p = &buf[off];
+      uint32_t ref = ref_crc(&configs[k], p, n);
+
+      CHECK(drv_crc(&configs[k], p, n) == ref);
+      CHECK(drv_crc(&tabled[k], p, n) == ref);
+
+      CRCD1.config = &tabled[k];
+      crc_lld_reset(&CRCD1);
+      crc_lld_calc(&CRCD1, split, p);
+      CHECK(crc_lld_calc(&CRCD1, n - split, p + split) == ref);
+
+      uint32_t a = drv_crc(&tabled[k], p, split);
+      uint32_t b = drv_crc(&tabled[k], p + split, n - split);
+      CHECK(crcCombine(&CRCD1, a, b, n - split) == ref);
+    }
+  }
+
+  /* Throughput of table and bit serial paths.*/
+  for (int k = 0; k < 5; k++) {
+    for (int serial = 0; serial < 2; serial++) {
+      const CRCConfig *c = serial ? &configs[k] : &tabled[k];
+      char name[32];
+      size_t total = 0;
+      auto start = clk::now();
+#if HOST_HAS_TSC
+      uint64_t tsc = __rdtsc();
+#endif
+
+      if (serial && (c->table != NULL))
+        continue;
+      do {
+        drv_crc(c, buf.data(), 16384);
+        total += 16384;
+      } while (seconds_since(start) < 0.2);
+#if HOST_HAS_TSC
+      tsc = __rdtsc() - tsc;
+#endif
+      std::snprintf(name, sizeof(name), "%s%s", names[k],
+                    serial ? "_bitwise" : "");
+      test_report("crc", name, "throughput",
+                  total / seconds_since(start) / 1e6, "MB/s");
+#if HOST_HAS_TSC
+      test_report("crc", name, "cycles_per_byte",
+                  (double)tsc / total, "cycles");
+#endif
+    }
+  }
+}
+
+/*
+ * Bitmap
+ */
+
+static void bitmap_suite(void) {
+  const size_t bits = 4096;
+  std::vector<bitmap_word_t> words(BITMAP_WORDS(bits));
+  std::vector<bitmap_word_t> words2(BITMAP_WORDS(bits));
+  bitmap_t map = {words.data(), words.size()};
+  bitmap_t map2 = {words2.data(), words2.size()};
+
+  for (int it = 0; it < 2000; it++) {
+    std::vector<bool> ref(bits, false), ref2(bits, false);
+
+    bitmapObjectInit(&map, 0);
+    bitmapObjectInit(&map2, 0);
+    for (int op = rnd(20); op > 0; op--) {
+      size_t s = rnd(bits - 1);
+      size_t l = rnd((uint32_t)(bits - s));
+      bool set = rnd(1) != 0;
+      if (set)
+        bitmapSetRange(&map, s, l);
+      else
+        bitmapClearRange(&map, s, l);
+      for (size_t i = s; i < s + l; i++)
+        ref[i] = set;
+      size_t b = rnd(bits - 1);
+      bitmapSet(&map2, b);
+      ref2[b] = true;
+    }
+
+    size_t cnt = 0;
+    for (size_t i = 0; i < bits; i++) {
+      CHECK(bitmapGet(&map, i) == ref[i]);
+      cnt += ref[i];
+    }
+    CHECK(bitmapPopcount(&map) == cnt);
+
+    size_t from = rnd(bits + 10);
+    size_t exp_set = BITMAP_NO_BIT, exp_clr = BITMAP_NO_BIT;
+    for (size_t i = from; i < bits; i++) {
+      if (ref[i] && exp_set == BITMAP_NO_BIT)
+        exp_set = i;
+      if (!ref[i] && exp_clr == BITMAP_NO_BIT)
+        exp_clr = i;
+    }
+    CHECK(bitmapFindNextSet(&map, from) == exp_set);
+    CHECK(bitmapFindNextClear(&map, from) == exp_clr);
+
+    size_t s = rnd(bits - 1);
+    size_t l = rnd((uint32_t)(bits - s));
+    bool all_set = true, all_clr = true;
+    for (size_t i = s; i < s + l; i++) {
+      all_set = all_set && ref[i];
+      all_clr = all_clr && !ref[i];
+    }
+    CHECK(bitmapIsRangeSet(&map, s, l) == all_set);
+    CHECK(bitmapIsRangeClear(&map, s, l) == all_clr);
+
+    if (it & 1) {
+      bitmapOr(&map, &map2);
+      for (size_t i = 0; i < bits; i++)
+        CHECK(bitmapGet(&map, i) == (ref[i] || ref2[i]));
+    }
+    else {
+      bitmapAnd(&map, &map2);
+      for (size_t i = 0; i < bits; i++)
+        CHECK(bitmapGet(&map, i) == (ref[i] && ref2[i]));
+    }
+  }
+
+  /* Sparse map scan, word search against per bit loop.*/
+  bitmapObjectInit(&map, 0);
+  for (int i = 0; i < 16; i++)
+    bitmapSet(&map, rnd(bits - 1));
+
+  for (int perbit = 0; perbit < 2; perbit++) {
+    size_t iterations = 0;
+    volatile size_t sink = 0;
+    auto start = clk::now();
+
+    do {
+      if (perbit) {
+        for (size_t i = 0; i < bits; i++)
+          if (bitmapGet(&map, i))
+            sink = sink + i;
+      }
+      else {
+        size_t i;
+        BITMAP_FOREACH_SET(&map, i)
+          sink = sink + i;
+      }
+      iterations++;
+    } while (seconds_since(start) < 0.2);
+    test_report("bitmap", perbit ? "scan_per_bit" : "scan_word",
+                "latency", seconds_since(start) / iterations * 1e9, "ns");
+  }
+}
+
+/*
+ * Block allocator
+ */
+
+/* true when the model has n free blocks at an aligned address */
+static bool blkalloc_fits(const std::vector<bool> &owned, const uint8_t *base,
+                          size_t bs, size_t n, size_t align) {
+  for (size_t b = 0; b + n <= owned.size(); b++) {
+    if ((align != 0) && (((uintptr_t)(base + b * bs) & (align - 1)) != 0))
+      continue;
+    size_t i = 0;
+    while ((i < n) && !owned[b + i])
+      i++;
+    if (i == n)
+      return true;
+  }
+  return false;
+}
+
+static void blkalloc_suite(const char *name, size_t bs, size_t offset) {
+  const size_t blocks = 1000;
+  std::vector<uint8_t> storage(blocks * bs + 64);
+  uint8_t *base = storage.data() + offset;
+  bitmap_word_t mw[BLKALLOC_MAP_WORDS(1000)];
+  bitmap_word_t sw[BLKALLOC_SUMMARY_WORDS(1000)];
+  bitmap_t map = {mw, sizeof(mw) / sizeof(mw[0])};
+  bitmap_t summary = {sw, sizeof(sw) / sizeof(sw[0])};
+  blkalloc_t ba;
+  struct live_t { uint8_t *p; size_t n; };
+  std::vector<live_t> live;
+  std::vector<bool> owned(blocks, false);
+  double worst = 0, sum = 0;
+  size_t calls = 0;
+
+  blkallocObjectInit(&ba, base, bs, blocks, &map, &summary);
+
+  for (int it = 0; it < 200000; it++) {
+    if ((live.size() < 500) && (rnd(2) != 0)) {
+      size_t n = rnd(3) ? 1 : 1 + rnd(15);
+      size_t align = rnd(4) ? 0 : 256;
+      auto start = clk::now();
+      uint8_t *p = (uint8_t *)blkallocAlloc(&ba, n, align);
+      double t = seconds_since(start);
+
+      worst = t > worst ? t : worst;
+      sum += t;
+      calls++;
+      if (p == NULL) {
+        CHECK(!blkalloc_fits(owned, base, bs, n, align));
+      }
+      else {
+        size_t b = (size_t)(p - base) / bs;
+        CHECK(((p - base) % bs) == 0);
+        CHECK((align == 0) || (((uintptr_t)p & (align - 1)) == 0));
+        for (size_t i = b; i < b + n; i++) {
+          CHECK(!owned[i]);
+          owned[i] = true;
+        }
+        live.push_back({p, n});
+      }
+    }
+    else if (!live.empty()) {
+      size_t k = rnd((uint32_t)live.size() - 1);
+      size_t b = (size_t)(live[k].p - base) / bs;
+      for (size_t i = b; i < b + live[k].n; i++)
+        owned[i] = false;
+      blkallocFree(&ba, live[k].p, live[k].n);
+      live[k] = live.back();
+      live.pop_back();
+    }
+  }
+
+  blkalloc_stats_t st;
+  osalSysLock();
+  blkallocGetStatsI(&ba, &st);
+  osalSysUnlock();
+  size_t used = 0;
+  for (size_t i = 0; i < blocks; i++)
+    used += owned[i];
+  CHECK(st.used == used);
+
+  test_report("blkalloc", name, "latency_avg", sum / calls * 1e9, "ns");
+  test_report("blkalloc", name, "latency_max", worst * 1e9, "ns");
+}
+
+/*
+ * Triple buffer
+ */
+
+static void tribuf_suite(void) {
+  const uint32_t frames = 200000;
+  const size_t len = 64;
+  static uint32_t bufs[3][64];
+  tribuf_t tb;
+  std::atomic<bool> done(false);
+  uint32_t received = 0, last = 0;
+  bool torn = false, order = false;
+
+  memset(bufs, 0, sizeof(bufs));
+  tribufObjectInit(&tb, bufs[0], bufs[1], bufs[2]);
+
+  auto start = clk::now();
+  std::thread producer([&]() {
+    for (uint32_t seq = 1; seq <= frames; seq++) {
+      uint32_t *b = (uint32_t *)tribufGetBack(&tb);
+      for (size_t i = 0; i < len; i++)
+        b[i] = seq;
+      tribufSwapBack(&tb);
+    }
+    done = true;
+  });
+
+  while (true) {
+    bool ready;
+    bool finished = done;
+
+    osalSysLock();
+    ready = tribufIsReadyI(&tb);
+    if (ready)
+      tribufSwapFrontI(&tb);
+    osalSysUnlock();
+
+    if (ready) {
+      const uint32_t *f = (const uint32_t *)tribufGetFront(&tb);
+      for (size_t i = 1; i < len; i++)
+        torn = torn || (f[i] != f[0]);
+      order = order || (f[0] <= last);
+      last = f[0];
+      received++;
+    }
+    else if (finished) {
+      break;
+    }
+  }
+  producer.join();
+
+  CHECK(!torn);
+  CHECK(!order);
+  CHECK(last == frames);
+  test_report("tribuf", "contention", "frames", received, "frames");
+  test_report("tribuf", "contention", "throughput",
+              frames / seconds_since(start), "frames/s");
+}
+
+/*
+ * RAM disk
+ */
+
+static void ramdisk_suite(void) {
+  const uint32_t bs = 512, nblk = 256;
+  std::vector<uint8_t> storage(bs * nblk), ref(bs * nblk, 0), tmp(bs * 8);
+  RamDisk rd;
+
+  ramdiskObjectInit(&rd);
+  ramdiskStart(&rd, storage.data(), bs, nblk, false);
+  rd.vmt->connect(&rd);
+
+  for (int it = 0; it < 5000; it++) {
+    uint32_t n = 1 + rnd(7);
+    uint32_t start = rnd(nblk - n);
+    if (rnd(1)) {
+      for (uint32_t i = 0; i < n * bs; i++)
+        tmp[i] = (uint8_t)rnd(255);
+      CHECK(rd.vmt->write(&rd, start, tmp.data(), n) == HAL_SUCCESS);
+      memcpy(&ref[start * bs], tmp.data(), n * bs);
+    }
+    else {
+      CHECK(rd.vmt->read(&rd, start, tmp.data(), n) == HAL_SUCCESS);
+      CHECK(memcmp(&ref[start * bs], tmp.data(), n * bs) == 0);
+    }
+  }
+  CHECK(rd.vmt->read(&rd, nblk - 1, tmp.data(), 2) == HAL_FAILED);
+
+  size_t total = 0;
+  auto start = clk::now();
+  do {
+    rd.vmt->read(&rd, rnd(nblk - 8), tmp.data(), 8);
+    total += 8 * bs;
+  } while (seconds_since(start) < 0.2);
+  test_report("ramdisk", "read_4k", "throughput",
+              total / seconds_since(start) / 1e6, "MB/s");
+
+  ramdiskStop(&rd);
+}
+
+/*
+ * Memory test
+ */
+
+static uint32_t memtest_clock_calls;
+static uint32_t memtest_fault_call;
+static uint8_t *memtest_fault_addr;
+static uint8_t *memtest_transient_addr;
+static size_t memtest_err_index;
+static uint32_t memtest_err_got, memtest_err_expect;
+static unsigned memtest_errors;
+
+/* Time source in microseconds, also injects fault between fill and check
+   phases on requested call.*/
+static uint32_t memtest_clock(void) {
+  if (++memtest_clock_calls == memtest_fault_call)
+    *memtest_fault_addr ^= 0x10;
+  return osalHostGetTime();
+}
+
+/* Read hook, flips a bit in the value read from the transient fault
+   address once, memory itself stays intact.*/
+extern "C" uint64_t memtest_host_read(const volatile void *p, size_t width) {
+  const volatile uint8_t *bp = static_cast<const volatile uint8_t *>(p);
+  uint8_t bytes[8];
+  uint64_t v = 0;
+
+  for (size_t i = 0; i < width; i++) {
+    bytes[i] = bp[i];
+    if (bp + i == memtest_transient_addr) {
+      bytes[i] ^= 0x10;
+      memtest_transient_addr = nullptr;
+    }
+  }
+  std::memcpy(&v, bytes, width);
+  return v;
+}
+
+static void memtest_err(memtest_t *testp, testtype type, size_t index,
+                        size_t width, uint32_t got, uint32_t expect) {
+  (void)testp;
+  (void)type;
+  (void)width;
+  memtest_errors++;
+  memtest_err_index = index;
+  memtest_err_got = got;
+  memtest_err_expect = expect;
+}
+
+static void memtest_suite(void) {
+  static const char *types[MEMTEST_TYPES_NUM] = {
+    "walking_one", "walking_zero", "own_address",
+    "inversion_zero", "inversion_55aa", "inversion_rand"
+  };
+  std::vector<uint64_t> mem(1024 * 1024 / 8);
+  memtest_t mt;
+
+  memset(&mt, 0, sizeof(mt));
+  mt.start      = mem.data();
+  mt.size       = mem.size() * sizeof(uint64_t);
+  mt.width_mask = MEMTEST_WIDTH_8 | MEMTEST_WIDTH_16 |
+                  MEMTEST_WIDTH_32 | MEMTEST_WIDTH_64;
+  mt.errcb      = memtest_err;
+  mt.clock      = memtest_clock;
+  mt.clock_freq = OSAL_ST_FREQUENCY;
+
+  /* Clean run.*/
+  memtest_fault_call = 0;
+  memtest_run(&mt, MEMTEST_RUN_ALL);
+  CHECK(memtest_errors == 0);
+
+  for (int t = 0; t < MEMTEST_TYPES_NUM; t++) {
+    for (int w = 0; w < MEMTEST_WIDTHS_NUM; w++) {
+      char name[32];
+      std::snprintf(name, sizeof(name), "%s_%d", types[t], 8 << w);
+      test_report("memtest", name, "write",
+                  mt.stat[t][w].write_speed / 1e6, "MB/s");
+      test_report("memtest", name, "read",
+                  mt.stat[t][w].read_speed / 1e6, "MB/s");
+    }
+  }
+
+  /* Bit flip injected after the first fill must be found at its index.*/
+  memtest_clock_calls = 0;
+  memtest_fault_call  = 2;
+  memtest_fault_addr  = (uint8_t *)mem.data() + 12345;
+  mt.width_mask = MEMTEST_WIDTH_8;
+  memtest_run(&mt, MEMTEST_WALKING_ONE);
+  CHECK(memtest_errors == 1);
+  CHECK(memtest_err_index == 12345);
+
+  /* Fault seen by a single read only, values of that read are reported.*/
+  memtest_errors = 0;
+  memtest_fault_call = 0;
+  memtest_transient_addr = (uint8_t *)mem.data() + 23456;
+  memtest_run(&mt, MEMTEST_WALKING_ONE);
+  CHECK(memtest_transient_addr == nullptr);
+  CHECK(memtest_errors == 1);
+  CHECK(memtest_err_index == 23456);
+  CHECK((memtest_err_got ^ memtest_err_expect) == 0x10);
+}
+
+/*
+ * Incremental March C- test
+ */
+
+static void marchtest_suite(void) {
+  const size_t words = 64 * 1024;
+  const size_t window = 64;
+  std::vector<uint32_t> mem(words), shadow(words), save(window);
+  marchtest_t mt;
+  double worst = 0;
+  size_t steps = 0;
+
+  for (size_t i = 0; i < words; i++)
+    mem[i] = shadow[i] = rnd(0xFFFFFFFF);
+
+  marchtestObjectInit(&mt, mem.data(), words * sizeof(uint32_t),
+                      save.data(), window, NULL);
+
+  auto start = clk::now();
+  while (mt.passes == 0) {
+    size_t before = marchtestGetCoverage(&mt);
+    auto t = clk::now();
+
+    CHECK(marchtestStep(&mt));
+    double d = seconds_since(t);
+    worst = d > worst ? d : worst;
+    CHECK((marchtestGetCoverage(&mt) > before) || (mt.passes == 1));
+    steps++;
+  }
+  double total = seconds_since(start);
+
+  CHECK(steps == words / window);
+  CHECK(mt.faults == 0);
+  CHECK(mem == shadow);
+  test_report("marchtest", "step_64w", "latency_max", worst * 1e9, "ns");
+  test_report("marchtest", "pass_256k", "throughput",
+              words * sizeof(uint32_t) / total / 1e6, "MB/s");
+}
+
+/* Word reading with a stuck-at-1 bit, NULL when no fault is injected.*/
+static volatile uint32_t *march_stuck_addr = NULL;
+static const uint32_t march_stuck_mask = 0x00000100;
+
+extern "C" uint32_t marchtest_host_read(volatile uint32_t *p) {
+  uint32_t v = *p;
+
+  if (p == march_stuck_addr)
+    v |= march_stuck_mask;
+  return v;
+}
+
+struct march_fault_t {
+  unsigned calls;
+  marchtest_t *mtp;
+  volatile uint32_t *addr;
+  uint32_t got;
+  uint32_t expect;
+};
+
+static march_fault_t march_fault;
+
+static void march_errcb(marchtest_t *mtp, volatile uint32_t *addr,
+                        uint32_t got, uint32_t expect) {
+  march_fault.calls++;
+  march_fault.mtp = mtp;
+  march_fault.addr = addr;
+  march_fault.got = got;
+  march_fault.expect = expect;
+}
+
+/*
+ * Stuck-at-1 bit in the third window: only that step fails, the callback
+ * gets the faulty word and the first background, the content survives.
+ */
+static void marchtest_fault_suite(void) {
+  const size_t words = 256, window = 64, faulty = 2 * window + 17;
+  std::vector<uint32_t> mem(words), shadow(words), save(window);
+  marchtest_t mt;
+
+  for (size_t i = 0; i < words; i++)
+    mem[i] = shadow[i] = rnd(0xFFFFFFFF);
+  /* The stuck bit is already set, so only the test can see it.*/
+  mem[faulty] |= march_stuck_mask;
+  shadow[faulty] = mem[faulty];
+
+  marchtestObjectInit(&mt, mem.data(), words * sizeof(uint32_t),
+                      save.data(), window, march_errcb);
+  march_fault = march_fault_t();
+  march_stuck_addr = &mem[faulty];
+
+  for (size_t step = 0; step < words / window; step++) {
+    bool ok = marchtestStep(&mt);
+
+    CHECK(ok == (step != faulty / window));
+    CHECK(march_fault.calls == ((step < faulty / window) ? 0U : 1U));
+  }
+  march_stuck_addr = NULL;
+
+  CHECK(mt.passes == 1);
+  CHECK(mt.faults == 1);
+  CHECK(march_fault.mtp == &mt);
+  CHECK(march_fault.addr == &mem[faulty]);
+  CHECK(march_fault.got == march_stuck_mask);
+  CHECK(march_fault.expect == 0x00000000);
+  CHECK(mem == shadow);
+
+  /* Without the fault the next step passes.*/
+  CHECK(marchtestStep(&mt));
+  CHECK(mt.faults == 1);
+}
+
+/*
+ * Closed loop against first order plants: the Q15 and Q31 banks must track
+ * the float bank, integrators must stay within the output limits.
+ */
+static void pidbank_suite(void) {
+  const size_t n = 64;
+  const unsigned steps = 2000;
+  const uint8_t shift15 = 2, shift31 = 2;
+
+  std::vector<float> fkp(n), fki(n), fkd(n), falpha(n), fmin(n), fmax(n);
+  std::vector<float> fsp(n), fin(n), fout(n), fsum(n), flast(n), fdf(n);
+  std::vector<int16_t> kp15(n), ki15(n), kd15(n), alpha15(n), min15(n), max15(n);
+  std::vector<int16_t> sp15(n), in15(n), out15(n), last15(n);
+  std::vector<int32_t> sum15(n), df15(n);
+  std::vector<int32_t> kp31(n), ki31(n), kd31(n), alpha31(n), min31(n), max31(n);
+  std::vector<int32_t> sp31(n), in31(n), out31(n), sum31(n), last31(n), df31(n);
+  std::vector<float> y15(n), y31(n), plant(n);
+
+  for (size_t i = 0; i < n; i++) {
+    float kp, ki, kd;
+    pidbank_gains(0.2f + 0.02f * (i % 16), 2.0f + 0.1f * (i % 8),
+                  0.002f * (i % 4), 0.01f, &kp, &ki, &kd);
+    fkp[i] = kp; fki[i] = ki; fkd[i] = kd;
+    falpha[i] = 0.25f;
+    fmin[i] = -0.9f; fmax[i] = 0.9f;
+    /* The last quarter of the loops asks for an unreachable set point. */
+    fsp[i] = (i < 3 * n / 4) ? 0.5f * ((float)rnd(2001) / 1000.0f - 1.0f) : 0.99f;
+    plant[i] = 0.02f + 0.005f * (i % 5);
+
+    kp15[i] = (int16_t)(kp / (1 << shift15) * 32768.0f);
+    ki15[i] = (int16_t)(ki / (1 << shift15) * 32768.0f);
+    kd15[i] = (int16_t)(kd / (1 << shift15) * 32768.0f);
+    alpha15[i] = (int16_t)(0.25f * 32768.0f);
+    min15[i] = (int16_t)(fmin[i] * 32768.0f);
+    max15[i] = (int16_t)(fmax[i] * 32768.0f);
+    sp15[i] = (int16_t)(fsp[i] * 32767.0f);
+
+    kp31[i] = (int32_t)(kp / (1 << shift31) * 2147483648.0);
+    ki31[i] = (int32_t)(ki / (1 << shift31) * 2147483648.0);
+    kd31[i] = (int32_t)(kd / (1 << shift31) * 2147483648.0);
+    alpha31[i] = (int32_t)(0.25 * 2147483648.0);
+    min31[i] = (int32_t)(fmin[i] * 2147483648.0);
+    max31[i] = (int32_t)(fmax[i] * 2147483648.0);
+    sp31[i] = (int32_t)(fsp[i] * 2147483647.0);
+  }
+
+  pidbank_f32_t bf = {n, fkp.data(), fki.data(), fkd.data(), falpha.data(),
+                      fmin.data(), fmax.data(), fsp.data(), fin.data(),
+                      fout.data(), fsum.data(), flast.data(), fdf.data()};
+  pidbank_q15_t b15 = {n, shift15, kp15.data(), ki15.data(), kd15.data(),
+                       alpha15.data(), min15.data(), max15.data(), sp15.data(),
+                       in15.data(), out15.data(), sum15.data(), last15.data(),
+                       df15.data()};
+  pidbank_q31_t b31 = {n, shift31, kp31.data(), ki31.data(), kd31.data(),
+                       alpha31.data(), min31.data(), max31.data(), sp31.data(),
+                       in31.data(), out31.data(), sum31.data(), last31.data(),
+                       df31.data()};
+
+  pidbank_f32_initialize(&bf);
+  CHECK(pidbank_q15_initialize(&b15));
+  CHECK(pidbank_q31_initialize(&b31));
+
+  float err15 = 0, err31 = 0;
+  bool windup = false;
+  for (unsigned s = 0; s < steps; s++) {
+    pidbank_f32_compute(&bf);
+    pidbank_q15_compute(&b15);
+    pidbank_q31_compute(&b31);
+    for (size_t i = 0; i < n; i++) {
+      float u15 = out15[i] / 32768.0f, u31 = out31[i] / 2147483648.0f;
+      err15 = std::max(err15, std::fabs(u15 - fout[i]));
+      err31 = std::max(err31, std::fabs(u31 - fout[i]));
+      windup |= (fsum[i] > fmax[i]) || (fsum[i] < fmin[i]) ||
+                (sum15[i] > max15[i]) || (sum15[i] < min15[i]) ||
+                (sum31[i] > max31[i]) || (sum31[i] < min31[i]);
+      /* Each bank drives its own copy of the plant. */
+      fin[i] += (fout[i] - fin[i]) * plant[i];
+      y15[i] += (u15 - y15[i]) * plant[i];
+      y31[i] += (u31 - y31[i]) * plant[i];
+      in15[i] = (int16_t)(y15[i] * 32767.0f);
+      in31[i] = (int32_t)(y31[i] * 2147483647.0);
+    }
+  }
+
+  CHECK(!windup);
+  CHECK(err15 < 0.02f);
+  CHECK(err31 < 0.001f);
+  for (size_t i = 0; i < 3 * n / 4; i++)
+    CHECK(std::fabs(fin[i] - fsp[i]) < 0.01f);
+  /* Saturated loops must recover as soon as the set point is reachable. */
+  for (size_t i = 3 * n / 4; i < n; i++) {
+    CHECK(fout[i] == fmax[i]);
+    fsp[i] = 0.0f;
+  }
+  for (unsigned s = 0; s < 200; s++) {
+    pidbank_f32_compute(&bf);
+    for (size_t i = 0; i < n; i++)
+      fin[i] += (fout[i] - fin[i]) * plant[i];
+  }
+  for (size_t i = 3 * n / 4; i < n; i++)
+    CHECK(fin[i] < 0.5f);
+
+  /* Out of range shifts are refused, the state is left alone. */
+  std::vector<int16_t> keep15(out15);
+  std::vector<int32_t> keep31(out31);
+  b15.shift = PIDBANK_Q15_SHIFT_MAX + 1;
+  b31.shift = PIDBANK_Q31_SHIFT_MAX + 1;
+  CHECK(!pidbank_q15_initialize(&b15));
+  CHECK(!pidbank_q31_initialize(&b31));
+  CHECK(!pidbank_q15_compute(&b15));
+  CHECK(!pidbank_q31_compute(&b31));
+  CHECK((out15 == keep15) && (out31 == keep31));
+  b15.shift = shift15;
+  b31.shift = shift31;
+
+  test_report("pidbank", "q15_vs_f32", "max_error", err15, "fs");
+  test_report("pidbank", "q31_vs_f32", "max_error", err31, "fs");
+
+  const unsigned rounds = 20000;
+  auto t = clk::now();
+  for (unsigned r = 0; r < rounds; r++) {
+    fin[r % n] += 1e-6f;
+    pidbank_f32_compute(&bf);
+  }
+  test_report("pidbank", "f32", "rate", n * rounds / seconds_since(t) / 1e6,
+              "Mloops/s");
+  t = clk::now();
+  for (unsigned r = 0; r < rounds; r++) {
+    in15[r % n]++;
+    pidbank_q15_compute(&b15);
+  }
+  test_report("pidbank", "q15", "rate", n * rounds / seconds_since(t) / 1e6,
+              "Mloops/s");
+  t = clk::now();
+  for (unsigned r = 0; r < rounds; r++) {
+    in31[r % n]++;
+    pidbank_q31_compute(&b31);
+  }
+  test_report("pidbank", "q31", "rate", n * rounds / seconds_since(t) / 1e6,
+              "Mloops/s");
+}
+
+/*
+ ******************************************************************************
+ * EXPORTED FUNCTIONS
+ ******************************************************************************
+ */
+
+int main(void) {
+  static char extra[32];
+
+  std::snprintf(extra, sizeof(extra), ",\"crc_slices\":%d", CRCSW_SLICES);
+  test_report_extra = extra;
+
+  crcInit();
+
+  crc_suite();
+  bitmap_suite();
+  blkalloc_suite("alloc", 64, 0);
+  blkalloc_suite("alloc_odd_size", 24, 8);
+  tribuf_suite();
+  ramdisk_suite();
+  memtest_suite();
+  marchtest_suite();
+  marchtest_fault_suite();
+  pidbank_suite();
+
+  return test_summary();
+}
@@ -135,6 +135,17 @@
  */
 #define ONEWIRE_USE_SEARCH_ROM      TRUE
 
+/**
+ * @brief   Generates time slots by UART with DMA instead of PWM.
+ * @note    UART TX and RX must be joined to the bus.
+ */
+#define ONEWIRE_USE_UART            FALSE
+
+/**
+ * @brief   Maximum number of simultaneously started 1-wire buses.
+ */
+#define ONEWIRE_MAX_BUSES           1
+
 /*===========================================================================*/
 /* QEI driver related settings.                                              */
 /*===========================================================================*/
@@ -0,0 +1,113 @@
+#!/usr/bin/python3
+# -*- coding: utf-8 -*-
+
+#    Copyright (C) 2026 agent
+#
+#    Licensed under the Apache License, Version 2.0 (the "License");
+#    you may not use this file except in compliance with the License.
+#    You may obtain a copy of the License at
+#
+#        http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS,
+#    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#    See the License for the specific language governing permissions and
+#    limitations under the License.
+
+"""
+Generates lookup table and CRCConfig for the software CRC driver
+(os/various/crcsw.c, CRCSW_PROGRAMMABLE) so any polynomial gets table
+driven calculation.
+
+Example, CRC-32C:
+    crcsw_table.py -n crc32c -w 32 -p 0x1EDC6F41 -i 0xFFFFFFFF \
+                   -x 0xFFFFFFFF -r > crc32c_table.c
+"""
+
+from argparse import ArgumentParser
+
+
+def reflect(value, width):
+    result = 0
+    for _ in range(width):
+        result = (result << 1) | (value & 1)
+        value >>= 1
+    return result
+
+
+def make_table(width, poly, reflected):
+    mask = (1 << width) - 1
+    table = []
+
+    if reflected:
+        rpoly = reflect(poly, width)
+        for i in range(256):
+            crc = i
+            for _ in range(8):
+                crc = (crc >> 1) ^ rpoly if crc & 1 else crc >> 1
+            table.append(crc)
+    else:
+        if width < 8:
+            raise ValueError('non reflected table requires width >= 8')
+        top = 1 << (width - 1)
+        for i in range(256):
+            crc = i << (width - 8)
+            for _ in range(8):
+                crc = (crc << 1) ^ poly if crc & top else crc << 1
+            table.append(crc & mask)
+
+    return table
+
+
+def emit(name, width, poly, init, xorout, reflected, table):
+    digits = (width + 3) // 4
+    per_line = 8 if digits <= 4 else 4
+    out = []
+
+    out.append('/* Generated by tools/crcsw_table.py, do not edit. */\n')
+    out.append('#include "hal.h"\n')
+    out.append('static const uint32_t {}_table[256] = {{'.format(name))
+    for i in range(0, 256, per_line):
+        chunk = ', '.join('0x{:0{}X}'.format(v, digits)
+                          for v in table[i:i + per_line])
+        sep = ',' if i + per_line < 256 else ''
+        out.append('  {}{}'.format(chunk, sep))
+    out.append('};\n')
+    out.append('const CRCConfig {}_config = {{'.format(name))
+    out.append('  .poly_size         = {},'.format(width))
+    out.append('  .poly              = 0x{:X},'.format(poly))
+    out.append('  .initial_val       = 0x{:X},'.format(init))
+    out.append('  .final_val         = 0x{:X},'.format(xorout))
+    out.append('  .reflect_data      = {},'.format(int(reflected)))
+    out.append('  .reflect_remainder = {},'.format(int(reflected)))
+    out.append('  .table             = {}_table'.format(name))
+    out.append('};')
+
+    return '\n'.join(out) + '\n'
+
+
+if __name__ == '__main__':
+
+    parser = ArgumentParser(description='Generate crcsw lookup table')
+    parser.add_argument('-n', '--name', required=True, type=str,
+                        help='C identifier prefix')
+    parser.add_argument('-w', '--width', required=True, type=int,
+                        help='polynomial size in bits (1..32)')
+    parser.add_argument('-p', '--poly', required=True,
+                        type=lambda v: int(v, 0), help='polynomial')
+    parser.add_argument('-i', '--init', default=0,
+                        type=lambda v: int(v, 0), help='initial value')
+    parser.add_argument('-x', '--xorout', default=0,
+                        type=lambda v: int(v, 0), help='final XOR value')
+    parser.add_argument('-r', '--reflect', action='store_true',
+                        help='reflected input and output')
+
+    args = parser.parse_args()
+
+    if not 1 <= args.width <= 32:
+        parser.error('width must be in range 1..32')
+
+    table = make_table(args.width, args.poly, args.reflect)
+    print(emit(args.name, args.width, args.poly, args.init, args.xorout,
+               args.reflect, table), end='')
@@ -135,6 +135,17 @@
  */
 #define ONEWIRE_USE_SEARCH_ROM      TRUE
 
+/**
+ * @brief   Generates time slots by UART with DMA instead of PWM.
+ * @note    UART TX and RX must be joined to the bus.
+ */
+#define ONEWIRE_USE_UART            FALSE
+
+/**
+ * @brief   Maximum number of simultaneously started 1-wire buses.
+ */
+#define ONEWIRE_MAX_BUSES           1
+
 /*===========================================================================*/
 /* QEI driver related settings.                                              */
 /*===========================================================================*/
@@ -162,6 +173,13 @@
  * @note    Disabling this option saves both code and data space.
  */
 #define EEPROM_USE_EE24XX FALSE
+
+/**
+ * @brief   Routes 24xx transactions through the I2C transaction queue.
+ * @note    Requires os/various/i2cq.c, configurations with a queue client
+ *          do not lock the bus themselves.
+ */
+#define EE24XX_USE_I2CQ FALSE
  /**
  * @brief   Enables 25xx series SPI eeprom device driver.
  * @note    Disabling this option saves both code and data space.